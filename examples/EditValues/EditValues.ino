@@ -31,36 +31,40 @@ struct GLOBAL_STRUCT {
 } values;
 
 
-#define CALIBRATION_FILE "/TouchCalData3"
-
-
 const bool invertColors = false;
 
-#define REPEAT_CAL true
+// Set to true to calibrate the touch screen again
+#define REPEAT_CAL false
 
 TFT_eSPI tft = TFT_eSPI();
 
 
 DisplayMenu menu = DisplayMenu(&tft);
 
-void touch_calibrate();
 void setupMenu();
 
 #include "menusetup.h"
 
 unsigned long updateTempTimer = 0;
+unsigned long updateValvesTimer = 0;
 
 void setup()
 {
   Serial.begin(115200);
 
-  if (tft.width() >= 480)
-    tft.setRotation(0);  
-  touch_calibrate();
-  
+  if (REPEAT_CAL)
+    menu.getTouchCalibration()->clear();
+
+  // Large displays are used in portrait, the display is not initialized yet so height is the portrait height
+  menu.begin(tft.height() >= 480 ? 0 : 1);
   menu.invertColors(invertColors);
+  menu.enableTextCache(8 * 1024); // keypad texts are drawn from 1 bit sprites after the first draw
   setupMenu();
   menu.showPage(1);
+
+  const DISPLAY_MENU_BOOT_TIMES &times = menu.getBootTimes();
+  Serial.printf("Display init %u us, touch calibration %u us, first frame %u us, total %u us\n",
+                times.displayInit, times.touchCalibration, times.firstFrame, times.total);
   updateTempTimer = millis() + 10;
 }
 
@@ -73,78 +77,11 @@ void loop()
     updateTempTimer = millis() + 10;
       pTempShowButton->draw(); //drawn only when pageValve is visable
   }
-}
 
-void touch_calibrate()
-{
-  uint16_t calData[5];
-  uint8_t calDataOK = 0;
-
-  // check file system exists
-  if (!SPIFFS.begin())
-  {
-    Serial.println("Formating file system");
-    SPIFFS.format();
-    SPIFFS.begin();
-  }
-
-  // check if calibration file exists and size is correct
-  if (SPIFFS.exists(CALIBRATION_FILE))
-  {
-    if (REPEAT_CAL)
-    {
-      // Delete if we want to re-calibrate
-      SPIFFS.remove(CALIBRATION_FILE);
-    }
-    else
-    {
-      File f = SPIFFS.open(CALIBRATION_FILE, "r");
-      if (f)
-      {
-        if (f.readBytes((char *)calData, 14) == 14)
-          calDataOK = 1;
-        f.close();
-      }
-    }
-  }
-
-  if (calDataOK && !REPEAT_CAL)
-  {
-    // calibration data valid
-    tft.setTouch(calData);
-  }
-  else
-  {
-    tft.invertDisplay(false);
-    // data not valid so recalibrate
-    tft.fillScreen(TFT_BLACK);
-    tft.setCursor(20, 0);
-    tft.setTextFont(2);
-    tft.setTextSize(1);
-    tft.setTextColor(TFT_WHITE, TFT_BLACK);
-
-    tft.println("Touch corners as indicated");
-
-    tft.setTextFont(1);
-    tft.println();
-
-    if (REPEAT_CAL)
-    {
-      tft.setTextColor(TFT_RED, TFT_BLACK);
-      tft.println("Set REPEAT_CAL to false to stop this running again!");
-    }
-
-    tft.calibrateTouch(calData, TFT_MAGENTA, TFT_BLACK, 15);
-
-    tft.setTextColor(TFT_GREEN, TFT_BLACK);
-    tft.println("Calibration complete!");
-
-    // store data
-    File f = SPIFFS.open(CALIBRATION_FILE, "w");
-    if (f)
-    {
-      f.write((const unsigned char *)calData, 14);
-      f.close();
-    }
+  if (millis() > updateValvesTimer) {
+    // the valve flows may be changed by a controller, the bars only draw the pixels which changed
+    pColdValveBar->drawChanges();
+    pHotValveBar->drawChanges();
+    updateValvesTimer = millis() + 50;
   }
 }
@@ -18,57 +18,8 @@ double globalValueLong = 123;
 double globalTemperature = 22.97;
 DisplayButton *pTempShowButton = NULL;
 
-bool allowDouble,
-    allowMinus;
-
-//want full precision but no ending zeros and no ending dot
-String removeUnNecessaryDoubleEnding(String str)
-{
-
-    if (str.indexOf('.') > -1)
-    {
-        int len = str.length();
-        while (len > 1 && (str.charAt(len - 1) == '0'))
-        {
-            str.remove(len - 1, 1);
-            len = str.length();
-        }
-    }
-
-    if (str.endsWith("."))
-        str.remove(str.length() - 1, 1);
-
-    return str;
-}
-
-String toString(double num)
-{
-    char output[50];
-
-    snprintf(output, 50, "%.9f", num);
-    return removeUnNecessaryDoubleEnding(output);
-}
-
-/**
- * @brief checks if a string can be converted to and from a double number, resulting in the exactly the same string
- * 
- * @param str a string to be tested and remove un necessary endings like 0 and .
- * @return String if success a string which can be converted to double and if fail an empty string:
- */
-String convertToDoubleAndBackToSameString(String str)
-{
-    double d = str.toDouble();
-    int dotPos = str.indexOf('.');
-    int fractionLength = dotPos < 0 ? 0 : str.length() - (dotPos + 1);
-    String diffString = String(d, fractionLength);
-
-    diffString = removeUnNecessaryDoubleEnding(diffString);
-
-    if (diffString.equals(removeUnNecessaryDoubleEnding(str)))
-        return diffString;
-    else
-        return "";
-}
+DisplayNumericEntry *pValueEntry = NULL;
+DisplayPage *pEditReturnPage = NULL;
 
 void onShowEditValuePage(DisplayPage *pPage)
 {
@@ -77,21 +28,18 @@ void onShowEditValuePage(DisplayPage *pPage)
     //Hide or show dot button
     btn = pPage->getButtonByText(".");
 
-    btn->setState(allowDouble ? VISABLE : HIDDEN);
+    btn->setState(pValueEntry->getAllowDecimal() ? VISABLE : HIDDEN);
 
     //Hide or show minus button
     btn = pPage->getButtonByText("-");
-    btn->setState(allowMinus ? VISABLE : HIDDEN);
-    DisplayButton *btnValue = pPage->getLastButton();
+    btn->setState(pValueEntry->getAllowMinus() ? VISABLE : HIDDEN);
 
-    btnValue->setText(toString(*btnValue->getLinkedValue()));
+    pValueEntry->load();
 }
 
 void onDrawEditValuePage(DisplayPage *pPage)
 {
-    DisplayButton *btnValue = pPage->getLastButton();
-    pPage->getDisplay()->drawString(btnValue->getLinkedValueName(), 12, 44);
-    btnValue->draw();
+    pPage->getDisplay()->drawString(pValueEntry->getLinkedValueName(), 12, 44);
 }
 
 void pageEditKeyPressed(DisplayButton *btn)
@@ -105,98 +53,22 @@ void pageEditKeyPressed(DisplayButton *btn)
     else
         return; //bad text on button
 
-    DisplayButton *valueButton = btn->getPage()->getLastButton();
-    String currentValue = valueButton->getText();
-    String newStr = "";
-    int currentLength = currentValue.length();
     switch (firstChar)
     {
 
     case 'O': //OK
-        if (valueButton->getLinkedValue())
-        {
-            newStr = convertToDoubleAndBackToSameString(currentValue);
-            double newVal = newStr.toDouble();
-            *(valueButton->getLinkedValue()) = newVal;
-        }
-
-        pPage->getMenu()->showPage(valueButton->getPageToOpen());
+        pValueEntry->commit();
+        pPage->getMenu()->showPage(pEditReturnPage);
         return;
-        break;
 
     case 'C': //Cancel
-        pPage->getMenu()->showPage(valueButton->getPageToOpen());
+        pPage->getMenu()->showPage(pEditReturnPage);
         return;
-        break;
-
-    case 'R': //Reset
-        valueButton->setText("0");
-        break;
-
-    case '-':
-        if (currentValue.startsWith("-"))
-        {
-            currentValue.remove(0, 1);
-        }
-        else
-        {
-            // no negative sign at beginning
-            if (currentLength > 0 && currentValue != "0")
-            {
-                currentValue = String('-') + currentValue;
-            }
-        }
-        valueButton->setText(currentValue);
-        break;
-
-    case '0':
-    case '1':
-    case '2':
-    case '3':
-    case '4':
-    case '5':
-    case '6':
-    case '7':
-    case '8':
-    case '9':
-        if (currentValue == "0")
-        {
-            valueButton->setText(String(firstChar));
-        }
-        else
-        {
-            newStr = convertToDoubleAndBackToSameString(currentValue + firstChar);
-
-            if (newStr.length() > 0)
-                valueButton->setText(currentValue + firstChar);
-        }
-        break;
-
-    case '.':
-        if (currentValue.indexOf('.') < 0)
-        {
-            if (currentLength < 0)
-                currentValue = '0';
-
-            valueButton->setText(currentValue + firstChar);
-        }
-        break;
-
-    case 'D': //delete
-
-        if (currentLength > 1)
-        {
-            currentValue.remove(currentLength - 1, 1);
-            valueButton->setText(currentValue);
-        }
-        else
-        {
-            valueButton->setText("0");
-        }
-        break;
     }
 
-    onDrawEditValuePage(pPage);
+    //digits, dot, minus, Delete and Reset are validated by the entry, only changed characters are drawn
+    if (pValueEntry->pressKey(firstChar))
+        pValueEntry->drawChanges();
 }
 
 void addPageEditValue(DisplayMenu *pMenu)
@@ -254,10 +126,9 @@ void addPageEditValue(DisplayMenu *pMenu)
     }
 
     //the input display at top of the screen
-    DisplayButton *btn = pPage->addFunctionButton(10, 1, 300, buttonHeight, TFT_BUTTON_OUTLINE, pPage->getDisplay()->color565(25, 25, 25), TFT_BUTTON_TEXT, 1, "0", NULL);
-
-    btn->setPageToOpen(pPage->getMenu()->getPage(0));
-    btn->setTextAlign(ALIGN_RIGHT, 20, 3);
+    pValueEntry = pPage->addNumericEntry(10, 1, 300, buttonHeight, TFT_BUTTON_OUTLINE, pPage->getDisplay()->color565(25, 25, 25), TFT_BUTTON_TEXT, 1);
+    pValueEntry->setTextAlign(ALIGN_LEFT, 20, 3);
+    pEditReturnPage = pPage->getMenu()->getPage(0);
     pPage->registerOnDrawEvent(onDrawEditValuePage);
     pPage->registerOnShowEvent(onShowEditValuePage);
 }
@@ -21,68 +21,42 @@ const uint16_t TFT_BUTTON_OUTLINE = tft.color565(115, 149, 125);
 const uint16_t TFT_BUTTON_FILL = tft.color565(48, 73, 47);
 const uint16_t TFT_BUTTON_TEXT = TFT_GOLD;
 
+DisplayBar *pColdValveBar = NULL;
+DisplayBar *pHotValveBar = NULL;
+
 void addPageMenu()
 {
     menu.addPage();
 }
 
-void showPageEditTemperature(DisplayButton *menuButton)
-{
-
-    //about to open edit temperature page
-    DisplayMenu *pMenu = menuButton->getPage()->getMenu();
-    DisplayPage *pEditPage = pMenu->getPage(2);
-
-    DisplayButton *valueButton = pEditPage->getLastButton();
-    valueButton->setPageToOpen(pMenu->getPage(0));
-    valueButton->setLinkToValue(&globalTemperature, "Temperature");
-    allowDouble = true;
-    allowMinus = true;
-    pMenu->showPage(2);
-}
-
-void showPageEditGlobalDouble(DisplayButton *menuButton)
-{
-
-    DisplayMenu *pMenu = menuButton->getPage()->getMenu();
-    DisplayPage *pEditPage = pMenu->getPage(2);
-
-    DisplayButton *valueButton = pEditPage->getLastButton();
-    valueButton->setPageToOpen(pMenu->getPage(0));
-    valueButton->setLinkToValue(&globalValueDouble, "Global double");
+/**
+ * @brief A value which can be edited on the edit value page, a pointer to it is carried by the button which opens the page
+ * 
+ */
+struct EDIT_VALUE_TARGET {
+    double *pValue;
+    const char *name;
+    bool allowDecimal;
+};
 
-    allowDouble = true;
-    allowMinus = true;
-    pMenu->showPage(2);
-}
+EDIT_VALUE_TARGET editTemperature = {&globalTemperature, "Temperature", true};
+EDIT_VALUE_TARGET editGlobalDouble = {&globalValueDouble, "Global double", true};
+EDIT_VALUE_TARGET editGlobalLong = {&globalValueLong, "Global long", false};
 
-void showPageEditGlobalLong(DisplayButton *menuButton)
+void showPageEditValue(EDIT_VALUE_TARGET *pTarget, DisplayButton *menuButton)
 {
 
+    //about to open edit value page
     DisplayMenu *pMenu = menuButton->getPage()->getMenu();
-    DisplayPage *pEditPage = pMenu->getPage(2);
 
-    DisplayButton *valueButton = pEditPage->getLastButton();
-
-    valueButton->setPageToOpen(pMenu->getPage(0));
-    valueButton->setLinkToValue(&globalValueLong, "Global long");
-
-    allowDouble = false;
-    allowMinus = true;
+    pValueEntry->setLinkToValue(pTarget->pValue, pTarget->name);
+    pValueEntry->setAllowDecimal(pTarget->allowDecimal);
+    pValueEntry->setAllowMinus(true);
     pMenu->showPage(2);
 }
 
 void onDrawPageValves(DisplayPage *pPage)
 {
-
-    if (values.coldValveFlow < 0)
-        values.coldValveFlow = 0;
-    if (values.coldValveFlow > 100)
-        values.coldValveFlow = 100;
-    if (values.hotValveFlow < 0)
-        values.hotValveFlow = 0;
-    if (values.hotValveFlow > 100)
-        values.hotValveFlow = 100;
     tft.setFreeFont(&FreeSans12pt7b);
 
     int16_t screenXCenter = tft.width() / 2;
@@ -94,19 +68,9 @@ void onDrawPageValves(DisplayPage *pPage)
     tft.setTextColor(TFT_CYAN);
     tft.drawString("Cold", 36, 40);
 
-    int32_t h = 20, w = 100, x = 20, y = 70;
-    tft.drawRect(x, y, w, h, pPage->getFillColor());
-    tft.fillRect(x, y, w, h, pPage->getFillColor());
-    tft.drawString((String(values.coldValveFlow, 2)) + "%", x, y);
-
     tft.setTextColor(tft.color24to16(0xfb745b));
     tft.drawString("Hot", 36 + 208, 40);
 
-    x = 220, y = 70;
-    tft.drawRect(x, y, w, h, pPage->getFillColor());
-    tft.fillRect(x, y, w, h, pPage->getFillColor());
-    tft.drawString((String(values.hotValveFlow, 2)) + "%", x, y);
-
     tft.setTextColor(TFT_GOLD);
     tft.setTextDatum(C_BASELINE);
 
@@ -126,6 +90,16 @@ void addValve(DisplayPage *pPage, bool hotValve)
     const int x = hotValve ? 208 : 5;
     double *pPlowValue = hotValve ? &values.hotValveFlow : &values.coldValveFlow;
 
+    //the bar keeps the flow between 0 and 100 and repaints only the part of it which changed
+    DisplayBar *pBar = pPage->addBar(hotValve ? 165 : 10, 66, 150, 26, 80, TFT_BUTTON_OUTLINE, pPage->getFillColor(), hotValve ? tft.color24to16(0xfb745b) : TFT_CYAN, TFT_BUTTON_TEXT, 1);
+    pBar->setLinkToValue(pPlowValue, hotValve ? "Hot valve flow" : "Cold valve flow");
+    pBar->setRange(0, 100, true);
+    pBar->setUnit("%");
+    if (hotValve)
+        pHotValveBar = pBar;
+    else
+        pColdValveBar = pBar;
+
     int btnCount = -1;
     ++btnCount;
     pPage->addIncrementButton(buttonMarginX + ((btnCount % 2) * (buttonPaddingX + buttonWidth)) + x, buttonMarginY + (btnCount % 3) * (buttonHeight + buttonPaddingY), buttonWidth, buttonHeight, TFT_BUTTON_OUTLINE, TFT_BUTTON_FILL, TFT_BUTTON_TEXT, 1, "<", pPlowValue, -0.1);
@@ -141,11 +115,6 @@ void addValve(DisplayPage *pPage, bool hotValve)
     pPage->addIncrementButton(buttonMarginX + ((btnCount % 2) * (buttonPaddingX + buttonWidth)) + x, buttonMarginY + (btnCount % 3) * (buttonHeight + buttonPaddingY), buttonWidth, buttonHeight, TFT_BUTTON_OUTLINE, TFT_BUTTON_FILL, TFT_BUTTON_TEXT, 1, ">>>", pPlowValue, 10);
 }
 
-void onDrawTemperatureButton(DisplayButton *ptrButton)
-{
-
-    ptrButton->setText(toString(*ptrButton->getLinkedValue()));
-}
 void addPageValves()
 {
     DisplayPage *pPage = menu.addPage();
@@ -156,10 +125,10 @@ void addPageValves()
 
     //temperatue button used to show show the temperature and if pressed edit the temperature
     const int w = 100;
-    pTempShowButton = pPage->addFunctionButton(((tft.width() - w) / 2), 210, 100, 20, pPage->getFillColor(), pPage->getFillColor(), TFT_GOLD, 1, NULL, showPageEditTemperature);
+    pTempShowButton = pPage->addFunctionButton(((tft.width() - w) / 2), 210, 100, 20, pPage->getFillColor(), pPage->getFillColor(), TFT_GOLD, 1, NULL, DisplayButtonDelegate(showPageEditValue, &editTemperature));
     pTempShowButton->setLinkToValue(&globalTemperature, "value missing!");
     pTempShowButton->setTextAlign(ALIGN_CENTER, 0, 0);
-    pTempShowButton->registerOnDrawEvent(onDrawTemperatureButton);
+    pTempShowButton->setLinkedValueFormat(2); // drawn 100 times a second, formatted without heap allocations
 }
 
 void setupMenu()
@@ -184,12 +153,10 @@ void setupMenu()
 
     DisplayPage *pPage = menu.getPage(0);
     pPage->addPageButton(x, buttonMargin, buttonWidth, buttonHeight, TFT_BUTTON_OUTLINE, TFT_BUTTON_FILL, TFT_BUTTON_TEXT, 1, "Valves", menu.getPage(1));
-    pPage->addFunctionButton(x, buttonMargin + 1 * (buttonMargin + buttonHeight), buttonWidth, buttonHeight, TFT_BUTTON_OUTLINE, TFT_BUTTON_FILL, TFT_BUTTON_TEXT, 1, "Edit double", showPageEditGlobalDouble);
-    pPage->addFunctionButton(x, buttonMargin + 2 * (buttonMargin + buttonHeight), buttonWidth, buttonHeight, TFT_BUTTON_OUTLINE, TFT_BUTTON_FILL, TFT_BUTTON_TEXT, 1, "Edit long", showPageEditGlobalLong);
+    pPage->addFunctionButton(x, buttonMargin + 1 * (buttonMargin + buttonHeight), buttonWidth, buttonHeight, TFT_BUTTON_OUTLINE, TFT_BUTTON_FILL, TFT_BUTTON_TEXT, 1, "Edit double", DisplayButtonDelegate(showPageEditValue, &editGlobalDouble));
+    pPage->addFunctionButton(x, buttonMargin + 2 * (buttonMargin + buttonHeight), buttonWidth, buttonHeight, TFT_BUTTON_OUTLINE, TFT_BUTTON_FILL, TFT_BUTTON_TEXT, 1, "Edit long", DisplayButtonDelegate(showPageEditValue, &editGlobalLong));
 
     menu.showPage(1);//TODO: SET BACK TO SHOWPAGE 1
-    allowMinus = true;
-    allowDouble = false;
 }
 
 #endif
\ No newline at end of file
@@ -9,25 +9,28 @@
 
 #include <TFT_eSPI.h> // Hardware-specific library
 
-#define CALIBRATION_FILE "/TouchCalData3"
-
-#define REPEAT_CAL true
+// Set to true to calibrate the touch screen again
+#define REPEAT_CAL false
 
 TFT_eSPI tft = TFT_eSPI();
 
 
-void touch_calibrate();
-
 
 DisplayMenu menu = DisplayMenu(&tft);
 void setup()
 {
+  Serial.begin(115200);
+  if (REPEAT_CAL)
+    menu.getTouchCalibration()->clear();
+
+  // Starts the display, the touch calibration is read from the NVS and only run if it has not been stored
+  menu.begin();
+
   const uint16_t buttonWidth = 120;
   const uint16_t buttonHeight = 50;
   const uint16_t centerHorizontal = (tft.width() - buttonWidth)/2;
   const uint16_t centerVertical   = (tft.height() - buttonHeight)/2;
 
-  touch_calibrate();
   DisplayPage *pMainMenu, *pSecondMenu, *pThirdMenu;
   DisplayLabel *pLabel;
   pMainMenu   = menu.addPage();   //adding page at index 0
@@ -54,7 +57,18 @@ void setup()
   
   //add a open main menu button to third page
   pThirdMenu->addPageButton(centerHorizontal, centerVertical, buttonWidth, buttonHeight, TFT_WHITE, TFT_RED, TFT_GOLD, 1, "Main menu",  menu.getPage(0));
+  // Pages opened by the visable page are drawn while the menu is idle, two full screen pages need PSRAM
+  if (psramFound())
+    menu.enablePrerender(2 * tft.width() * tft.height() * 2);
+
   menu.showPage(0);
+
+  const DISPLAY_MENU_BOOT_TIMES &times = menu.getBootTimes();
+  Serial.printf("Display init %u us, touch calibration %u us, first frame %u us, total %u us\n",
+                times.displayInit, times.touchCalibration, times.firstFrame, times.total);
+
+  // How much heap the pages use, per page and in total
+  menu.printMemoryReport(Serial);
 }
 
 void loop()
@@ -62,76 +76,3 @@ void loop()
   menu.update();
 
 }
-
-void touch_calibrate()
-{
-  uint16_t calData[5];
-  uint8_t calDataOK = 0;
-
-  // check file system exists
-  if (!SPIFFS.begin())
-  {
-    Serial.println("Formating file system");
-    SPIFFS.format();
-    SPIFFS.begin();
-  }
-
-  // check if calibration file exists and size is correct
-  if (SPIFFS.exists(CALIBRATION_FILE))
-  {
-    if (REPEAT_CAL)
-    {
-      // Delete if we want to re-calibrate
-      SPIFFS.remove(CALIBRATION_FILE);
-    }
-    else
-    {
-      File f = SPIFFS.open(CALIBRATION_FILE, "r");
-      if (f)
-      {
-        if (f.readBytes((char *)calData, 14) == 14)
-          calDataOK = 1;
-        f.close();
-      }
-    }
-  }
-
-  if (calDataOK && !REPEAT_CAL)
-  {
-    // calibration data valid
-    tft.setTouch(calData);
-  }
-  else
-  {
-    // data not valid so recalibrate
-    tft.fillScreen(TFT_BLACK);
-    tft.setCursor(20, 0);
-    tft.setTextFont(2);
-    tft.setTextSize(1);
-    tft.setTextColor(TFT_WHITE, TFT_BLACK);
-
-    tft.println("Touch corners as indicated");
-
-    tft.setTextFont(1);
-    tft.println();
-
-    if (REPEAT_CAL)
-    {
-      tft.setTextColor(TFT_RED, TFT_BLACK);
-      tft.println("Set REPEAT_CAL to false to stop this running again!");
-    }
-
-    tft.calibrateTouch(calData, TFT_MAGENTA, TFT_BLACK, 15);
-
-    tft.setTextColor(TFT_GREEN, TFT_BLACK);
-    tft.println("Calibration complete!");
-
-    // store data
-    File f = SPIFFS.open(CALIBRATION_FILE, "w");
-    if (f)
-    {
-      f.write((const unsigned char *)calData, 14);
-      f.close();
-    }
-  }
-}
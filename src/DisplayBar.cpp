@@ -0,0 +1,192 @@
+#include "DisplayBar.h"
+#include "DisplayMenu.h"
+
+DisplayBar::DisplayBar(TFT_eSPI *tft,
+                       DisplayPage *page,
+                       int16_t x,
+                       int16_t y,
+                       uint16_t width,
+                       uint16_t height,
+                       uint16_t textWidth,
+                       uint16_t outlineColor,
+                       uint16_t fillColor,
+                       uint16_t barColor,
+                       uint16_t textColor,
+                       uint8_t textsize) : DisplayWidget(tft, page, x, y, width, height)
+{
+    _textWidth = min(textWidth, (uint16_t)(width > 2 ? width - 2 : 0));
+    _outlineColor = outlineColor;
+    _fillColor = fillColor;
+    _barColor = barColor;
+    _textColor = textColor;
+    _textsize = textsize;
+    _min = 0;
+    _max = 100;
+    _clampValue = false;
+    _precision = _textWidth > 0 ? 2 : -1;
+    _unit[0] = '\0';
+    _value = 0;
+    _pLinkedValue = NULL;
+    _drawnLevel = -1;
+    _drawnText[0] = '\0';
+}
+
+void DisplayBar::setRange(double min, double max, bool clampValue)
+{
+    _min = min;
+    _max = max;
+    _clampValue = clampValue;
+    draw();
+}
+
+void DisplayBar::setPrecision(int8_t precision)
+{
+    _precision = min(precision, (int8_t)DISPLAY_NUMBER_MAX_PRECISION);
+    draw();
+}
+
+void DisplayBar::setUnit(const char *unit)
+{
+    strncpy(_unit, unit ? unit : "", DISPLAY_BAR_UNIT_SIZE - 1);
+    _unit[DISPLAY_BAR_UNIT_SIZE - 1] = '\0';
+    draw();
+}
+
+void DisplayBar::setLinkToValue(double *pLinkedValue, String valueName)
+{
+    _pLinkedValue = pLinkedValue;
+    _linkedValueName = valueName;
+}
+
+void DisplayBar::setValue(double value)
+{
+    if (_pLinkedValue)
+        *_pLinkedValue = value;
+    else
+        _value = value;
+
+    drawChanges();
+}
+
+double DisplayBar::getValue()
+{
+    double *pValue = _pLinkedValue ? _pLinkedValue : &_value;
+    if (_clampValue && _max > _min)
+        *pValue = constrain(*pValue, _min, _max);
+
+    return *pValue;
+}
+
+DisplayRect DisplayBar::barRect()
+{
+    //the text is to the right of the bar, inside the outline
+    return DisplayRect(_rect.x + 1, _rect.y + 1, _rect.width - 2 - _textWidth, _rect.height - 2);
+}
+
+int16_t DisplayBar::levelLength()
+{
+    DisplayRect bar = barRect();
+    return bar.width >= bar.height ? bar.width : bar.height;
+}
+
+int16_t DisplayBar::valueToLevel(double value)
+{
+    if (_max <= _min || isnan(value))
+        return 0;
+
+    double fraction = (value - _min) / (_max - _min);
+    fraction = constrain(fraction, 0.0, 1.0);
+    return (int16_t)((fraction * levelLength()) + 0.5);
+}
+
+void DisplayBar::paintLevel(int16_t from, int16_t to, uint16_t color)
+{
+    if (from >= to)
+        return;
+
+    DisplayRect bar = barRect();
+    if (bar.width >= bar.height)
+        _tft->fillRect(bar.x + from, bar.y, to - from, bar.height, color);
+    else
+        _tft->fillRect(bar.x, bar.bottom() - to, bar.width, to - from, color);
+}
+
+void DisplayBar::formatText(char *text, size_t size, double value)
+{
+    text[0] = '\0';
+    if (_precision < 0)
+        return;
+
+    size_t length = DisplayNumberFormat::format(text, size, value, _precision, false);
+    strncat(text, _unit, size - length - 1);
+}
+
+void DisplayBar::drawText(const char *text)
+{
+    if (_textWidth == 0)
+        return;
+
+    uint16_t before_color = _tft->textcolor;
+    uint8_t  before_textSize = _tft->textsize;
+    uint8_t  before_textDatum = _tft->getTextDatum();
+    uint8_t  before_textPadding = _tft->getTextPadding();
+
+    selectFont();
+    _tft->setTextSize(_textsize);
+    _tft->setTextColor(_textColor);
+    _tft->setTextDatum(MR_DATUM);
+    _tft->setTextPadding(0);
+
+    int16_t left = _rect.right() - 1 - _textWidth;
+    _tft->fillRect(left, _rect.y + 1, _textWidth, _rect.height - 2, _fillColor);
+    _tft->drawString(text, _rect.right() - 4, _rect.y + (_rect.height / 2));
+    strncpy(_drawnText, text, DISPLAY_BAR_TEXT_SIZE);
+
+    _tft->setTextColor(before_color);
+    _tft->setTextSize(before_textSize);
+    _tft->setTextDatum(before_textDatum);
+    _tft->setTextPadding(before_textPadding);
+}
+
+void DisplayBar::draw()
+{
+    if (!isPageVisable())
+        return;
+
+    double value = getValue();
+    int16_t level = valueToLevel(value);
+
+    _tft->drawRect(_rect.x, _rect.y, _rect.width, _rect.height, _outlineColor);
+    paintLevel(0, level, _barColor);
+    paintLevel(level, levelLength(), _fillColor);
+    _drawnLevel = level;
+
+    char text[DISPLAY_BAR_TEXT_SIZE];
+    formatText(text, sizeof(text), value);
+    drawText(text);
+}
+
+void DisplayBar::drawChanges()
+{
+    if (_drawnLevel < 0)
+    {
+        draw();
+        return;
+    }
+
+    if (!isPageVisable() || _occluded)
+        return;
+
+    double value = getValue();
+    int16_t level = valueToLevel(value);
+    if (level > _drawnLevel)
+        paintLevel(_drawnLevel, level, _barColor);
+    else
+        paintLevel(level, _drawnLevel, _fillColor);
+    _drawnLevel = level;
+
+    char text[DISPLAY_BAR_TEXT_SIZE];
+    formatText(text, sizeof(text), value);
+    if (strcmp(text, _drawnText) != 0)
+        drawText(text);
+}
@@ -0,0 +1,129 @@
+#ifndef DISPLAYBAR_H
+#define DISPLAYBAR_H
+
+#include <Arduino.h>
+
+#include <TFT_eSPI.h>
+
+#include "DisplayWidget.h"
+#include "DisplayNumberFormat.h"
+
+/**
+ * @brief Size of the text buffer for the unit written after the value of a bar, including the terminating zero.
+ *
+ */
+#define DISPLAY_BAR_UNIT_SIZE 8
+
+/**
+ * @brief Size of the text buffer for the value of a bar, including the terminating zero.
+ *
+ */
+#define DISPLAY_BAR_TEXT_SIZE (DISPLAY_NUMBER_TEXT_SIZE + DISPLAY_BAR_UNIT_SIZE)
+
+/**
+ * @brief A bar which is filled according to a value between a minimum and a maximum,
+ * with the value written next to it.
+ *
+ * A bar which is wider than it is high fills from left to right, otherwise it fills from the bottom up.
+ * The bar remembers how much of it was filled when it was last drawn and when the value changes,
+ * only the pixels between the old and the new level are painted. The value text is only drawn when it changes.
+ *
+ * @code .cpp
+ * DisplayBar *pBar = pPage->addBar(20, 70, 100, 20, 80, TFT_DARKGREY, TFT_BLACK, TFT_CYAN, TFT_WHITE, 1);
+ * pBar->setLinkToValue(&valveFlow, "Valve flow");
+ * pBar->setRange(0, 100, true);
+ * pBar->setUnit("%");
+ *
+ * //in loop, after valveFlow has changed
+ * pBar->drawChanges();
+ * @endcode
+ */
+class DisplayBar : public DisplayWidget
+{
+private:
+    uint16_t _outlineColor;
+    uint16_t _fillColor;
+    uint16_t _barColor;
+    uint16_t _textColor;
+    uint8_t _textsize;
+    uint16_t _textWidth;
+    double _min;
+    double _max;
+    bool _clampValue;
+    int8_t _precision;
+    char _unit[DISPLAY_BAR_UNIT_SIZE];
+    double _value;
+    double *_pLinkedValue;
+    String _linkedValueName;
+
+    //pixels of the bar filled when it was last drawn, -1 if it has not been drawn
+    int16_t _drawnLevel;
+    char _drawnText[DISPLAY_BAR_TEXT_SIZE];
+
+    DisplayRect barRect();
+    int16_t levelLength();
+    int16_t valueToLevel(double value);
+    void paintLevel(int16_t from, int16_t to, uint16_t color);
+    void formatText(char *text, size_t size, double value);
+    void drawText(const char *text);
+
+public:
+    DisplayBar(TFT_eSPI *tft,
+               DisplayPage *page,
+               int16_t x,
+               int16_t y,
+               uint16_t width,
+               uint16_t height,
+               uint16_t textWidth,
+               uint16_t outlineColor,
+               uint16_t fillColor,
+               uint16_t barColor,
+               uint16_t textColor,
+               uint8_t textsize);
+
+    /**
+     * @brief Set the values of an empty and a full bar
+     *
+     * @param clampValue Should the value be kept inside the range, the linked value is changed when it is outside it
+     */
+    void setRange(double min, double max, bool clampValue = false);
+    double getMin() { return _min; };
+    double getMax() { return _max; };
+
+    /**
+     * @brief Set how many decimals are written, -1 writes no text
+     *
+     */
+    void setPrecision(int8_t precision);
+    int8_t getPrecision() { return _precision; };
+
+    /**
+     * @brief Set a text written after the value, like "%"
+     *
+     */
+    void setUnit(const char *unit);
+
+    void setLinkToValue(double *pLinkedValue, String valueName);
+    double *getLinkedValue() { return _pLinkedValue; };
+    String getLinkedValueName() { return _linkedValueName; };
+
+    /**
+     * @brief Sets the value, or the linked value if there is one, and draws the changes
+     *
+     */
+    void setValue(double value);
+    double getValue();
+
+    void draw();
+
+    /**
+     * @brief Draws only the part of the bar between the level last drawn and the level of the value,
+     * and the text if it changed. The whole bar is drawn if it has not been drawn before.
+     *
+     */
+    void drawChanges();
+    size_t getMemorySize() { return sizeof(DisplayBar) + _linkedValueName.length() + 1; }
+    const char *getTypeName() { return "DisplayBar"; }
+};
+
+#endif
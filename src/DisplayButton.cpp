@@ -14,11 +14,12 @@ DisplayButton::DisplayButton(   TFT_eSPI *tft,
                                 DisplayButtonType type,
                                 DisplayPage *page,
                                 DisplayPage *pPageToOpen,
-                                ButtonPressedFunction buttonPressed
+                                DisplayButtonDelegate buttonPressed
                                 )
 {
-
-    init(tft, x, y, width, height, outlineColor, fillColor, textColor, textsize, text, type, VISABLE, page, "",  NULL, 0, pPageToOpen, buttonPressed);
+    DisplayStyle *pStyle = DisplayStyle::get(outlineColor, fillColor, textColor, textsize, DISPLAY_STYLE_AUTO_RADIUS);
+    init(tft, x, y, width, height, pStyle, text, type, VISABLE, page, "",  NULL, 0, pPageToOpen, buttonPressed);
+    pStyle->release();
 }
 
 
@@ -38,20 +39,77 @@ DisplayButton::DisplayButton(   TFT_eSPI *tft,
                                 double incrementValue
                                 )
 {
-
-    init(tft, x, y, width, height, outlineColor, fillColor, textColor, textsize, text, type, VISABLE, page, "", pLinkedValue, incrementValue, NULL, NULL);
+    DisplayStyle *pStyle = DisplayStyle::get(outlineColor, fillColor, textColor, textsize, DISPLAY_STYLE_AUTO_RADIUS);
+    init(tft, x, y, width, height, pStyle, text, type, VISABLE, page, "", pLinkedValue, incrementValue, NULL, DisplayButtonDelegate());
+    pStyle->release();
 }
 
 // Copy constructor
 DisplayButton::DisplayButton(const DisplayButton &button)
 {
     init(button._values.tft           , button._values.x              , button._values.y,
-         button._values.width         , button._values.height         , button._values.outlineColor,
-         button._values.fillColor     , button._values.textColor      , button._values.textsize,
+         button._values.width         , button._values.height         , button._values.pStyle,
          button._values.text.c_str()  , button._values.type           , button._values.state,
          button._values.pPage         , button._values.linkedValueName, button._values.pLinkedValue, 
          button._values.incrementValue, button._values.pPageToOpen    , button._values.buttonPressedFunction,
          button._values.textAlign);
+    _values.linkedValuePrecision = button._values.linkedValuePrecision;
+    _values.linkedValueTrimZeros = button._values.linkedValueTrimZeros;
+    _values.pBinding = button._values.pBinding;
+    _values.incrementSteps = button._values.incrementSteps;
+}
+
+DisplayButton &DisplayButton::operator=(const DisplayButton &button)
+{
+    if (this == &button)
+        return *this;
+
+    button._values.pStyle->retain();
+    _values.pStyle->release();
+    _values = button._values;
+    _dTemp = button._dTemp;
+    _occluded = button._occluded;
+    _currentState = button._currentState;
+    _lastState = button._lastState;
+    return *this;
+}
+
+DisplayButton::~DisplayButton()
+{
+    _values.pStyle->release();
+}
+
+void DisplayButton::setStyle(DisplayStyle *pStyle)
+{
+    if (pStyle == NULL || pStyle == _values.pStyle)
+        return;
+
+    pStyle->retain();
+    _values.pStyle->release();
+    _values.pStyle = pStyle;
+}
+
+void DisplayButton::setColors(uint16_t outlineColor, uint16_t fillColor, uint16_t textColor)
+{
+    DisplayStyle *pStyle = DisplayStyle::get(outlineColor, fillColor, textColor, _values.pStyle->getTextSize(), _values.pStyle->getRadius(), _values.pStyle->getFont());
+    setStyle(pStyle);
+    pStyle->release();
+}
+
+void DisplayButton::setRadius(uint8_t radius)
+{
+    DisplayStyle *pStyle = _values.pStyle;
+    pStyle = DisplayStyle::get(pStyle->getOutlineColor(), pStyle->getFillColor(), pStyle->getTextColor(), pStyle->getTextSize(), radius, pStyle->getFont());
+    setStyle(pStyle);
+    pStyle->release();
+}
+
+void DisplayButton::setFont(DisplayFont *pFont)
+{
+    DisplayStyle *pStyle = _values.pStyle;
+    pStyle = DisplayStyle::get(pStyle->getOutlineColor(), pStyle->getFillColor(), pStyle->getTextColor(), pStyle->getTextSize(), pStyle->getRadius(), pFont);
+    setStyle(pStyle);
+    pStyle->release();
 }
 
 void DisplayButton::init(   TFT_eSPI *tft, 
@@ -59,10 +117,7 @@ void DisplayButton::init(   TFT_eSPI *tft,
                             int16_t y, 
                             uint16_t width,
                             uint16_t height,
-                            uint16_t outlineColor,
-                            uint16_t fillColor,
-                            uint16_t textColor,
-                            uint8_t textsize,
+                            DisplayStyle *pStyle,
                             const char *text, 
                             DisplayButtonType type,
                             DisplayState state,
@@ -71,7 +126,7 @@ void DisplayButton::init(   TFT_eSPI *tft,
                             double *pLinkedValue,
                             double incrementValue,
                             DisplayPage *pPageToOpen,
-                            ButtonPressedFunction buttonPressedFunction,
+                            DisplayButtonDelegate buttonPressedFunction,
                             TextAlign textAlign
                             )
 {
@@ -81,10 +136,8 @@ void DisplayButton::init(   TFT_eSPI *tft,
     _values.y = y;
     _values.width = width;
     _values.height = height;
-    _values.outlineColor = outlineColor;
-    _values.fillColor = fillColor;
-    _values.textColor = textColor;
-    _values.textsize = textsize;
+    _values.pStyle = pStyle;
+    pStyle->retain();
     _values.text = text;
     _values.type = type;
     _values.state = state;
@@ -92,15 +145,19 @@ void DisplayButton::init(   TFT_eSPI *tft,
     _values.linkedValueName = linkedValueName;
     _values.pLinkedValue = pLinkedValue;
     _values.incrementValue = incrementValue;
+    _values.pBinding = NULL;
+    _values.incrementSteps = 0;
     _values.pPageToOpen = pPageToOpen;
     _values.buttonPressedFunction = buttonPressedFunction;
 
     //defaults
-    _values.radius = min(width, height) / 6; // Corner radius
+    _occluded = false;
+    _values.linkedValuePrecision = -1;
+    _values.linkedValueTrimZeros = true;
     _values.textAlign = textAlign;
     _values.xDatumOffset = 0;
     _values.yDatumOffset = -4;
-    _values.onDrawDisplayButton = NULL;
+    _values.onDrawDisplayButton = DisplayButtonDelegate();
     _values.allowOnlyOneButtonPressedAtATime = type == OPEN_PAGE || type == RUN_FUNCTION? true: false;
 }
 
@@ -115,50 +172,54 @@ void DisplayButton::draw(bool inverted, bool cancelDrawIfPageIsNotVisable)
         return;
     }
 
+    DisplayMenu *pMenu = getPage() ? getPage()->getMenu() : NULL;
     if (cancelDrawIfPageIsNotVisable)
     {
-        DisplayPage *pPage = getPage();
-        if (pPage)
-        {
-            DisplayMenu *pMenu = pPage->getMenu();
-            if (pMenu && pPage != pMenu->getVisablePage())
-                return;
-        }
+        if (pMenu && (getPage() != pMenu->getVisablePage() || pMenu->isAsleep()))
+            return;
     }
 
     if (_values.onDrawDisplayButton)
+    {
         _values.onDrawDisplayButton(this);
+        //the draw function may have changed the font
+        if (pMenu)
+            pMenu->forgetFont();
+    }
 
+    DisplayStyle *pStyle = _values.pStyle;
     uint16_t fillColor, outlineColor, textColor;
     if (!inverted)
     {
-        fillColor = _values.fillColor;
-        outlineColor = _values.outlineColor;
-        textColor = _values.textColor;
+        fillColor = pStyle->getFillColor();
+        outlineColor = pStyle->getOutlineColor();
+        textColor = pStyle->getTextColor();
     }
     else
     {
-        fillColor = _values.textColor;
-        outlineColor = _values.outlineColor;
-        textColor = _values.fillColor;
+        fillColor = pStyle->getTextColor();
+        outlineColor = pStyle->getOutlineColor();
+        textColor = pStyle->getFillColor();
     }
+    uint8_t radius = getRadius();
 
     int32_t x, xText, y, yText;
     x = xText = _values.x;
     y = yText = _values.y;
     
-    //X calc
-    int16_t textWidth = _values.tft->textWidth(_values.text);
-    if (_values.textAlign == ALIGN_CENTER)
+    const char *pText = _values.text.c_str();
+    char valueText[DISPLAY_NUMBER_TEXT_SIZE];
+    bool drawLinkedValue = showsValue();
+    if (showsBinding())
     {
-        xText = _values.x + ((_values.width - textWidth) / 2) + _values.xDatumOffset;
-    } else if (_values.textAlign == ALIGN_RIGHT)
+        _values.pBinding->format(valueText, sizeof(valueText));
+        pText = valueText;
+    }
+    else if (drawLinkedValue)
     {
-        xText = x + (_values.width - textWidth) - _values.xDatumOffset;
-    } 
-
-    //Y calc
-    yText = _values.y + (_values.height / 2) + _values.yDatumOffset;
+        DisplayNumberFormat::format(valueText, sizeof(valueText), *_values.pLinkedValue, _values.linkedValuePrecision, _values.linkedValueTrimZeros);
+        pText = valueText;
+    }
 
     uint16_t before_color = _values.tft->textcolor;
     uint8_t  before_textSize = _values.tft->textsize;
@@ -166,15 +227,40 @@ void DisplayButton::draw(bool inverted, bool cancelDrawIfPageIsNotVisable)
     uint8_t  before_textPadding = _values.tft->getTextPadding();
 
     _values.tft->setTextColor(textColor);
-    _values.tft->setTextSize(_values.textsize);
+    _values.tft->setTextSize(pStyle->getTextSize());
     //Going to calculate everything from ML
     _values.tft->setTextDatum(ML_DATUM);
     _values.tft->setTextPadding(0);
+    if (pMenu)
+        pMenu->selectFont(_values.tft, pStyle->getFont(), pText);
+
+    //X calc, with the button's font and size
+    int16_t textWidth = _values.tft->textWidth(pText);
+    if (_values.textAlign == ALIGN_CENTER)
+    {
+        xText = _values.x + ((_values.width - textWidth) / 2) + _values.xDatumOffset;
+    } else if (_values.textAlign == ALIGN_RIGHT)
+    {
+        xText = x + (_values.width - textWidth) - _values.xDatumOffset;
+    } 
 
-    _values.tft->fillRoundRect(x, y, _values.width, _values.height, _values.radius, fillColor);
-    _values.tft->drawRoundRect(x, y, _values.width, _values.height, _values.radius, outlineColor);
+    //Y calc
+    yText = _values.y + (_values.height / 2) + _values.yDatumOffset;
 
-    _values.tft->drawString(_values.text, xText, yText);
+    _values.tft->fillRoundRect(x, y, _values.width, _values.height, radius, fillColor);
+    _values.tft->drawRoundRect(x, y, _values.width, _values.height, radius, outlineColor);
+
+    DisplayTextCache *pTextCache = pMenu ? pMenu->getTextCache() : NULL;
+    //the cache pushes it's sprites to the menu display, not to a page being drawn ahead of time
+    if (pTextCache && pTextCache->getDisplay() != _values.tft)
+        pTextCache = NULL;
+    //text drawn from cache must stay clear of the rounded corners and the outline
+    DisplayRect textBounds(x + max((uint8_t)1, radius), y + 1, _values.width - (2 * max((uint8_t)1, radius)), _values.height - 2);
+    //the cache renders GFX fonts only
+    const GFXfont *pGfxFont = pMenu ? pMenu->resolveFont(pStyle->getFont())->getGfxFont() : NULL;
+    //linked values change all the time, caching them would only push the static texts out
+    if (drawLinkedValue || !pTextCache || !pGfxFont || !pTextCache->drawString(pGfxFont, _values.text, xText, yText, textColor, fillColor, textBounds))
+        _values.tft->drawString(pText, xText, yText);
 
     _values.tft->setTextColor(before_color);
     _values.tft->setTextSize(before_textSize);
@@ -229,6 +315,20 @@ bool DisplayButton::executeCommand()
         break;
 
     case INCREMENT_VALUE:
+        if (_values.pBinding && _values.incrementSteps)
+        {
+            bool changed = _values.pBinding->step(_values.incrementSteps);
+
+            //the button is drawn released, a button still held is drawn pressed again on the next update
+            resetPressState();
+            if (!isOccluded() && (!changed || !showsBinding()))
+                draw();
+
+            //only the items showing the variable are drawn
+            if (changed && _values.pPage)
+                _values.pPage->drawBinding(_values.pBinding);
+            return true;
+        }
         if (_values.pLinkedValue && _values.incrementValue)
         {
 
@@ -248,6 +348,18 @@ void DisplayButton::setLinkToValue(double *pLinkedValue, String valueName) {
     _values.linkedValueName = valueName; 
 };
 
+void DisplayButton::setBinding(DisplayValue *pBinding, int16_t incrementSteps)
+{
+    _values.pBinding = pBinding;
+    _values.incrementSteps = incrementSteps;
+}
+
+void DisplayButton::setLinkedValueFormat(int8_t precision, bool trimZeros)
+{
+    _values.linkedValuePrecision = min(precision, (int8_t)DISPLAY_NUMBER_MAX_PRECISION);
+    _values.linkedValueTrimZeros = trimZeros;
+}
+
 void DisplayButton::setText(String newText, bool drawScreenNow)
 {
     _values.text = newText;
@@ -11,12 +11,24 @@
 #include <TFT_eSPI.h>
 
 #include "DisplayGlobals.h"
+#include "DisplayRect.h"
+#include "DisplayNumberFormat.h"
+#include "DisplayDelegate.h"
+#include "DisplayMemory.h"
+#include "DisplayStyle.h"
+#include "DisplayValue.h"
 
 class DisplayButton;
 
 typedef void (*ButtonPressedFunction) (DisplayButton *ptrButton);
 typedef void (*OnDrawDisplayButton) (DisplayButton *ptrButton);
 
+/**
+ * @brief A button event, a function taking the button, which can also carry a context pointer or call a member function.
+ * ButtonPressedFunction and OnDrawDisplayButton functions convert to it.
+ */
+typedef DisplayDelegate<DisplayButton *> DisplayButtonDelegate;
+
 /**
  * @brief DisplayButton type enumeration which holds information on how the button behaves when it is pressed.
  * 
@@ -37,12 +49,8 @@ struct DISPLAY_BUTTON_VALUES {
     int16_t yDatumOffset;
     uint16_t width;
     uint16_t height;
-    uint16_t outlineColor;
-    uint16_t fillColor;
-    uint16_t textColor;
-    uint8_t textsize;
+    DisplayStyle *pStyle;
     TextAlign textAlign;
-    uint8_t radius;
     String text;
     bool allowOnlyOneButtonPressedAtATime;
 
@@ -51,25 +59,27 @@ struct DISPLAY_BUTTON_VALUES {
     DisplayPage *pPage;
     double *pLinkedValue;
     String linkedValueName;
+    int8_t linkedValuePrecision;
+    bool linkedValueTrimZeros;
     double incrementValue;
+    DisplayValue *pBinding;
+    int16_t incrementSteps;
     DisplayPage *pPageToOpen;
-    ButtonPressedFunction buttonPressedFunction;
-    OnDrawDisplayButton onDrawDisplayButton;
+    DisplayButtonDelegate buttonPressedFunction;
+    DisplayButtonDelegate onDrawDisplayButton;
 }; 
 
 class DisplayButton
 {
 private:
     double _dTemp;
+    bool _occluded;
     void init(  TFT_eSPI *tft, 
                 int16_t x, 
                 int16_t y, 
                 uint16_t width,
                 uint16_t height,
-                uint16_t outlineColor,
-                uint16_t fillColor,
-                uint16_t textColor,
-                uint8_t textsize,
+                DisplayStyle *pStyle,
                 const char *text,
                 DisplayButtonType type,
                 DisplayState state,
@@ -78,10 +88,11 @@ private:
                 double *pLinkedValue,
                 double incrementValue,
                 DisplayPage *pageToOpen,
-                ButtonPressedFunction buttonPressedFunction,
+                DisplayButtonDelegate buttonPressedFunction,
                 TextAlign textAlign = ALIGN_CENTER
                 );
 public:
+    DISPLAY_MEMORY_TRACKED
     bool  _currentState, 
           _lastState; 
     String getText() { return _values.text; };
@@ -96,6 +107,37 @@ public:
     void setLinkToValue(double *pLinkedValue, String valueName);
     
     double *getLinkedValue() { return _values.pLinkedValue; };
+
+    /**
+     * @brief Draw the linked value instead of the button text.  The value is formatted 
+     * into a buffer on the stack every time the button is drawn so no heap memory is used.
+     * 
+     * @param precision Number of decimals to show. Pass -1 to draw the button text again.
+     * @param trimZeros Should ending zeros in the decimals be removed
+     */
+    void setLinkedValueFormat(int8_t precision, bool trimZeros = true);
+
+    /**
+     * @brief Bind the button to a typed variable. An increment button steps the variable when pressed,
+     * other buttons draw the variable instead of their text.
+     * 
+     * @param pBinding The binding, it must exist for as long as the button does. NULL removes the binding.
+     * @param incrementSteps How many steps an increment button changes the variable by
+     */
+    void setBinding(DisplayValue *pBinding, int16_t incrementSteps = 0);
+    DisplayValue *getBinding() { return _values.pBinding; };
+
+    /**
+     * @brief Does the button draw it's bound variable
+     * 
+     */
+    bool showsBinding() { return _values.pBinding && _values.type != INCREMENT_VALUE; };
+
+    /**
+     * @brief Does the button draw a value, which can change without the button being changed
+     * 
+     */
+    bool showsValue() { return showsBinding() || (_values.pLinkedValue && _values.linkedValuePrecision > -1); };
     String getLinkedValueName() { return _values.linkedValueName; };
     void setPageToOpen(DisplayPage *pageToOpen) { _values.pPageToOpen = pageToOpen; };
     DisplayPage *getPageToOpen() { return _values.pPageToOpen; };
@@ -107,6 +149,45 @@ public:
     DISPLAY_BUTTON_VALUES getValues() { return _values; };
 
     DisplayButton(const DisplayButton &button);
+    DisplayButton &operator=(const DisplayButton &button);
+    ~DisplayButton();
+
+    /**
+     * @brief Get the style which decides the colors, text size and corners of the button
+     * 
+     */
+    DisplayStyle *getStyle() { return _values.pStyle; };
+
+    /**
+     * @brief Make the button look like the given style, the button keeps a reference to it.
+     * 
+     */
+    void setStyle(DisplayStyle *pStyle);
+
+    /**
+     * @brief Changes the colors of only this button, it gets a style of it's own or one shared with buttons of the same colors
+     * 
+     */
+    void setColors(uint16_t outlineColor, uint16_t fillColor, uint16_t textColor);
+    void setRadius(uint8_t radius);
+    uint8_t getRadius() { return _values.pStyle->getRadius(_values.width, _values.height); };
+
+    /**
+     * @brief The colors and text size the button is drawn with, read from it's style.
+     * They replace the fields of the same names which were in the values before styles.
+     * 
+     */
+    uint16_t getOutlineColor() { return _values.pStyle->getOutlineColor(); };
+    uint16_t getFillColor() { return _values.pStyle->getFillColor(); };
+    uint16_t getTextColor() { return _values.pStyle->getTextColor(); };
+    uint8_t getTextSize() { return _values.pStyle->getTextSize(); };
+
+    /**
+     * @brief Draws the text of only this button with a font, NULL uses the menu font
+     * 
+     */
+    void setFont(DisplayFont *pFont);
+    DisplayFont *getFont() { return _values.pStyle->getFont(); };
     
     DisplayButton(  TFT_eSPI *tft, 
                     int16_t x, 
@@ -121,7 +202,7 @@ public:
                     DisplayButtonType type,
                     DisplayPage *page,
                     DisplayPage *pPageToOpen,
-                    ButtonPressedFunction buttonPressed
+                    DisplayButtonDelegate buttonPressed
                     );
 
     DisplayButton(  TFT_eSPI *tft,
@@ -149,10 +230,10 @@ public:
      * Node if you need more speed this variable should be false;
      */
     void draw(bool inverted=false,  bool cancelDrawIfPageIsNotVisable = true);
-    void registerOnDrawEvent(OnDrawDisplayButton pOnDrawDisplayButton) {
+    void registerOnDrawEvent(DisplayButtonDelegate pOnDrawDisplayButton) {
         _values.onDrawDisplayButton = pOnDrawDisplayButton;
     }
-    void registerOnButtonPressedEvent(ButtonPressedFunction buttonPressed) {
+    void registerOnButtonPressedEvent(DisplayButtonDelegate buttonPressed) {
         _values.buttonPressedFunction = buttonPressed;
     }
     bool contains(int16_t x, int16_t y);
@@ -163,6 +244,19 @@ public:
     bool justReleased();
     bool executeCommand();
     DisplayPage *getPage() { return _values.pPage; }
+
+    /**
+     * @brief Get the area this button covers on the screen
+     * 
+     */
+    DisplayRect getRect() { return DisplayRect(_values.x, _values.y, _values.width, _values.height); }
+
+    /**
+     * @brief Is this button completely covered by other opaque items on the page.
+     * Set by the page every time it is drawn, covered items are not drawn.
+     */
+    bool isOccluded() { return _occluded; }
+    void setOccluded(bool occluded) { _occluded = occluded; }
 };
 
 
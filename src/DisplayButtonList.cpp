@@ -1,5 +1,11 @@
 #include "DisplayButtonList.h"
 bool DisplayButtonList::add(DisplayButton button) {
+    if (_pool.size() > 0)
+    {
+        DisplayButton *p = _pool.pop();
+        *p = button;
+        return LinkedList<DisplayButton*>::add(p);
+    }
     return LinkedList<DisplayButton*>::add(new DisplayButton(button));
 }
 
@@ -14,16 +20,30 @@ DisplayButton *DisplayButtonList::findButtonByText(String text) {
     return NULL;
 }
 
+void DisplayButtonList::recycle(DisplayButton *pButton) {
+    if (_pool.size() < _poolSize)
+        _pool.add(pButton);
+    else
+        delete pButton;
+}
+
+bool DisplayButtonList::remove(DisplayButton *pButton) {
+    int index = indexOf(pButton);
+    if (index < 0)
+        return false;
+
+    recycle(LinkedList<DisplayButton*>::remove(index));
+    return true;
+}
+
+void DisplayButtonList::setPoolSize(uint16_t poolSize) {
+    _poolSize = poolSize;
+    while (_pool.size() > _poolSize)
+        delete _pool.pop();
+}
+
 void DisplayButtonList::destory() {
-    DisplayButton* p;
-    for (int i = 0; i < size(); i++) {
-        p = get(i);
-        if (p != NULL)
-        {
-            delay(10);
-            delete p;
-            set(i, NULL);
-        }
-    }
-    clear();
-}
\ No newline at end of file
+    //items are taken from the front, so no item has to be searched for
+    while (size() > 0)
+        recycle(shift());
+}
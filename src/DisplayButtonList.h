@@ -8,6 +8,14 @@
 class DisplayButtonList : public LinkedList<DisplayButton*> {
 
 private:
+    LinkedList<DisplayButton*> _pool;
+    uint16_t _poolSize = 0;
+
+    /**
+     * @brief Keeps a removed item for reuse if the pool has room, otherwise deletes it
+     * 
+     */
+    void recycle(DisplayButton *pButton);
     
     /**
      * @brief The cleanup function used by the list's deconstructor;
@@ -33,8 +41,28 @@ public:
      */
     int count() { return size(); };
 
+    /**
+     * @brief Deletes all buttons in the list and empties it
+     * 
+     */
+    void removeAll() { destory(); };
+
+    /**
+     * @brief Removes one button from the list and deletes it, or keeps it in the pool
+     * 
+     * @return true if the button was in the list
+     */
+    bool remove(DisplayButton *pButton);
+
+    /**
+     * @brief Set how many removed buttons are kept to be reused by add, instead of being deleted and allocated again
+     * 
+     */
+    void setPoolSize(uint16_t poolSize);
+    int poolCount() { return _pool.size(); };
+
     
-    ~DisplayButtonList() { destory(); }
+    ~DisplayButtonList() { destory(); setPoolSize(0); }
     
 };
 
@@ -0,0 +1,286 @@
+#include "DisplayChart.h"
+#include "DisplayMenu.h"
+
+DisplayChart::DisplayChart(TFT_eSPI *tft,
+                           DisplayPage *page,
+                           int16_t x,
+                           int16_t y,
+                           uint16_t width,
+                           uint16_t height,
+                           uint16_t outlineColor,
+                           uint16_t fillColor,
+                           uint16_t lineColor,
+                           uint16_t samplesPerColumn) : DisplayWidget(tft, page, x, y, width, height)
+{
+    _outlineColor = outlineColor;
+    _fillColor = fillColor;
+    _lineColor = lineColor;
+    _samplesPerColumn = max((uint16_t)1, samplesPerColumn);
+    _min = 0;
+    _max = 100;
+    _pLinkedValue = NULL;
+
+    //one column for every pixel inside the outline
+    _capacity = max(1, (int)width - 2);
+    _pColumns = new DISPLAY_CHART_COLUMN[_capacity];
+    _pDrawn = new DISPLAY_CHART_SPAN[_capacity];
+    _count = 0;
+    _first = 0;
+    _pendingCount = 0;
+    _pPlot = NULL;
+    _plotValid = false;
+    _plotFailed = false;
+    for (int16_t i = 0; i < _capacity; i++)
+    {
+        _pDrawn[i].top = 1;
+        _pDrawn[i].bottom = 0;
+    }
+}
+
+DisplayChart::~DisplayChart()
+{
+    freePlot();
+    delete[] _pColumns;
+    delete[] _pDrawn;
+}
+
+size_t DisplayChart::getMemorySize()
+{
+    size_t bytes = sizeof(DisplayChart) + (_capacity * (sizeof(DISPLAY_CHART_COLUMN) + sizeof(DISPLAY_CHART_SPAN))) + _linkedValueName.length() + 1;
+    if (_pPlot)
+        bytes += sizeof(TFT_eSprite) + (((_capacity + 7) / 8) * (_rect.height - 2));
+    return bytes;
+}
+
+void DisplayChart::freePlot()
+{
+    if (_pPlot)
+    {
+        _pPlot->deleteSprite();
+        delete _pPlot;
+        _pPlot = NULL;
+    }
+    _plotValid = false;
+}
+
+void DisplayChart::pageHidden()
+{
+    freePlot();
+    //a chart which did not get memory may get it the next time it is shown
+    _plotFailed = false;
+}
+
+void DisplayChart::setLinkToValue(double *pLinkedValue, String valueName)
+{
+    _pLinkedValue = pLinkedValue;
+    _linkedValueName = valueName;
+}
+
+void DisplayChart::setRange(double min, double max)
+{
+    _min = min;
+    _max = max;
+    draw();
+}
+
+void DisplayChart::clear()
+{
+    _count = 0;
+    _first = 0;
+    _pendingCount = 0;
+    draw();
+}
+
+void DisplayChart::sample()
+{
+    if (_pLinkedValue)
+        addSample(*_pLinkedValue);
+}
+
+bool DisplayChart::addSample(double value)
+{
+    if (isnan(value))
+        return false;
+
+    float sample = (float)value;
+    if (_pendingCount == 0)
+    {
+        _pending.min = sample;
+        _pending.max = sample;
+    }
+    else
+    {
+        _pending.min = min(_pending.min, sample);
+        _pending.max = max(_pending.max, sample);
+    }
+    _pending.last = sample;
+
+    if (++_pendingCount < _samplesPerColumn)
+        return false;
+
+    _pendingCount = 0;
+    if (_count < _capacity)
+    {
+        _pColumns[(_first + _count) % _capacity] = _pending;
+        _count++;
+        if (!isPageVisable() || _occluded)
+            return true;
+
+        //the columns before it stay where they are
+        drawColumn(_count - 1);
+        return true;
+    }
+
+    //the oldest column is replaced, all columns move one pixel to the left
+    _pColumns[_first] = _pending;
+    _first = (_first + 1) % _capacity;
+
+    if (!isPageVisable() || _occluded)
+    {
+        _plotValid = false;
+        return true;
+    }
+
+    if (!scrollPlot())
+    {
+        for (int16_t column = 0; column < _capacity; column++)
+            drawColumn(column);
+    }
+    return true;
+}
+
+bool DisplayChart::scrollPlot()
+{
+    if (!_pPlot && !_plotFailed)
+    {
+        _pPlot = new TFT_eSprite(_tft);
+        _pPlot->setColorDepth(1);
+        if (!_pPlot->createSprite(_capacity, _rect.height - 2))
+        {
+            delete _pPlot;
+            _pPlot = NULL;
+            _plotFailed = true;
+        }
+    }
+    if (!_pPlot)
+        return false;
+
+    _pPlot->setBitmapColor(_lineColor, _fillColor);
+    if (_plotValid)
+    {
+        //the leftmost column lost the column it was joined to
+        _pPlot->scroll(-1, 0);
+        _pPlot->drawFastVLine(0, 0, _rect.height - 2, 0);
+        drawPlotColumn(0);
+        drawPlotColumn(_capacity - 1);
+    }
+    else
+    {
+        _pPlot->fillSprite(0);
+        for (int16_t column = 0; column < _capacity; column++)
+            drawPlotColumn(column);
+        _plotValid = true;
+    }
+    //what drawColumn remembers is out of date now, draw resets it before the columns are drawn one by one again
+    _pPlot->pushSprite(_rect.x + 1, _rect.y + 1);
+    return true;
+}
+
+void DisplayChart::drawPlotColumn(int16_t column)
+{
+    DISPLAY_CHART_SPAN span = columnSpan(column);
+    if (span.top <= span.bottom)
+        _pPlot->drawFastVLine(column, span.top - (_rect.y + 1), span.bottom - span.top + 1, 1);
+}
+
+int16_t DisplayChart::valueToY(float value)
+{
+    int16_t top = _rect.y + 1,
+            bottom = _rect.bottom() - 2;
+
+    if (_max <= _min)
+        return bottom;
+
+    float fraction = (value - _min) / (_max - _min);
+    fraction = constrain(fraction, 0.0f, 1.0f);
+    return bottom - (int16_t)((fraction * (bottom - top)) + 0.5f);
+}
+
+DISPLAY_CHART_SPAN DisplayChart::columnSpan(int16_t column)
+{
+    DISPLAY_CHART_SPAN span = {1, 0};
+    if (column >= _count)
+        return span;
+
+    DISPLAY_CHART_COLUMN &values = _pColumns[(_first + column) % _capacity];
+    span.top = valueToY(values.max);
+    span.bottom = valueToY(values.min);
+
+    //reach to where the column before ended, so a change between columns is a connected line
+    if (column > 0)
+    {
+        int16_t previous = valueToY(_pColumns[(_first + column - 1) % _capacity].last);
+        span.top = min(span.top, previous);
+        span.bottom = max(span.bottom, previous);
+    }
+    return span;
+}
+
+void DisplayChart::drawColumn(int16_t column)
+{
+    DISPLAY_CHART_SPAN now = columnSpan(column),
+                       drawn = _pDrawn[column];
+    int16_t x = _rect.x + 1 + column;
+    bool hasNow = now.top <= now.bottom,
+         hasDrawn = drawn.top <= drawn.bottom;
+
+    //clear the drawn pixels which are not part of the new line
+    if (hasDrawn)
+    {
+        if (!hasNow || now.bottom < drawn.top || now.top > drawn.bottom)
+        {
+            _tft->drawFastVLine(x, drawn.top, drawn.bottom - drawn.top + 1, _fillColor);
+        }
+        else
+        {
+            if (drawn.top < now.top)
+                _tft->drawFastVLine(x, drawn.top, now.top - drawn.top, _fillColor);
+            if (drawn.bottom > now.bottom)
+                _tft->drawFastVLine(x, now.bottom + 1, drawn.bottom - now.bottom, _fillColor);
+        }
+    }
+
+    //draw the new line where it is not drawn already
+    if (hasNow)
+    {
+        if (!hasDrawn || now.bottom < drawn.top || now.top > drawn.bottom)
+        {
+            _tft->drawFastVLine(x, now.top, now.bottom - now.top + 1, _lineColor);
+        }
+        else
+        {
+            if (now.top < drawn.top)
+                _tft->drawFastVLine(x, now.top, drawn.top - now.top, _lineColor);
+            if (now.bottom > drawn.bottom)
+                _tft->drawFastVLine(x, drawn.bottom + 1, now.bottom - drawn.bottom, _lineColor);
+        }
+    }
+
+    _pDrawn[column] = now;
+}
+
+void DisplayChart::draw()
+{
+    _plotValid = false;
+    if (!isPageVisable())
+        return;
+
+    _tft->drawRect(_rect.x, _rect.y, _rect.width, _rect.height, _outlineColor);
+    _tft->fillRect(_rect.x + 1, _rect.y + 1, _rect.width - 2, _rect.height - 2, _fillColor);
+    for (int16_t column = 0; column < _capacity; column++)
+    {
+        _pDrawn[column].top = 1;
+        _pDrawn[column].bottom = 0;
+        drawColumn(column);
+    }
+}
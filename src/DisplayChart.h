@@ -0,0 +1,147 @@
+#ifndef DISPLAYCHART_H
+#define DISPLAYCHART_H
+
+#include <Arduino.h>
+
+#include <TFT_eSPI.h>
+
+#include "DisplayWidget.h"
+
+/**
+ * @brief One column of a chart, all samples which fall on the same pixel column.
+ *
+ */
+struct DISPLAY_CHART_COLUMN {
+    float min;
+    float max;
+    float last;
+};
+
+/**
+ * @brief The pixel lines drawn in one column of the chart, top > bottom when nothing is drawn.
+ *
+ */
+struct DISPLAY_CHART_SPAN {
+    int16_t top;
+    int16_t bottom;
+};
+
+/**
+ * @brief A chart of a value over time which scrolls from right to left.
+ *
+ * The samples are kept in a ring buffer with one entry for every pixel column of the chart.
+ * When more samples are added than there are pixels, each column keeps the lowest and the highest of it's samples
+ * and is drawn as a line between them, so short spikes are not lost.
+ * Until the chart is full only the added column is drawn. Once it is full the plot is kept in a 1 bit sprite,
+ * which is scrolled one pixel in memory, gets the new column and is pushed to the screen in one go.
+ * When there is not memory for the sprite the chart remembers what it drew in every column and
+ * only the pixels which differ from what is on the screen are drawn.
+ *
+ * @code .cpp
+ * DisplayChart *pChart = pPage->addChart(10, 40, 300, 150, TFT_DARKGREY, TFT_BLACK, TFT_GOLD, 10);
+ * pChart->setRange(15, 30);
+ * pChart->setLinkToValue(&temperature, "Temperature");
+ *
+ * //in loop, 10 samples for each pixel column
+ * pChart->sample();
+ * @endcode
+ */
+class DisplayChart : public DisplayWidget
+{
+private:
+    uint16_t _outlineColor;
+    uint16_t _fillColor;
+    uint16_t _lineColor;
+    uint16_t _samplesPerColumn;
+    double _min;
+    double _max;
+    double *_pLinkedValue;
+    String _linkedValueName;
+
+    DISPLAY_CHART_COLUMN *_pColumns;
+    DISPLAY_CHART_SPAN *_pDrawn;
+    int16_t _capacity;
+    int16_t _count;
+    int16_t _first;
+
+    DISPLAY_CHART_COLUMN _pending;
+    uint16_t _pendingCount;
+
+    //the plot of a full chart, valid when it shows the same columns as the screen
+    TFT_eSprite *_pPlot;
+    bool _plotValid;
+    bool _plotFailed;
+
+    int16_t valueToY(float value);
+    DISPLAY_CHART_SPAN columnSpan(int16_t column);
+    void drawColumn(int16_t column);
+    void drawPlotColumn(int16_t column);
+    bool scrollPlot();
+    void freePlot();
+
+public:
+    DisplayChart(TFT_eSPI *tft,
+                 DisplayPage *page,
+                 int16_t x,
+                 int16_t y,
+                 uint16_t width,
+                 uint16_t height,
+                 uint16_t outlineColor,
+                 uint16_t fillColor,
+                 uint16_t lineColor,
+                 uint16_t samplesPerColumn = 1);
+    ~DisplayChart();
+
+    /**
+     * @brief Set the values at the bottom and the top of the chart, the whole chart is drawn again
+     *
+     */
+    void setRange(double min, double max);
+    double getMin() { return _min; };
+    double getMax() { return _max; };
+
+    /**
+     * @brief Set how many samples are combined into one pixel column
+     *
+     */
+    void setSamplesPerColumn(uint16_t samplesPerColumn) { _samplesPerColumn = max((uint16_t)1, samplesPerColumn); };
+    uint16_t getSamplesPerColumn() { return _samplesPerColumn; };
+
+    void setLinkToValue(double *pLinkedValue, String valueName);
+    double *getLinkedValue() { return _pLinkedValue; };
+    String getLinkedValueName() { return _linkedValueName; };
+
+    /**
+     * @brief Adds the linked value as a sample
+     *
+     */
+    void sample();
+
+    /**
+     * @brief Adds a sample, when enough samples for a column have been added the column is drawn
+     *
+     * @return true if a column was added
+     */
+    bool addSample(double value);
+
+    /**
+     * @brief Removes all samples
+     *
+     */
+    void clear();
+
+    int16_t getColumnCount() { return _count; };
+    int16_t getCapacity() { return _capacity; };
+
+    void draw();
+
+    /**
+     * @brief Frees the plot sprite, it is made again when the chart is shown and full
+     *
+     */
+    void pageHidden();
+    size_t getMemorySize();
+    const char *getTypeName() { return "DisplayChart"; }
+};
+
+#endif
@@ -0,0 +1,159 @@
+#ifndef DISPLAYDELEGATE_H
+#define DISPLAYDELEGATE_H
+
+#include <Arduino.h>
+
+class DisplayDelegateDummy;
+
+/**
+ * @brief Room for a pointer to a member function, which on most compilers is two pointers.
+ *
+ */
+#define DISPLAY_DELEGATE_METHOD_SIZE sizeof(void (DisplayDelegateDummy::*)())
+
+/**
+ * @brief A function to call when an event happens, which can carry a pointer to the data it works on.
+ *
+ * A delegate holds one of
+ * - a plain function, like the event functions of the menu always have been
+ * - a function and a context pointer which is passed to it as the first argument
+ * - an object and one of it's member functions
+ *
+ * Everything is stored inside the delegate, it never uses the heap, and it can be copied like a pointer.
+ * A plain function converts to a delegate, so functions can be registered for events as before.
+ *
+ * @code .cpp
+ * struct VALVE {
+ *     double flow;
+ * };
+ * VALVE coldValve;
+ *
+ * void openValve(VALVE *pValve, DisplayButton *pButton)
+ * {
+ *     pValve->flow = 100;
+ * }
+ *
+ * class Controller {
+ * public:
+ *     void stop(DisplayButton *pButton);
+ * };
+ * Controller controller;
+ *
+ * pPage->addFunctionButton(10, 10, 100, 40, TFT_WHITE, TFT_RED, TFT_GOLD, 1, "Open", DisplayButtonDelegate(openValve, &coldValve));
+ * pPage->addFunctionButton(10, 60, 100, 40, TFT_WHITE, TFT_RED, TFT_GOLD, 1, "Stop", DisplayButtonDelegate::bind(&controller, &Controller::stop));
+ * @endcode
+ *
+ * @tparam Args The arguments of the event
+ */
+template <typename... Args>
+class DisplayDelegate
+{
+public:
+    typedef void (*Function)(Args...);
+
+private:
+    typedef void (*Invoker)(const DisplayDelegate &delegate, Args... args);
+    typedef void (*AnyFunction)();
+
+    Invoker _invoke;
+    void *_pContext;
+    union {
+        Function function;
+        AnyFunction contextFunction;
+        unsigned char method[DISPLAY_DELEGATE_METHOD_SIZE];
+    } _target;
+
+    static void invokeFunction(const DisplayDelegate &delegate, Args... args)
+    {
+        delegate._target.function(args...);
+    }
+
+    template <class T>
+    static void invokeContext(const DisplayDelegate &delegate, Args... args)
+    {
+        void (*function)(T *, Args...) = reinterpret_cast<void (*)(T *, Args...)>(delegate._target.contextFunction);
+        function((T *)delegate._pContext, args...);
+    }
+
+    template <class T>
+    static void invokeMethod(const DisplayDelegate &delegate, Args... args)
+    {
+        void (T::*method)(Args...);
+        memcpy(&method, delegate._target.method, sizeof(method));
+        (((T *)delegate._pContext)->*method)(args...);
+    }
+
+public:
+    /**
+     * @brief An empty delegate, calling it does nothing
+     *
+     */
+    DisplayDelegate()
+    {
+        _invoke = NULL;
+        _pContext = NULL;
+        memset(&_target, 0, sizeof(_target));
+    }
+
+    /**
+     * @brief A delegate calling a plain function, NULL makes an empty delegate
+     *
+     */
+    DisplayDelegate(Function function)
+    {
+        _invoke = function ? invokeFunction : NULL;
+        _pContext = NULL;
+        memset(&_target, 0, sizeof(_target));
+        _target.function = function;
+    }
+
+    /**
+     * @brief A delegate calling a function with a context pointer as it's first argument
+     *
+     */
+    template <class T>
+    DisplayDelegate(void (*function)(T *pContext, Args...), T *pContext)
+    {
+        _invoke = function ? invokeContext<T> : NULL;
+        _pContext = (void *)pContext;
+        memset(&_target, 0, sizeof(_target));
+        _target.contextFunction = reinterpret_cast<AnyFunction>(function);
+    }
+
+    /**
+     * @brief Makes a delegate calling a member function of an object
+     *
+     */
+    template <class T>
+    static DisplayDelegate bind(T *pObject, void (T::*method)(Args...))
+    {
+        static_assert(sizeof(method) <= DISPLAY_DELEGATE_METHOD_SIZE, "member function pointer does not fit in a DisplayDelegate");
+        DisplayDelegate delegate;
+        if (pObject && method)
+        {
+            delegate._invoke = invokeMethod<T>;
+            delegate._pContext = (void *)pObject;
+            memcpy(delegate._target.method, &method, sizeof(method));
+        }
+        return delegate;
+    }
+
+    bool isSet() const { return _invoke != NULL; }
+    explicit operator bool() const { return _invoke != NULL; }
+
+    /**
+     * @brief The plain function this delegate calls
+     *
+     * @return Function NULL if the delegate is empty, has a context or calls a member function
+     */
+    Function getFunction() const { return _invoke == invokeFunction ? _target.function : NULL; }
+    void *getContext() const { return _pContext; }
+
+    void operator()(Args... args) const
+    {
+        if (_invoke)
+            _invoke(*this, args...);
+    }
+};
+
+#endif
@@ -0,0 +1,42 @@
+#include "DisplayFont.h"
+
+DisplayFont::DisplayFont(const GFXfont *pFont)
+{
+    _pGfxFont = pFont;
+    _pSmoothFont = NULL;
+    _pFileSystem = NULL;
+}
+
+DisplayFont::DisplayFont(const uint8_t *pSmoothFont)
+{
+    _pGfxFont = NULL;
+    _pSmoothFont = pSmoothFont;
+    _pFileSystem = NULL;
+}
+
+DisplayFont::DisplayFont(String smoothFontName, fs::FS &fileSystem)
+{
+    _pGfxFont = NULL;
+    _pSmoothFont = NULL;
+    _smoothFontName = smoothFontName;
+    _pFileSystem = &fileSystem;
+}
+
+void DisplayFont::select(TFT_eSPI *pTarget)
+{
+#ifdef SMOOTH_FONT
+    //a loaded smooth font is used before any GFX font, so it must be unloaded first
+    if (_pSmoothFont)
+    {
+        pTarget->loadFont(_pSmoothFont);
+        return;
+    }
+    if (_pFileSystem)
+    {
+        pTarget->loadFont(_smoothFontName, *_pFileSystem);
+        return;
+    }
+    pTarget->unloadFont();
+#endif
+    pTarget->setFreeFont(_pGfxFont);
+}
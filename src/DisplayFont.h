@@ -0,0 +1,83 @@
+#ifndef DISPLAYFONT_H
+#define DISPLAYFONT_H
+
+#include <Arduino.h>
+
+#include <FS.h>
+
+#include <TFT_eSPI.h>
+
+/**
+ * @brief A font buttons, labels and widgets are drawn with, a GFX free font or a smooth anti-aliased .vlw font.
+ *
+ * Selecting a GFX font only sets a pointer, but selecting a smooth font loads it, which reads the glyph table
+ * and allocates memory for it. The menu remembers which font it last selected on each display and pages draw their
+ * items grouped by font, so a smooth font is loaded at most once each time a page is drawn.
+ * Smooth fonts need SMOOTH_FONT in the TFT_eSPI setup. A font must exist for as long as the styles and widgets using it.
+ *
+ * @code .cpp
+ * #include "NotoSansBold15.h"
+ *
+ * DisplayFont bigFont(&FreeSans12pt7b);
+ * DisplayFont smoothFont(NotoSansBold15);          //.vlw array in flash
+ * DisplayFont fileFont("NotoSansBold36", SPIFFS);  //NotoSansBold36.vlw in SPIFFS
+ *
+ * DisplayStyle *pTitle = DisplayStyle::create(TFT_BLACK, TFT_BLACK, TFT_GOLD, 1, 0, &bigFont);
+ * pPage->addPageLabel(10, 10, 200, 30, TFT_BLACK, TFT_BLACK, TFT_GOLD, 1, "Valves")->setStyle(pTitle);
+ * pTitle->release();
+ * pBar->setFont(&smoothFont);
+ * @endcode
+ */
+class DisplayFont
+{
+private:
+    const GFXfont *_pGfxFont;
+    const uint8_t *_pSmoothFont;
+    String _smoothFontName;
+    fs::FS *_pFileSystem;
+
+public:
+    /**
+     * @brief A GFX free font
+     *
+     */
+    DisplayFont(const GFXfont *pFont = &FreeMonoBold9pt7b);
+
+    /**
+     * @brief A smooth font from a .vlw file converted to an array, the array must exist for as long as the font does
+     *
+     */
+    DisplayFont(const uint8_t *pSmoothFont);
+
+    /**
+     * @brief A smooth font loaded from a .vlw file every time it is selected
+     *
+     * @param smoothFontName Name of the file without the .vlw ending
+     * @param fileSystem Where the file is, for example SPIFFS
+     */
+    DisplayFont(String smoothFontName, fs::FS &fileSystem);
+
+    bool isSmooth() { return _pSmoothFont != NULL || _pFileSystem != NULL; };
+
+    /**
+     * @brief The GFX free font, NULL if this is a smooth font
+     *
+     */
+    const GFXfont *getGfxFont() { return isSmooth() ? NULL : _pGfxFont; };
+    const uint8_t *getSmoothFont() { return _pSmoothFont; };
+    String getSmoothFontName() { return _smoothFontName; };
+
+    /**
+     * @brief The file system a smooth font is loaded from, NULL if it is not loaded from a file
+     *
+     */
+    fs::FS *getFileSystem() { return _pFileSystem; };
+
+    /**
+     * @brief Makes this the font text is drawn with on a display or a sprite
+     *
+     */
+    void select(TFT_eSPI *pTarget);
+};
+
+#endif
@@ -0,0 +1,389 @@
+#include "DisplayGlyphCache.h"
+#include "DisplayMenu.h"
+
+#if defined(ESP32)
+#include <esp_heap_caps.h>
+#endif
+
+//a .vlw font starts with a header of six 32 bit numbers, the first is the glyph count,
+//followed by a record of seven 32 bit numbers for every glyph and then the alpha bitmaps in the same order
+#define VLW_HEADER_SIZE 24
+#define VLW_RECORD_SIZE 28
+
+/**
+ * @brief A glyph record read from the font file and where it's bitmap is in the file
+ *
+ */
+struct DISPLAY_GLYPH {
+    uint8_t record[VLW_RECORD_SIZE];
+    uint32_t offset;
+};
+
+DisplayGlyphCache::DisplayGlyphCache(size_t maxBytes, const char *alwaysChars)
+{
+    _maxBytes = maxBytes;
+    _usedBytes = 0;
+    _alwaysChars = alwaysChars ? alwaysChars : "";
+    _generation = 0;
+    _hits = 0;
+    _reads = 0;
+}
+
+int DisplayGlyphCache::find(DisplayFont *pFont)
+{
+    for (int i = 0; i < _size; i++)
+    {
+        if (get(i)->pFont == pFont)
+            return i;
+    }
+    return -1;
+}
+
+DISPLAY_GLYPH_CACHE_ENTRY *DisplayGlyphCache::addEntry(DisplayFont *pFont)
+{
+    DISPLAY_GLYPH_CACHE_ENTRY *pEntry = new DISPLAY_GLYPH_CACHE_ENTRY;
+    pEntry->pFont = pFont;
+    pEntry->pCodes = NULL;
+    pEntry->codeCount = 0;
+    pEntry->pData = NULL;
+    pEntry->bytes = 0;
+    pEntry->stale = true;
+    addText(pEntry, _alwaysChars.c_str());
+    unshift(pEntry);
+    return pEntry;
+}
+
+void DisplayGlyphCache::freeData(DISPLAY_GLYPH_CACHE_ENTRY *pEntry)
+{
+    if (pEntry->pData == NULL)
+        return;
+
+    free(pEntry->pData);
+    _usedBytes -= pEntry->bytes;
+    pEntry->pData = NULL;
+    pEntry->bytes = 0;
+    _generation++;
+}
+
+void DisplayGlyphCache::removeEntry(int index)
+{
+    DISPLAY_GLYPH_CACHE_ENTRY *pEntry = LinkedList<DISPLAY_GLYPH_CACHE_ENTRY *>::remove(index);
+    if (pEntry == NULL)
+        return;
+
+    freeData(pEntry);
+    delete[] pEntry->pCodes;
+    delete pEntry;
+}
+
+void DisplayGlyphCache::destory()
+{
+    while (_size > 0)
+        removeEntry(_size - 1);
+    clear();
+}
+
+uint16_t DisplayGlyphCache::decodeUtf8(const char *&pText)
+{
+    uint8_t c = *pText++;
+    if (c < 0x80)
+        return c;
+
+    if ((c & 0xE0) == 0xC0 && (pText[0] & 0xC0) == 0x80)
+        return ((c & 0x1F) << 6) | (*pText++ & 0x3F);
+
+    if ((c & 0xF0) == 0xE0 && (pText[0] & 0xC0) == 0x80 && (pText[1] & 0xC0) == 0x80)
+    {
+        uint16_t code = ((c & 0x0F) << 12) | ((pText[0] & 0x3F) << 6) | (pText[1] & 0x3F);
+        pText += 2;
+        return code;
+    }
+    return c;
+}
+
+bool DisplayGlyphCache::hasCode(const uint16_t *pCodes, uint16_t count, uint32_t code)
+{
+    int low = 0,
+        high = count - 1;
+    while (low <= high)
+    {
+        int middle = (low + high) / 2;
+        if (pCodes[middle] == code)
+            return true;
+        if (pCodes[middle] < code)
+            low = middle + 1;
+        else
+            high = middle - 1;
+    }
+    return false;
+}
+
+uint32_t DisplayGlyphCache::readInt32(const uint8_t *pBytes)
+{
+    //.vlw numbers are big endian
+    return ((uint32_t)pBytes[0] << 24) | ((uint32_t)pBytes[1] << 16) | ((uint32_t)pBytes[2] << 8) | pBytes[3];
+}
+
+bool DisplayGlyphCache::hasText(DISPLAY_GLYPH_CACHE_ENTRY *pEntry, const char *pText)
+{
+    while (*pText)
+    {
+        if (!hasCode(pEntry->pCodes, pEntry->codeCount, decodeUtf8(pText)))
+            return false;
+    }
+    return true;
+}
+
+void DisplayGlyphCache::addText(DISPLAY_GLYPH_CACHE_ENTRY *pEntry, const char *pText)
+{
+    if (hasText(pEntry, pText))
+        return;
+
+    //a character is never more than one code, so the text's length is enough room
+    uint16_t *pCodes = new uint16_t[pEntry->codeCount + strlen(pText)];
+    uint16_t count = pEntry->codeCount;
+    if (count > 0)
+        memcpy(pCodes, pEntry->pCodes, count * sizeof(uint16_t));
+
+    while (*pText)
+    {
+        uint16_t code = decodeUtf8(pText);
+        int index = 0;
+        while (index < count && pCodes[index] < code)
+            index++;
+        if (index < count && pCodes[index] == code)
+            continue;
+
+        memmove(&pCodes[index + 1], &pCodes[index], (count - index) * sizeof(uint16_t));
+        pCodes[index] = code;
+        count++;
+    }
+
+    delete[] pEntry->pCodes;
+    pEntry->pCodes = pCodes;
+    pEntry->codeCount = count;
+    pEntry->stale = true;
+}
+
+void DisplayGlyphCache::makeRoom(size_t bytes, DISPLAY_GLYPH_CACHE_ENTRY *pKeep)
+{
+    //glyphs of the fonts least recently prepared or grown are dropped first
+    for (int i = _size - 1; i >= 0 && _usedBytes + bytes > _maxBytes; i--)
+    {
+        if (get(i) != pKeep)
+            freeData(get(i));
+    }
+}
+
+bool DisplayGlyphCache::build(DISPLAY_GLYPH_CACHE_ENTRY *pEntry)
+{
+    freeData(pEntry);
+    pEntry->stale = false;
+
+    DisplayFont *pFont = pEntry->pFont;
+    if (pFont->getFileSystem() == NULL)
+        return false;
+
+    //the same path TFT_eSPI::loadFont opens
+    File file = pFont->getFileSystem()->open("/" + pFont->getSmoothFontName() + ".vlw", "r");
+    if (!file)
+        return false;
+    _reads++;
+
+    uint8_t header[VLW_HEADER_SIZE];
+    if (file.read(header, VLW_HEADER_SIZE) != VLW_HEADER_SIZE)
+    {
+        file.close();
+        return false;
+    }
+
+    //the glyphs asked for, and the two glyphs TFT_eSPI takes the height of a line from
+    uint32_t glyphCount = readInt32(header);
+    DISPLAY_GLYPH *pGlyphs = new DISPLAY_GLYPH[pEntry->codeCount + 2];
+    DISPLAY_GLYPH ascent, descent;
+    int32_t maxAscent = -1,
+            maxDescent = -1;
+    uint16_t found = 0;
+    uint32_t offset = VLW_HEADER_SIZE + (glyphCount * VLW_RECORD_SIZE);
+    size_t bitmapBytes = 0;
+    bool readOk = true;
+
+    for (uint32_t i = 0; i < glyphCount && readOk; i++)
+    {
+        uint8_t record[VLW_RECORD_SIZE];
+        if (file.read(record, VLW_RECORD_SIZE) != VLW_RECORD_SIZE)
+        {
+            readOk = false;
+            break;
+        }
+
+        uint32_t code = readInt32(record),
+                 size = readInt32(&record[4]) * readInt32(&record[8]);
+        int32_t height = readInt32(&record[4]),
+                dY = (int32_t)readInt32(&record[16]);
+
+        if (hasCode(pEntry->pCodes, pEntry->codeCount, code))
+        {
+            memcpy(pGlyphs[found].record, record, VLW_RECORD_SIZE);
+            pGlyphs[found++].offset = offset;
+            bitmapBytes += size;
+        }
+
+        //the characters TFT_eSPI measures the ascent and the descent with
+        if ((code > 0x20 && code < 0xA0 && code != 0x7F) || code > 0xFF)
+        {
+            if (dY > maxAscent)
+            {
+                maxAscent = dY;
+                memcpy(ascent.record, record, VLW_RECORD_SIZE);
+                ascent.offset = offset;
+            }
+            if (height - dY > maxDescent)
+            {
+                maxDescent = height - dY;
+                memcpy(descent.record, record, VLW_RECORD_SIZE);
+                descent.offset = offset;
+            }
+        }
+        offset += size;
+    }
+
+    //without these the subset would have a shorter line height than the font
+    DISPLAY_GLYPH *pExtra[2] = {maxAscent > -1 ? &ascent : NULL, maxDescent > -1 ? &descent : NULL};
+    for (int e = 0; e < 2 && readOk; e++)
+    {
+        if (pExtra[e] == NULL)
+            continue;
+        uint32_t code = readInt32(pExtra[e]->record);
+        bool present = false;
+        for (uint16_t i = 0; i < found && !present; i++)
+            present = readInt32(pGlyphs[i].record) == code;
+        if (present)
+            continue;
+
+        //kept in the order of the codes, the order of the file
+        uint16_t index = found;
+        while (index > 0 && readInt32(pGlyphs[index - 1].record) > code)
+        {
+            pGlyphs[index] = pGlyphs[index - 1];
+            index--;
+        }
+        pGlyphs[index] = *pExtra[e];
+        found++;
+        bitmapBytes += readInt32(&pExtra[e]->record[4]) * readInt32(&pExtra[e]->record[8]);
+    }
+
+    size_t bytes = VLW_HEADER_SIZE + ((size_t)found * VLW_RECORD_SIZE) + bitmapBytes;
+    makeRoom(bytes, pEntry);
+    uint8_t *pData = NULL;
+    if (readOk && _usedBytes + bytes <= _maxBytes)
+    {
+#if defined(ESP32)
+        pData = (uint8_t *)heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+#endif
+        if (pData == NULL)
+            pData = (uint8_t *)malloc(bytes);
+    }
+
+    if (pData)
+    {
+        memcpy(pData, header, VLW_HEADER_SIZE);
+        pData[0] = 0;
+        pData[1] = 0;
+        pData[2] = found >> 8;
+        pData[3] = found & 0xFF;
+
+        uint8_t *pBitmap = pData + VLW_HEADER_SIZE + ((size_t)found * VLW_RECORD_SIZE);
+        for (uint16_t i = 0; i < found && readOk; i++)
+        {
+            memcpy(pData + VLW_HEADER_SIZE + (i * VLW_RECORD_SIZE), pGlyphs[i].record, VLW_RECORD_SIZE);
+            size_t size = readInt32(&pGlyphs[i].record[4]) * readInt32(&pGlyphs[i].record[8]);
+            readOk = size == 0 || (file.seek(pGlyphs[i].offset) && file.read(pBitmap, size) == size);
+            pBitmap += size;
+        }
+
+        if (readOk)
+        {
+            pEntry->pData = pData;
+            pEntry->bytes = bytes;
+            _usedBytes += bytes;
+        }
+        else
+            free(pData);
+    }
+
+    delete[] pGlyphs;
+    file.close();
+    return pEntry->pData != NULL;
+}
+
+void DisplayGlyphCache::prepare(DisplayPage *pPage)
+{
+    DisplayMenu *pMenu = pPage ? pPage->getMenu() : NULL;
+    if (pMenu == NULL)
+        return;
+
+    int labelCount = pPage->labelCount(),
+        itemCount = labelCount + pPage->buttonCount();
+
+    //the glyphs are for the page being shown, fonts it does not use are dropped
+    for (int e = _size - 1; e >= 0; e--)
+    {
+        bool used = false;
+        for (int i = 0; i < itemCount && !used; i++)
+        {
+            DisplayFont *pFont = i < labelCount ? pPage->getLabel(i)->getFont() : pPage->getButton(i - labelCount)->getFont();
+            used = pMenu->resolveFont(pFont) == get(e)->pFont;
+        }
+        if (!used)
+            removeEntry(e);
+    }
+
+    for (int i = 0; i < itemCount; i++)
+    {
+        DisplayFont *pFont;
+        String text;
+        if (i < labelCount)
+        {
+            pFont = pPage->getLabel(i)->getFont();
+            text = pPage->getLabel(i)->getText();
+        }
+        else
+        {
+            pFont = pPage->getButton(i - labelCount)->getFont();
+            text = pPage->getButton(i - labelCount)->getText();
+        }
+
+        pFont = pMenu->resolveFont(pFont);
+        if (pFont->getFileSystem() == NULL)
+            continue;
+
+        int index = find(pFont);
+        addText(index < 0 ? addEntry(pFont) : get(index), text.c_str());
+    }
+
+    //each font file is read once for all the characters of the page
+    for (int i = 0; i < _size; i++)
+    {
+        if (get(i)->stale)
+            build(get(i));
+    }
+}
+
+const uint8_t *DisplayGlyphCache::getGlyphs(DisplayFont *pFont, const char *pText)
+{
+    if (pFont == NULL || pText == NULL || pFont->getFileSystem() == NULL)
+        return NULL;
+
+    int index = find(pFont);
+    DISPLAY_GLYPH_CACHE_ENTRY *pEntry = index < 0 ? addEntry(pFont) : get(index);
+    addText(pEntry, pText);
+    if (!pEntry->stale)
+    {
+        _hits++;
+        return pEntry->pData;
+    }
+
+    build(pEntry);
+    return pEntry->pData;
+}
@@ -0,0 +1,133 @@
+#ifndef DISPLAYGLYPHCACHE_H
+#define DISPLAYGLYPHCACHE_H
+
+#include <Arduino.h>
+
+#include "LinkedList.h"
+#include "DisplayFont.h"
+
+class DisplayPage;
+
+/**
+ * @brief Characters the glyph cache always keeps for every font, so values can change without reading the font file.
+ *
+ */
+#define DISPLAY_GLYPH_CACHE_ALWAYS "0123456789.,:-+% "
+
+/**
+ * @brief The glyphs of the characters used with one smooth font file.
+ *
+ */
+struct DISPLAY_GLYPH_CACHE_ENTRY {
+    DisplayFont *pFont;
+    uint16_t *pCodes;  //characters asked for, sorted, including characters the font does not have
+    uint16_t codeCount;
+    uint8_t *pData;    //the glyphs of those characters as a .vlw font, NULL if it could not be made
+    size_t bytes;
+    bool stale;        //characters were added since pData was made
+};
+
+/**
+ * @brief Keeps the glyphs of the characters used on the visable page, for smooth fonts loaded from files.
+ *
+ * TFT_eSPI reads every glyph it draws from the .vlw file when the font was loaded from a file system,
+ * so a keypad page reads the file hundreds of times each time it is drawn. This cache reads the glyph metrics
+ * and the alpha bitmaps of only the characters the page uses and puts them together as a small .vlw font in memory,
+ * in PSRAM when there is some. The menu loads that font instead of the file and nothing is read while drawing.
+ *
+ * When a page is shown the characters of it's buttons and labels are gathered, and glyphs of fonts the page
+ * does not use are dropped. A text with characters the cache has not seen, like a label given a new text,
+ * makes the cache read those glyphs once. Widgets draw texts the page does not know about, so they use the file.
+ */
+class DisplayGlyphCache : public LinkedList<DISPLAY_GLYPH_CACHE_ENTRY*>
+{
+private:
+    size_t _maxBytes;
+    size_t _usedBytes;
+    String _alwaysChars;
+    uint32_t _generation;
+    unsigned long _hits;
+    unsigned long _reads;
+
+    int find(DisplayFont *pFont);
+    DISPLAY_GLYPH_CACHE_ENTRY *addEntry(DisplayFont *pFont);
+    void removeEntry(int index);
+    void freeData(DISPLAY_GLYPH_CACHE_ENTRY *pEntry);
+    bool hasText(DISPLAY_GLYPH_CACHE_ENTRY *pEntry, const char *pText);
+
+    /**
+     * @brief Adds the characters of a text to the characters asked for
+     *
+     */
+    void addText(DISPLAY_GLYPH_CACHE_ENTRY *pEntry, const char *pText);
+
+    /**
+     * @brief Reads the glyphs of the characters asked for from the font file into a .vlw font in memory
+     *
+     */
+    bool build(DISPLAY_GLYPH_CACHE_ENTRY *pEntry);
+    void makeRoom(size_t bytes, DISPLAY_GLYPH_CACHE_ENTRY *pKeep);
+    static uint16_t decodeUtf8(const char *&pText);
+    static bool hasCode(const uint16_t *pCodes, uint16_t count, uint32_t code);
+    static uint32_t readInt32(const uint8_t *pBytes);
+
+    /**
+     * @brief The cleanup function used by the list's deconstructor;
+     *
+     */
+    void destory();
+
+public:
+    /**
+     * @brief Construct a new Display Glyph Cache object
+     *
+     * @param maxBytes Memory the glyphs of all fonts may use together
+     * @param alwaysChars Characters kept for every font, in UTF-8
+     */
+    DisplayGlyphCache(size_t maxBytes, const char *alwaysChars = DISPLAY_GLYPH_CACHE_ALWAYS);
+
+    /**
+     * @brief Reads the glyphs used by the buttons and labels of a page, and drops the glyphs of fonts it does not use
+     *
+     */
+    void prepare(DisplayPage *pPage);
+
+    /**
+     * @brief Get the glyphs for drawing a text with a font, reading glyphs not seen before from the file
+     *
+     * @return const uint8_t* A .vlw font to load with TFT_eSPI::loadFont, NULL if the font must be loaded from it's file
+     */
+    const uint8_t *getGlyphs(DisplayFont *pFont, const char *pText);
+
+    /**
+     * @brief A number which changes every time glyphs are freed, a font loaded from the cache
+     * must be loaded again when it has changed
+     *
+     */
+    uint32_t getGeneration() { return _generation; };
+
+    /**
+     * @brief Frees the glyphs of all fonts
+     *
+     */
+    void flush() { destory(); }
+
+    size_t getMaxBytes() { return _maxBytes; };
+    size_t getUsedBytes() { return _usedBytes; };
+
+    /**
+     * @brief How many times a text's glyphs were in memory
+     *
+     */
+    unsigned long getHits() { return _hits; };
+
+    /**
+     * @brief How many times glyphs were read from a font file
+     *
+     */
+    unsigned long getReads() { return _reads; };
+
+    virtual ~DisplayGlyphCache() { destory(); }
+};
+
+#endif
@@ -14,8 +14,9 @@ DisplayLabel::DisplayLabel(   TFT_eSPI *tft,
                                 DisplayPage *page
                                 )
 {
-
-    init(tft, x, y, width, height, outlineColor, fillColor, textColor, textsize, text, VISABLE, page, "", NULL, 0);
+    DisplayStyle *pStyle = DisplayStyle::get(outlineColor, fillColor, textColor, textsize, 0);
+    init(tft, x, y, width, height, pStyle, text, VISABLE, page, "", NULL, 0);
+    pStyle->release();
 }
 
 
@@ -34,19 +35,77 @@ DisplayLabel::DisplayLabel(   TFT_eSPI *tft,
                                 double incrementValue
                                 )
 {
-
-    init(tft, x, y, width, height, outlineColor, fillColor, textColor, textsize, text,  VISABLE, page, "", pLinkedValue, incrementValue);
+    DisplayStyle *pStyle = DisplayStyle::get(outlineColor, fillColor, textColor, textsize, 0);
+    init(tft, x, y, width, height, pStyle, text,  VISABLE, page, "", pLinkedValue, incrementValue);
+    pStyle->release();
 }
 
 // Copy constructor
 DisplayLabel::DisplayLabel(const DisplayLabel &label)
 {
     init(label._values.tft           , label._values.x              , label._values.y,
-         label._values.width         , label._values.height         , label._values.outlineColor,
-         label._values.fillColor     , label._values.textColor      , label._values.textsize,
+         label._values.width         , label._values.height         , label._values.pStyle,
          label._values.text.c_str()  , label._values.state          , label._values.pPage,
          label._values.linkedValueName, label._values.pLinkedValue  , label._values.incrementValue,
          label._values.textAlign);
+    _values.linkedValuePrecision = label._values.linkedValuePrecision;
+    _values.linkedValueTrimZeros = label._values.linkedValueTrimZeros;
+    _values.pBinding = label._values.pBinding;
+}
+
+DisplayLabel &DisplayLabel::operator=(const DisplayLabel &label)
+{
+    if (this == &label)
+        return *this;
+
+    label._values.pStyle->retain();
+    _values.pStyle->release();
+    _values = label._values;
+    _dTemp = label._dTemp;
+    _occluded = label._occluded;
+    _drawnTextX = label._drawnTextX;
+    _drawnTextWidth = label._drawnTextWidth;
+    _currentState = label._currentState;
+    _lastState = label._lastState;
+    return *this;
+}
+
+DisplayLabel::~DisplayLabel()
+{
+    _values.pStyle->release();
+}
+
+void DisplayLabel::setStyle(DisplayStyle *pStyle)
+{
+    if (pStyle == NULL || pStyle == _values.pStyle)
+        return;
+
+    pStyle->retain();
+    _values.pStyle->release();
+    _values.pStyle = pStyle;
+}
+
+void DisplayLabel::setColors(uint16_t outlineColor, uint16_t fillColor, uint16_t textColor)
+{
+    DisplayStyle *pStyle = DisplayStyle::get(outlineColor, fillColor, textColor, _values.pStyle->getTextSize(), _values.pStyle->getRadius(), _values.pStyle->getFont());
+    setStyle(pStyle);
+    pStyle->release();
+}
+
+void DisplayLabel::setRadius(uint8_t radius)
+{
+    DisplayStyle *pStyle = _values.pStyle;
+    pStyle = DisplayStyle::get(pStyle->getOutlineColor(), pStyle->getFillColor(), pStyle->getTextColor(), pStyle->getTextSize(), radius, pStyle->getFont());
+    setStyle(pStyle);
+    pStyle->release();
+}
+
+void DisplayLabel::setFont(DisplayFont *pFont)
+{
+    DisplayStyle *pStyle = _values.pStyle;
+    pStyle = DisplayStyle::get(pStyle->getOutlineColor(), pStyle->getFillColor(), pStyle->getTextColor(), pStyle->getTextSize(), pStyle->getRadius(), pFont);
+    setStyle(pStyle);
+    pStyle->release();
 }
 
 void DisplayLabel::init(   TFT_eSPI *tft, 
@@ -54,10 +113,7 @@ void DisplayLabel::init(   TFT_eSPI *tft,
                             int16_t y, 
                             uint16_t width,
                             uint16_t height,
-                            uint16_t outlineColor,
-                            uint16_t fillColor,
-                            uint16_t textColor,
-                            uint8_t textsize,
+                            DisplayStyle *pStyle,
                             const char *text, 
                             DisplayState state,
                             DisplayPage *page,
@@ -73,23 +129,26 @@ void DisplayLabel::init(   TFT_eSPI *tft,
     _values.y = y;
     _values.width = width;
     _values.height = height;
-    _values.outlineColor = outlineColor;
-    _values.fillColor = fillColor;
-    _values.textColor = textColor;
-    _values.textsize = textsize;
+    _values.pStyle = pStyle;
+    pStyle->retain();
     _values.text = text;
     _values.state = state;
     _values.pPage = page;
     _values.linkedValueName = linkedValueName;
     _values.pLinkedValue = pLinkedValue;
     _values.incrementValue = incrementValue;
+    _values.pBinding = NULL;
 
     //defaults
-    _values.radius = 0;
+    _occluded = false;
+    _drawnTextX = 0;
+    _drawnTextWidth = -1;
+    _values.linkedValuePrecision = -1;
+    _values.linkedValueTrimZeros = true;
     _values.textAlign = textAlign;
     _values.xDatumOffset = 0;
     _values.yDatumOffset = -4;
-    _values.onDrawDisplayLabel = NULL;
+    _values.onDrawDisplayLabel = DisplayLabelDelegate();
 }
 
 void DisplayLabel::resetPressState () {
@@ -103,50 +162,44 @@ void DisplayLabel::draw(bool inverted, bool cancelDrawIfPageIsNotVisable)
         return;
     }
 
+    DisplayMenu *pMenu = getPage() ? getPage()->getMenu() : NULL;
     if (cancelDrawIfPageIsNotVisable)
     {
-        DisplayPage *pPage = getPage();
-        if (pPage)
-        {
-            DisplayMenu *pMenu = pPage->getMenu();
-            if (pMenu && pPage != pMenu->getVisablePage())
-                return;
-        }
+        if (pMenu && (getPage() != pMenu->getVisablePage() || pMenu->isAsleep()))
+            return;
     }
 
     if (_values.onDrawDisplayLabel)
+    {
         _values.onDrawDisplayLabel(this);
+        //the draw function may have changed the font
+        if (pMenu)
+            pMenu->forgetFont();
+    }
 
+    DisplayStyle *pStyle = _values.pStyle;
     uint16_t fillColor, outlineColor, textColor;
     if (!inverted)
     {
-        fillColor = _values.fillColor;
-        outlineColor = _values.outlineColor;
-        textColor = _values.textColor;
+        fillColor = pStyle->getFillColor();
+        outlineColor = pStyle->getOutlineColor();
+        textColor = pStyle->getTextColor();
     }
     else
     {
-        fillColor = _values.textColor;
-        outlineColor = _values.outlineColor;
-        textColor = _values.fillColor;
+        fillColor = pStyle->getTextColor();
+        outlineColor = pStyle->getOutlineColor();
+        textColor = pStyle->getFillColor();
     }
+    uint8_t radius = getRadius();
 
     int32_t x, xText, y, yText;
-    x = xText = _values.x;
-    y = yText = _values.y;
+    x = _values.x;
+    y = _values.y;
         
-    //X calc
-    int16_t textWidth = _values.tft->textWidth(_values.text);
-    if (_values.textAlign == ALIGN_CENTER)
-    {
-        xText = _values.x + ((_values.width - textWidth) / 2) + _values.xDatumOffset;
-    } else if (_values.textAlign == ALIGN_RIGHT)
-    {
-        xText = x + (_values.width - textWidth) - _values.xDatumOffset;
-    } 
-
-    //Y calc
-    yText = _values.y + (_values.height / 2) + _values.yDatumOffset;
+    char valueText[DISPLAY_NUMBER_TEXT_SIZE];
+    const char *pText = getDrawnText(valueText, sizeof(valueText));
+    bool drawLinkedValue = showsValue();
 
     uint16_t before_color = _values.tft->textcolor;
     uint8_t  before_textSize = _values.tft->textsize;
@@ -154,15 +207,36 @@ void DisplayLabel::draw(bool inverted, bool cancelDrawIfPageIsNotVisable)
     uint8_t  before_textPadding = _values.tft->getTextPadding();
 
     _values.tft->setTextColor(textColor);
-    _values.tft->setTextSize(_values.textsize);
+    _values.tft->setTextSize(pStyle->getTextSize());
     //Going to calculate everything from ML
     _values.tft->setTextDatum(ML_DATUM);
     _values.tft->setTextPadding(0);
+    if (pMenu)
+        pMenu->selectFont(_values.tft, pStyle->getFont(), pText);
+
+    //the text is measured with the label's font and size
+    int16_t textWidth = _values.tft->textWidth(pText);
+    xText = getTextX(textWidth);
+    yText = _values.y + (_values.height / 2) + _values.yDatumOffset;
+
+    _values.tft->fillRoundRect(x, y, _values.width, _values.height, radius, fillColor);
+    _values.tft->drawRoundRect(x, y, _values.width, _values.height, radius, outlineColor);
 
-    _values.tft->fillRoundRect(x, y, _values.width, _values.height, _values.radius, fillColor);
-    _values.tft->drawRoundRect(x, y, _values.width, _values.height, _values.radius, outlineColor);
+    DisplayTextCache *pTextCache = pMenu ? pMenu->getTextCache() : NULL;
+    //the cache pushes it's sprites to the menu display, not to a page being drawn ahead of time
+    if (pTextCache && pTextCache->getDisplay() != _values.tft)
+        pTextCache = NULL;
+    //text drawn from cache must stay clear of the rounded corners and the outline
+    DisplayRect textBounds = getTextBounds();
+    //the cache renders GFX fonts only
+    const GFXfont *pGfxFont = pMenu ? pMenu->resolveFont(pStyle->getFont())->getGfxFont() : NULL;
+    //linked values change all the time, caching them would only push the static texts out
+    if (drawLinkedValue || !pTextCache || !pGfxFont || !pTextCache->drawString(pGfxFont, _values.text, xText, yText, textColor, fillColor, textBounds))
+        _values.tft->drawString(pText, xText, yText);
 
-    _values.tft->drawString(_values.text, xText, yText);
+    //drawValue paints only over this text, which it can not do over inverted colors
+    _drawnTextX = xText;
+    _drawnTextWidth = inverted ? -1 : textWidth;
 
     _values.tft->setTextColor(before_color);
     _values.tft->setTextSize(before_textSize);
@@ -171,11 +245,105 @@ void DisplayLabel::draw(bool inverted, bool cancelDrawIfPageIsNotVisable)
 
 }
 
+void DisplayLabel::drawValue()
+{
+    if (_values.state == HIDDEN)
+        return;
+
+    DisplayMenu *pMenu = getPage() ? getPage()->getMenu() : NULL;
+    if (pMenu && (getPage() != pMenu->getVisablePage() || pMenu->isAsleep() || getPage()->deferValueDraw()))
+        return;
+
+    //a draw function may paint under the text, so the label is drawn as a whole
+    if (!showsValue() || _drawnTextWidth < 0 || _values.onDrawDisplayLabel)
+    {
+        draw();
+        return;
+    }
+
+    DisplayStyle *pStyle = _values.pStyle;
+    char valueText[DISPLAY_NUMBER_TEXT_SIZE];
+    const char *pText = getDrawnText(valueText, sizeof(valueText));
+
+    uint16_t before_color = _values.tft->textcolor;
+    uint8_t  before_textSize = _values.tft->textsize;
+    uint8_t  before_textDatum = _values.tft->getTextDatum();
+    uint8_t  before_textPadding = _values.tft->getTextPadding();
+
+    _values.tft->setTextColor(pStyle->getTextColor());
+    _values.tft->setTextSize(pStyle->getTextSize());
+    _values.tft->setTextDatum(ML_DATUM);
+    _values.tft->setTextPadding(0);
+    if (pMenu)
+        pMenu->selectFont(_values.tft, pStyle->getFont(), pText);
+
+    int16_t textWidth = _values.tft->textWidth(pText);
+    int32_t xText = getTextX(textWidth),
+            yText = _values.y + (_values.height / 2) + _values.yDatumOffset;
+
+    //the old and the new text must both lie on the plain fill, clear of the rounded corners and the outline
+    DisplayRect bounds = getTextBounds();
+    int32_t left = min(xText, (int32_t)_drawnTextX),
+            right = max(xText + textWidth, (int32_t)(_drawnTextX + _drawnTextWidth));
+    bool fits = left >= bounds.x && right <= bounds.right();
+    if (fits)
+    {
+        _values.tft->fillRect(left, bounds.y, right - left, bounds.height, pStyle->getFillColor());
+        _values.tft->drawString(pText, xText, yText);
+        _drawnTextX = xText;
+        _drawnTextWidth = textWidth;
+    }
+
+    _values.tft->setTextColor(before_color);
+    _values.tft->setTextSize(before_textSize);
+    _values.tft->setTextDatum(before_textDatum);
+    _values.tft->setTextPadding(before_textPadding);
+
+    if (!fits)
+        draw();
+}
+
+const char *DisplayLabel::getDrawnText(char *buffer, size_t size)
+{
+    if (showsBinding())
+    {
+        _values.pBinding->format(buffer, size);
+        return buffer;
+    }
+    if (showsValue())
+    {
+        DisplayNumberFormat::format(buffer, size, *_values.pLinkedValue, _values.linkedValuePrecision, _values.linkedValueTrimZeros);
+        return buffer;
+    }
+    return _values.text.c_str();
+}
+
+int32_t DisplayLabel::getTextX(int16_t textWidth)
+{
+    if (_values.textAlign == ALIGN_CENTER)
+        return _values.x + ((_values.width - textWidth) / 2) + _values.xDatumOffset;
+    if (_values.textAlign == ALIGN_RIGHT)
+        return _values.x + (_values.width - textWidth) - _values.xDatumOffset;
+    return _values.x;
+}
+
+DisplayRect DisplayLabel::getTextBounds()
+{
+    uint8_t inset = max((uint8_t)1, getRadius());
+    return DisplayRect(_values.x + inset, _values.y + 1, _values.width - (2 * inset), _values.height - 2);
+}
+
 void DisplayLabel::setLinkToValue(double *pLinkedValue, String valueName) { 
     _values.pLinkedValue = pLinkedValue; 
     _values.linkedValueName = valueName; 
 };
 
+void DisplayLabel::setLinkedValueFormat(int8_t precision, bool trimZeros)
+{
+    _values.linkedValuePrecision = min(precision, (int8_t)DISPLAY_NUMBER_MAX_PRECISION);
+    _values.linkedValueTrimZeros = trimZeros;
+}
+
 void DisplayLabel::setText(String newText, bool drawScreenNow)
 {
     _values.text = newText;
@@ -11,11 +11,23 @@
 #include <TFT_eSPI.h>
 
 #include "DisplayGlobals.h"
+#include "DisplayRect.h"
+#include "DisplayNumberFormat.h"
+#include "DisplayDelegate.h"
+#include "DisplayMemory.h"
+#include "DisplayStyle.h"
+#include "DisplayValue.h"
 
 class DisplayLabel;
 
 typedef void (*OnDrawDisplayLabel) (DisplayLabel *ptrLabel);
 
+/**
+ * @brief A label event, a function taking the label, which can also carry a context pointer or call a member function.
+ * OnDrawDisplayLabel functions convert to it.
+ */
+typedef DisplayDelegate<DisplayLabel *> DisplayLabelDelegate;
+
 class DisplayPage;
 
 struct DISPLAY_LABEL_VALUES {
@@ -26,34 +38,48 @@ struct DISPLAY_LABEL_VALUES {
     int16_t yDatumOffset;
     uint16_t width;
     uint16_t height;
-    uint16_t outlineColor;
-    uint16_t fillColor;
-    uint16_t textColor;
-    uint8_t textsize;
+    DisplayStyle *pStyle;
     TextAlign textAlign;
-    uint8_t radius;
     String text;
     DisplayState state;
     DisplayPage *pPage;
     double *pLinkedValue;
     String linkedValueName;
+    int8_t linkedValuePrecision;
+    bool linkedValueTrimZeros;
     double incrementValue;
-    OnDrawDisplayLabel onDrawDisplayLabel;
+    DisplayValue *pBinding;
+    DisplayLabelDelegate onDrawDisplayLabel;
 }; 
 
 class DisplayLabel
 {
 private:
     double _dTemp;
+    bool _occluded;
+
+    //where the text was last drawn, for drawValue, the width is -1 when the whole label must be drawn
+    int16_t _drawnTextX;
+    int16_t _drawnTextWidth;
+
+    /**
+     * @brief The text the label shows, the value formatted into the buffer or the label text
+     * 
+     */
+    const char *getDrawnText(char *buffer, size_t size);
+    int32_t getTextX(int16_t textWidth);
+
+    /**
+     * @brief The part of the label inside the outline and clear of the rounded corners
+     * 
+     */
+    DisplayRect getTextBounds();
     void init(  TFT_eSPI *tft, 
                 int16_t x, 
                 int16_t y, 
                 uint16_t width,
                 uint16_t height,
-                uint16_t outlineColor,
-                uint16_t fillColor,
-                uint16_t textColor,
-                uint8_t textsize,
+                DisplayStyle *pStyle,
                 const char *text,
                 DisplayState state,
                 DisplayPage *page,
@@ -63,6 +89,7 @@ private:
                 TextAlign textAlign = ALIGN_LEFT
                 );
 public:
+    DISPLAY_MEMORY_TRACKED
     bool  _currentState, 
           _lastState; 
     String getText() { return _values.text; };
@@ -78,6 +105,30 @@ public:
     void setLinkToValue(double *pLinkedValue, String valueName);
     
     double *getLinkedValue() { return _values.pLinkedValue; };
+
+    /**
+     * @brief Draw the linked value instead of the label text.  The value is formatted 
+     * into a buffer on the stack every time the label is drawn so no heap memory is used.
+     * 
+     * @param precision Number of decimals to show. Pass -1 to draw the label text again.
+     * @param trimZeros Should ending zeros in the decimals be removed
+     */
+    void setLinkedValueFormat(int8_t precision, bool trimZeros = true);
+
+    /**
+     * @brief Bind the label to a typed variable, the label draws the variable instead of it's text
+     * 
+     * @param pBinding The binding, it must exist for as long as the label does. NULL removes the binding.
+     */
+    void setBinding(DisplayValue *pBinding) { _values.pBinding = pBinding; };
+    DisplayValue *getBinding() { return _values.pBinding; };
+    bool showsBinding() { return _values.pBinding != NULL; };
+
+    /**
+     * @brief Does the label draw a value, which can change without the label being changed
+     * 
+     */
+    bool showsValue() { return showsBinding() || (_values.pLinkedValue && _values.linkedValuePrecision > -1); };
     String getLinkedValueName() { return _values.linkedValueName; };
     void setTextAlign(TextAlign textAlign, int16_t xDatumOffset = 0, int16_t yDatumOffset = 0);
     void setState(DisplayState state) { _values.state = state; };
@@ -87,6 +138,45 @@ public:
     DISPLAY_LABEL_VALUES getValues() { return _values; };
 
     DisplayLabel(const DisplayLabel &label);
+    DisplayLabel &operator=(const DisplayLabel &label);
+    ~DisplayLabel();
+
+    /**
+     * @brief Get the style which decides the colors, text size and corners of the label
+     * 
+     */
+    DisplayStyle *getStyle() { return _values.pStyle; };
+
+    /**
+     * @brief Make the label look like the given style, the label keeps a reference to it.
+     * 
+     */
+    void setStyle(DisplayStyle *pStyle);
+
+    /**
+     * @brief Changes the colors of only this label, it gets a style of it's own or one shared with labels of the same colors
+     * 
+     */
+    void setColors(uint16_t outlineColor, uint16_t fillColor, uint16_t textColor);
+    void setRadius(uint8_t radius);
+    uint8_t getRadius() { return _values.pStyle->getRadius(_values.width, _values.height); };
+
+    /**
+     * @brief The colors and text size the label is drawn with, read from it's style.
+     * They replace the fields of the same names which were in the values before styles.
+     * 
+     */
+    uint16_t getOutlineColor() { return _values.pStyle->getOutlineColor(); };
+    uint16_t getFillColor() { return _values.pStyle->getFillColor(); };
+    uint16_t getTextColor() { return _values.pStyle->getTextColor(); };
+    uint8_t getTextSize() { return _values.pStyle->getTextSize(); };
+
+    /**
+     * @brief Draws the text of only this label with a font, NULL uses the menu font
+     * 
+     */
+    void setFont(DisplayFont *pFont);
+    DisplayFont *getFont() { return _values.pStyle->getFont(); };
     
     DisplayLabel(  TFT_eSPI *tft, 
                     int16_t x, 
@@ -125,11 +215,37 @@ public:
      * Node if you need more speed this variable should be false;
      */
     void draw(bool inverted=false,  bool checkIfPageIsVisable = true);
-    void registerOnDrawEvent(OnDrawDisplayLabel pOnDrawDisplayLabel) {
+
+    /**
+     * @brief Draws a changed value over the value drawn before, only the box covering the old and the new text is painted,
+     * the rounded rect and the outline are not drawn again.
+     * The whole label is drawn if it has not been drawn yet, the text no longer fits inside the outline and the corners,
+     * the label has a draw function or it does not show a value.
+     * 
+     * @code .cpp
+     * temperature = readTemperature();
+     * pTemperatureLabel->drawValue();
+     * @endcode
+     */
+    void drawValue();
+    void registerOnDrawEvent(DisplayLabelDelegate pOnDrawDisplayLabel) {
         _values.onDrawDisplayLabel = pOnDrawDisplayLabel;
     }
 
     DisplayPage *getPage() { return _values.pPage; }
+
+    /**
+     * @brief Get the area this label covers on the screen
+     * 
+     */
+    DisplayRect getRect() { return DisplayRect(_values.x, _values.y, _values.width, _values.height); }
+
+    /**
+     * @brief Is this label completely covered by other opaque items on the page.
+     * Set by the page every time it is drawn, covered items are not drawn.
+     */
+    bool isOccluded() { return _occluded; }
+    void setOccluded(bool occluded) { _occluded = occluded; }
 };
 
 
@@ -1,5 +1,11 @@
 #include "DisplayLabelList.h"
 bool DisplayLabelList::add(DisplayLabel button) {
+    if (_pool.size() > 0)
+    {
+        DisplayLabel *p = _pool.pop();
+        *p = button;
+        return LinkedList<DisplayLabel*>::add(p);
+    }
     return LinkedList<DisplayLabel*>::add(new DisplayLabel(button));
 }
 
@@ -14,16 +20,30 @@ DisplayLabel *DisplayLabelList::findButtonByText(String text) {
     return NULL;
 }
 
+void DisplayLabelList::recycle(DisplayLabel *pLabel) {
+    if (_pool.size() < _poolSize)
+        _pool.add(pLabel);
+    else
+        delete pLabel;
+}
+
+bool DisplayLabelList::remove(DisplayLabel *pLabel) {
+    int index = indexOf(pLabel);
+    if (index < 0)
+        return false;
+
+    recycle(LinkedList<DisplayLabel*>::remove(index));
+    return true;
+}
+
+void DisplayLabelList::setPoolSize(uint16_t poolSize) {
+    _poolSize = poolSize;
+    while (_pool.size() > _poolSize)
+        delete _pool.pop();
+}
+
 void DisplayLabelList::destory() {
-    DisplayLabel* p;
-    for (int i = 0; i < size(); i++) {
-        p = get(i);
-        if (p != NULL)
-        {
-            delay(10);
-            delete p;
-            set(i, NULL);
-        }
-    }
-    clear();
-}
\ No newline at end of file
+    //items are taken from the front, so no item has to be searched for
+    while (size() > 0)
+        recycle(shift());
+}
@@ -8,6 +8,14 @@
 class DisplayLabelList : public LinkedList<DisplayLabel*> {
 
 private:
+    LinkedList<DisplayLabel*> _pool;
+    uint16_t _poolSize = 0;
+
+    /**
+     * @brief Keeps a removed item for reuse if the pool has room, otherwise deletes it
+     * 
+     */
+    void recycle(DisplayLabel *pLabel);
     
     /**
      * @brief The cleanup function used by the list's deconstructor;
@@ -33,8 +41,28 @@ public:
      */
     int count() { return size(); };
 
+    /**
+     * @brief Deletes all labels in the list and empties it
+     * 
+     */
+    void removeAll() { destory(); };
+
+    /**
+     * @brief Removes one label from the list and deletes it, or keeps it in the pool
+     * 
+     * @return true if the label was in the list
+     */
+    bool remove(DisplayLabel *pLabel);
+
+    /**
+     * @brief Set how many removed labels are kept to be reused by add, instead of being deleted and allocated again
+     * 
+     */
+    void setPoolSize(uint16_t poolSize);
+    int poolCount() { return _pool.size(); };
+
     
-    ~DisplayLabelList() { destory(); }
+    ~DisplayLabelList() { destory(); setPoolSize(0); }
     
 };
 
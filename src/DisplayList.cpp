@@ -0,0 +1,365 @@
+#include "DisplayList.h"
+#include "DisplayMenu.h"
+
+//ILI9341 commands for the vertical scroll area
+#define DISPLAY_LIST_VSCRDEF 0x33
+#define DISPLAY_LIST_VSCRSADD 0x37
+
+DisplayList::DisplayList(TFT_eSPI *tft,
+                         DisplayPage *page,
+                         int16_t x,
+                         int16_t y,
+                         uint16_t width,
+                         uint16_t height,
+                         uint16_t rowHeight,
+                         uint16_t fillColor,
+                         uint16_t textColor,
+                         uint16_t lineColor,
+                         uint8_t textsize) : DisplayWidget(tft, page, x, y, width, height)
+{
+    _rowHeight = max((uint16_t)1, rowHeight);
+    _fillColor = fillColor;
+    _textColor = textColor;
+    _lineColor = lineColor;
+    _selectedFillColor = textColor;
+    _selectedTextColor = fillColor;
+    _textsize = textsize;
+    _rowCount = 0;
+    _selected = -1;
+    _scroll = 0;
+    _hardwareScroll = true;
+    _hardwareScrolling = false;
+    _hardwareOffset = 0;
+    _touching = false;
+    _dragging = false;
+    _touchStartY = 0;
+    _touchStartScroll = 0;
+
+    //one row more than fits, for the rows cut at the top and the bottom while scrolling
+    _rowSlots = (height / _rowHeight) + 2;
+    _pRows = new DISPLAY_LIST_ROW[_rowSlots];
+    for (int i = 0; i < _rowSlots; i++)
+        _pRows[i].index = -1;
+}
+
+DisplayList::~DisplayList()
+{
+    if (_hardwareScrolling)
+        resetHardwareScroll();
+    delete[] _pRows;
+}
+
+void DisplayList::registerOnGetRowEvent(DisplayListRowDelegate pOnGetDisplayListRow)
+{
+    _onGetDisplayListRow = pOnGetDisplayListRow;
+    for (int i = 0; i < _rowSlots; i++)
+        _pRows[i].index = -1;
+}
+
+void DisplayList::setRowCount(int rowCount)
+{
+    _rowCount = max(0, rowCount);
+    for (int i = 0; i < _rowSlots; i++)
+        _pRows[i].index = -1;
+
+    if (_selected >= _rowCount)
+        _selected = -1;
+
+    _scroll = min(_scroll, maxScroll());
+    draw();
+}
+
+DISPLAY_LIST_ROW *DisplayList::getRow(int index)
+{
+    //consecutive rows never share a slot, so every row on the screen has it's own
+    DISPLAY_LIST_ROW *pRow = &_pRows[index % _rowSlots];
+    if (pRow->index != index)
+    {
+        pRow->index = index;
+        pRow->text[0] = '\0';
+        if (_onGetDisplayListRow)
+            _onGetDisplayListRow(this, index, pRow->text, DISPLAY_LIST_TEXT_SIZE);
+        pRow->text[DISPLAY_LIST_TEXT_SIZE - 1] = '\0';
+    }
+    return pRow;
+}
+
+int32_t DisplayList::maxScroll()
+{
+    int32_t contentHeight = (int32_t)_rowCount * _rowHeight;
+    return max((int32_t)0, contentHeight - _rect.height);
+}
+
+void DisplayList::refreshRow(int index)
+{
+    if (index < 0 || index >= _rowCount)
+        return;
+
+    DISPLAY_LIST_ROW *pRow = &_pRows[index % _rowSlots];
+    if (pRow->index == index)
+        pRow->index = -1;
+
+    if (!isPageVisable() || _occluded)
+        return;
+
+    int32_t top = ((int32_t)index * _rowHeight) - _scroll,
+            bottom = top + _rowHeight;
+    top = max(top, (int32_t)0);
+    bottom = min(bottom, (int32_t)_rect.height);
+    if (top < bottom)
+        drawLines(top, bottom - top);
+}
+
+void DisplayList::setSelected(int index)
+{
+    if (index >= _rowCount)
+        index = -1;
+
+    int before = _selected;
+    _selected = index;
+    if (before != index)
+    {
+        refreshRow(before);
+        refreshRow(index);
+    }
+}
+
+void DisplayList::setSelectedColors(uint16_t fillColor, uint16_t textColor)
+{
+    _selectedFillColor = fillColor;
+    _selectedTextColor = textColor;
+}
+
+void DisplayList::scrollToRow(int index)
+{
+    if (index < 0 || index >= _rowCount)
+        return;
+
+    int32_t top = (int32_t)index * _rowHeight;
+    if (top < _scroll)
+        scrollTo(top);
+    else if (top + _rowHeight > _scroll + _rect.height)
+        scrollTo(top + _rowHeight - _rect.height);
+}
+
+void DisplayList::scrollTo(int32_t position)
+{
+    position = constrain(position, (int32_t)0, maxScroll());
+    int32_t distance = position - _scroll;
+    if (distance == 0)
+        return;
+
+    _scroll = position;
+    if (!isPageVisable() || _occluded)
+        return;
+
+    if (_hardwareScrolling && abs(distance) < _rect.height)
+    {
+        //the display moves the rows already drawn, only the lines scrolled into view are drawn
+        _hardwareOffset = (((_hardwareOffset + distance) % _rect.height) + _rect.height) % _rect.height;
+        writeScrollStart(_rect.y + _hardwareOffset);
+        if (distance > 0)
+            drawLines(_rect.height - distance, distance);
+        else
+            drawLines(0, -distance);
+        return;
+    }
+
+    drawLines(0, _rect.height);
+}
+
+void DisplayList::setHardwareScroll(bool allow)
+{
+    _hardwareScroll = allow;
+    if (!allow && _hardwareScrolling)
+    {
+        resetHardwareScroll();
+        draw();
+    }
+}
+
+bool DisplayList::canScrollInHardware()
+{
+#if defined(ILI9341_DRIVER) || defined(ILI9341_2_DRIVER)
+    //the scroll area is made of whole lines of the display memory, which are only rows of the screen in rotation 0
+    return _hardwareScroll && _tft->getRotation() == 0 && _rect.x == 0 && _rect.width == _tft->width() &&
+           _rect.y >= 0 && _rect.bottom() <= _tft->height();
+#else
+    return false;
+#endif
+}
+
+void DisplayList::writeScrollStart(uint16_t line)
+{
+    _tft->writecommand(DISPLAY_LIST_VSCRSADD);
+    _tft->writedata(line >> 8);
+    _tft->writedata(line & 0xFF);
+}
+
+void DisplayList::setupHardwareScroll()
+{
+    uint16_t top = _rect.y,
+             area = _rect.height,
+             bottom = _tft->height() - _rect.bottom();
+
+    _tft->writecommand(DISPLAY_LIST_VSCRDEF);
+    _tft->writedata(top >> 8);
+    _tft->writedata(top & 0xFF);
+    _tft->writedata(area >> 8);
+    _tft->writedata(area & 0xFF);
+    _tft->writedata(bottom >> 8);
+    _tft->writedata(bottom & 0xFF);
+    writeScrollStart(_rect.y + _hardwareOffset);
+    _hardwareScrolling = true;
+}
+
+void DisplayList::resetHardwareScroll()
+{
+    uint16_t height = _tft->height();
+    _tft->writecommand(DISPLAY_LIST_VSCRDEF);
+    _tft->writedata(0);
+    _tft->writedata(0);
+    _tft->writedata(height >> 8);
+    _tft->writedata(height & 0xFF);
+    _tft->writedata(0);
+    _tft->writedata(0);
+    writeScrollStart(0);
+    _hardwareOffset = 0;
+    _hardwareScrolling = false;
+}
+
+void DisplayList::drawLines(int16_t firstLine, int16_t lineCount)
+{
+    if (!_hardwareScrolling)
+    {
+        drawSegment(_scroll + firstLine, _rect.y + firstLine, lineCount);
+        return;
+    }
+
+    //the lines are drawn where the display memory will show them, which wraps around the end of the scroll area
+    int16_t memoryLine = (firstLine + _hardwareOffset) % _rect.height;
+    int16_t beforeWrap = min(lineCount, (int16_t)(_rect.height - memoryLine));
+    drawSegment(_scroll + firstLine, _rect.y + memoryLine, beforeWrap);
+    if (lineCount > beforeWrap)
+        drawSegment(_scroll + firstLine + beforeWrap, _rect.y, lineCount - beforeWrap);
+}
+
+void DisplayList::drawSegment(int32_t contentY, int16_t screenY, int16_t lineCount)
+{
+    if (lineCount < 1)
+        return;
+
+    uint16_t before_color = _tft->textcolor;
+    uint8_t  before_textSize = _tft->textsize;
+    uint8_t  before_textDatum = _tft->getTextDatum();
+    uint8_t  before_textPadding = _tft->getTextPadding();
+
+    selectFont();
+    _tft->setTextSize(_textsize);
+    _tft->setTextDatum(ML_DATUM);
+    _tft->setTextPadding(0);
+
+    //the viewport clips the rows cut by the segment and makes y relative to the segment
+    _tft->setViewport(_rect.x, screenY, _rect.width, lineCount);
+    int first = contentY / _rowHeight,
+        last = (contentY + lineCount - 1) / _rowHeight;
+    for (int index = first; index <= last; index++)
+    {
+        int32_t top = ((int32_t)index * _rowHeight) - contentY;
+        if (index >= _rowCount)
+        {
+            _tft->fillRect(0, top, _rect.width, _rowHeight, _fillColor);
+            continue;
+        }
+
+        DISPLAY_LIST_ROW *pRow = getRow(index);
+        bool selected = index == _selected;
+        _tft->fillRect(0, top, _rect.width, _rowHeight - 1, selected ? _selectedFillColor : _fillColor);
+        _tft->drawFastHLine(0, top + _rowHeight - 1, _rect.width, _lineColor);
+        _tft->setTextColor(selected ? _selectedTextColor : _textColor);
+        _tft->drawString(pRow->text, 4, top + (_rowHeight / 2));
+    }
+    _tft->resetViewport();
+
+    _tft->setTextColor(before_color);
+    _tft->setTextSize(before_textSize);
+    _tft->setTextDatum(before_textDatum);
+    _tft->setTextPadding(before_textPadding);
+}
+
+int DisplayList::rowAt(int16_t x, int16_t y)
+{
+    if (!_rect.contains(DisplayRect(x, y, 1, 1)))
+        return -1;
+
+    int index = (_scroll + (y - _rect.y)) / _rowHeight;
+    return index < _rowCount ? index : -1;
+}
+
+void DisplayList::draw()
+{
+    if (!isPageVisable())
+        return;
+
+    if (canScrollInHardware())
+    {
+        _hardwareOffset = 0;
+        setupHardwareScroll();
+    }
+    else if (_hardwareScrolling)
+    {
+        resetHardwareScroll();
+    }
+
+    drawLines(0, _rect.height);
+}
+
+bool DisplayList::touch(uint16_t x, uint16_t y, bool pressed)
+{
+    if (!pressed)
+    {
+        if (!_touching)
+            return false;
+
+        _touching = false;
+        if (!_dragging)
+        {
+            int index = rowAt(x, _touchStartY);
+            if (index > -1)
+            {
+                setSelected(index);
+                if (_onSelectDisplayListRow)
+                    _onSelectDisplayListRow(this, index);
+            }
+        }
+        return true;
+    }
+
+    if (!_touching)
+    {
+        if (_state == HIDDEN || !_rect.contains(DisplayRect(x, y, 1, 1)))
+            return false;
+
+        _touching = true;
+        _dragging = false;
+        _touchStartY = y;
+        _touchStartScroll = _scroll;
+        return true;
+    }
+
+    if (!_dragging && abs((int16_t)y - _touchStartY) >= DISPLAY_LIST_DRAG_THRESHOLD)
+        _dragging = true;
+
+    if (_dragging)
+        scrollTo(_touchStartScroll + (_touchStartY - (int16_t)y));
+
+    return true;
+}
+
+void DisplayList::pageHidden()
+{
+    _touching = false;
+    //the next page is drawn as if the display memory was not scrolled
+    if (_hardwareScrolling)
+        resetHardwareScroll();
+}
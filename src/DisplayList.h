@@ -0,0 +1,199 @@
+#ifndef DISPLAYLIST_H
+#define DISPLAYLIST_H
+
+#include <Arduino.h>
+
+#include <TFT_eSPI.h>
+
+#include "DisplayWidget.h"
+#include "DisplayDelegate.h"
+
+/**
+ * @brief Size of the text buffer of one list row, including the terminating zero.
+ *
+ */
+#define DISPLAY_LIST_TEXT_SIZE 40
+
+/**
+ * @brief How far a touch must move before it scrolls the list instead of selecting a row
+ *
+ */
+#define DISPLAY_LIST_DRAG_THRESHOLD 8
+
+class DisplayList;
+
+/**
+ * @brief Writes the text of one row of a list into a buffer
+ *
+ */
+typedef void (*OnGetDisplayListRow)(DisplayList *pList, int index, char *text, size_t size);
+
+/**
+ * @brief An OnGetDisplayListRow event which can also carry a context pointer or call a member function
+ *
+ */
+typedef DisplayDelegate<DisplayList *, int, char *, size_t> DisplayListRowDelegate;
+
+/**
+ * @brief Called when a row of a list is tapped
+ *
+ */
+typedef void (*OnSelectDisplayListRow)(DisplayList *pList, int index);
+
+/**
+ * @brief An OnSelectDisplayListRow event which can also carry a context pointer or call a member function
+ *
+ */
+typedef DisplayDelegate<DisplayList *, int> DisplayListSelectDelegate;
+
+/**
+ * @brief A row of the list which is on the screen.
+ * There is one of these for every row which fits in the list, and they are reused for other rows when the list scrolls.
+ */
+struct DISPLAY_LIST_ROW {
+    int index; //the row this text belongs to, -1 if none
+    char text[DISPLAY_LIST_TEXT_SIZE];
+};
+
+/**
+ * @brief A scrolling list of text rows, with any number of rows.
+ *
+ * The rows are not stored in the list, their texts are asked for from a function when they come into view,
+ * so a list of hundreds of rows uses the same memory as a list of ten.
+ * The list is scrolled by dragging it and a row is selected by tapping it.
+ *
+ * On ILI9341 displays, in rotation 0 and when the list is as wide as the screen,
+ * the list scrolls with the display's vertical scroll area. The pixels on the screen are moved by the display
+ * and only the rows coming into view are drawn.
+ *
+ * @code .cpp
+ * void getLogRow(DisplayList *pList, int index, char *text, size_t size)
+ * {
+ *     snprintf(text, size, "%d: %s", index, logEntries[index]);
+ * }
+ *
+ * DisplayList *pList = pPage->addList(0, 40, 240, 280, 24, TFT_BLACK, TFT_WHITE, TFT_DARKGREY, 1);
+ * pList->registerOnGetRowEvent(getLogRow);
+ * pList->setRowCount(logCount);
+ * @endcode
+ */
+class DisplayList : public DisplayWidget
+{
+private:
+    uint16_t _rowHeight;
+    uint16_t _fillColor;
+    uint16_t _textColor;
+    uint16_t _lineColor;
+    uint16_t _selectedFillColor;
+    uint16_t _selectedTextColor;
+    uint8_t _textsize;
+    int _rowCount;
+    int _selected;
+    int32_t _scroll;
+    DisplayListRowDelegate _onGetDisplayListRow;
+    DisplayListSelectDelegate _onSelectDisplayListRow;
+
+    DISPLAY_LIST_ROW *_pRows;
+    int _rowSlots;
+
+    bool _hardwareScroll;
+    bool _hardwareScrolling;
+    int16_t _hardwareOffset;
+
+    bool _touching;
+    bool _dragging;
+    int16_t _touchStartY;
+    int32_t _touchStartScroll;
+
+    DISPLAY_LIST_ROW *getRow(int index);
+    int32_t maxScroll();
+    bool canScrollInHardware();
+    void setupHardwareScroll();
+    void resetHardwareScroll();
+    void writeScrollStart(uint16_t line);
+    void drawLines(int16_t firstLine, int16_t lineCount);
+    void drawSegment(int32_t contentY, int16_t screenY, int16_t lineCount);
+
+public:
+    DisplayList(TFT_eSPI *tft,
+                DisplayPage *page,
+                int16_t x,
+                int16_t y,
+                uint16_t width,
+                uint16_t height,
+                uint16_t rowHeight,
+                uint16_t fillColor,
+                uint16_t textColor,
+                uint16_t lineColor,
+                uint8_t textsize);
+    ~DisplayList();
+
+    /**
+     * @brief Provides the function which writes the text of a row
+     *
+     */
+    void registerOnGetRowEvent(DisplayListRowDelegate pOnGetDisplayListRow);
+
+    /**
+     * @brief Provides a function to be called when a row is tapped
+     *
+     */
+    void registerOnSelectEvent(DisplayListSelectDelegate pOnSelectDisplayListRow) { _onSelectDisplayListRow = pOnSelectDisplayListRow; };
+
+    /**
+     * @brief Sets how many rows the list has, the rows on the screen are asked for again
+     *
+     */
+    void setRowCount(int rowCount);
+    int getRowCount() { return _rowCount; };
+
+    /**
+     * @brief Asks for the text of a row again and draws it if it is on the screen
+     *
+     */
+    void refreshRow(int index);
+
+    /**
+     * @brief Highlights a row, -1 for none
+     *
+     */
+    void setSelected(int index);
+    int getSelected() { return _selected; };
+    void setSelectedColors(uint16_t fillColor, uint16_t textColor);
+
+    /**
+     * @brief Scrolls the list so the given pixel line of all the rows is at the top of the list
+     *
+     */
+    void scrollTo(int32_t position);
+    void scrollBy(int32_t pixels) { scrollTo(_scroll + pixels); };
+
+    /**
+     * @brief Scrolls the list just enough for a row to be on the screen
+     *
+     */
+    void scrollToRow(int index);
+    int32_t getScrollPosition() { return _scroll; };
+
+    /**
+     * @brief Allow the list to use the display's vertical scroll area, it is allowed by default
+     *
+     */
+    void setHardwareScroll(bool allow);
+    bool isHardwareScrolling() { return _hardwareScrolling; };
+
+    /**
+     * @brief Get the row at a point on the screen
+     *
+     * @return int -1 if there is no row at the point
+     */
+    int rowAt(int16_t x, int16_t y);
+
+    void draw();
+    bool touch(uint16_t x, uint16_t y, bool pressed);
+    void pageHidden();
+    size_t getMemorySize() { return sizeof(DisplayList) + (_rowSlots * sizeof(DISPLAY_LIST_ROW)); }
+    const char *getTypeName() { return "DisplayList"; }
+};
+
+#endif
@@ -0,0 +1,56 @@
+#include "DisplayMemory.h"
+
+#if defined(ESP32)
+#include <esp_heap_caps.h>
+#endif
+
+DisplayMemoryHook DisplayMemory::_hook = NULL;
+uint32_t DisplayMemory::_allocations = 0;
+uint32_t DisplayMemory::_frees = 0;
+size_t DisplayMemory::_bytesInUse = 0;
+size_t DisplayMemory::_peakBytes = 0;
+
+void *DisplayMemory::allocate(size_t size)
+{
+    //fails the same way as new does everywhere else
+    void *ptr = ::operator new(size);
+
+    _allocations++;
+    _bytesInUse += size;
+    if (_bytesInUse > _peakBytes)
+        _peakBytes = _bytesInUse;
+
+    if (_hook)
+        _hook(true, size, ptr);
+    return ptr;
+}
+
+void DisplayMemory::release(void *ptr, size_t size)
+{
+    if (ptr == NULL)
+        return;
+
+    _frees++;
+    _bytesInUse -= size;
+    if (_hook)
+        _hook(false, size, ptr);
+    ::operator delete(ptr);
+}
+
+size_t DisplayMemory::getFreeHeap()
+{
+#if defined(ESP32)
+    return heap_caps_get_free_size(MALLOC_CAP_8BIT);
+#else
+    return 0;
+#endif
+}
+
+size_t DisplayMemory::getLargestFreeBlock()
+{
+#if defined(ESP32)
+    return heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+#else
+    return 0;
+#endif
+}
@@ -0,0 +1,73 @@
+#ifndef DISPLAYMEMORY_H
+#define DISPLAYMEMORY_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Called for every page, button, label and widget the library creates or deletes
+ *
+ * @param allocated true when memory was allocated, false when it was freed
+ * @param size Size of the object
+ * @param ptr The object's memory
+ */
+typedef void (*DisplayMemoryHook)(bool allocated, size_t size, void *ptr);
+
+/**
+ * @brief Counts the memory used by the objects the library creates.
+ *
+ * Pages, buttons, labels and widgets are allocated through this class, so it knows how many of them
+ * exist and how much memory they take. A hook can be set to see every allocation, for example to find
+ * which part of a sketch creates the most objects.
+ * The free heap and the largest free block are read from the ESP32 heap, on other boards they are 0.
+ *
+ * @code .cpp
+ * void onDisplayMemory(bool allocated, size_t size, void *ptr)
+ * {
+ *     Serial.printf("%s %u bytes at %p\n", allocated ? "new" : "delete", size, ptr);
+ * }
+ *
+ * DisplayMemory::setHook(onDisplayMemory);
+ * @endcode
+ */
+class DisplayMemory
+{
+private:
+    static DisplayMemoryHook _hook;
+    static uint32_t _allocations;
+    static uint32_t _frees;
+    static size_t _bytesInUse;
+    static size_t _peakBytes;
+
+public:
+    static void *allocate(size_t size);
+    static void release(void *ptr, size_t size);
+
+    static void setHook(DisplayMemoryHook hook) { _hook = hook; };
+
+    /**
+     * @brief How many objects the library has allocated since the program started
+     *
+     */
+    static uint32_t getAllocationCount() { return _allocations; };
+    static uint32_t getFreeCount() { return _frees; };
+
+    /**
+     * @brief Memory used by the library's objects which have not been deleted
+     *
+     */
+    static size_t getBytesInUse() { return _bytesInUse; };
+    static size_t getPeakBytes() { return _peakBytes; };
+
+    static size_t getFreeHeap();
+    static size_t getLargestFreeBlock();
+};
+
+/**
+ * @brief Makes a class allocate it's objects through DisplayMemory, put it in the public part of the class
+ *
+ */
+#define DISPLAY_MEMORY_TRACKED                                                          \
+    static void *operator new(size_t size) { return DisplayMemory::allocate(size); }   \
+    static void operator delete(void *ptr, size_t size) { DisplayMemory::release(ptr, size); }
+
+#endif
@@ -5,17 +5,89 @@ DisplayMenu::DisplayMenu(TFT_eSPI *tft, uint16_t fillColor)
     init(tft, fillColor);
 }
 
+DisplayMenu::~DisplayMenu()
+{
+    enableTextCache(0);
+    enablePrerender(0);
+    enableSlicedDraw(0);
+    enableGlyphCache(0);
+}
+
 void DisplayMenu::init(TFT_eSPI *tft, uint16_t fillColor)
 {
     _tft = tft;
     _fillColor = fillColor;
+    _font = DisplayFont(&FreeMonoBold9pt7b);
+    _pSelectedFont = NULL;
+    _pFontTarget = NULL;
+    _pSelectedGlyphs = NULL;
+    _selectedGeneration = 0;
+    _pGlyphCache = NULL;
+    _pTextCache = NULL;
+    _pPageCache = NULL;
+    _pPageRender = NULL;
+    _frameStart = 0;
+    _pageMemoryBudget = 0;
+    _showCount = 0;
+    _releasePending = false;
+    _widgetTouched = false;
+    _pMenuFile = NULL;
+    _begun = false;
+    _firstFrameDrawn = false;
+    _bootStart = 0;
+    memset(&_bootTimes, 0, sizeof(_bootTimes));
+    _chipSelect = -1;
+    _drawDepth = 0;
+    _touchEnabled = true;
+    _touchInjected = false;
+    _touchReadMicros = 0;
+    _pTouchRecorder = NULL;
+    memset(&_touchTimes, 0, sizeof(_touchTimes));
+    _drawnStyleChange = DisplayStyle::getLastChange();
+    _touchIrqPin = -1;
+    _touchPending = false;
+    _touchPollMillis = DISPLAY_MENU_TOUCH_POLL_MILLIS;
+    _updateRequested = false;
+    _requestedUpdate = 0;
+    _prerenderPending = false;
+    _pressState = PRESS_IDLE;
+    _pressMillis = 0;
+    _pPressedButton = NULL;
+#if defined(ESP32)
+    _wakeTask = NULL;
+#endif
+    _idleMillis = 0;
+    _lastActivity = 0;
+    _panelSleep = true;
+    _asleep = false;
+    _waking = false;
+    _wakeAt = 0;
+    _wakeTouch = false;
+    _pShowOnWake = NULL;
+    _backlightPin = -1;
+    _backlightOn = 255;
+    _backlightIdle = 0;
+
+    _touch.pressed = false;
+    _touch.x = 0;
+    _touch.y = 0;
+    _visablePage = -1;
+}
 
+bool DisplayMenu::begin(uint8_t rotation, bool calibrateTouch)
+{
+    _bootStart = micros();
+    _firstFrameDrawn = false;
+    memset(&_bootTimes, 0, sizeof(_bootTimes));
+
+    //init starts it's own transactions, so only the pin is set
+    if (_chipSelect > -1)
+        digitalWrite(_chipSelect, LOW);
     _tft->init();
-    // // Set the rotation before we calibrate
-    _tft->setRotation(1);
-    // // Clear screen
-    _tft->fillScreen(fillColor);
-    _tft->setFreeFont(&FreeMonoBold9pt7b); 
+    _tft->setRotation(rotation);
+    _font.select(_tft);
+    if (_chipSelect > -1)
+        digitalWrite(_chipSelect, HIGH);
 
     //_tft->setFreeFont(&FreeMono9pt7b);
     //_tft->setFreeFont(&FreeSans9pt7b);
@@ -25,20 +97,405 @@ void DisplayMenu::init(TFT_eSPI *tft, uint16_t fillColor)
     //_tft->setFreeFont(&FreeSerifBold9pt7b);
     //_tft->setFreeFont(&FreeSerifBoldItalic9pt7b);
     //_tft->setFreeFont(&FreeSerifItalic9pt7b);
-    
-    
-    _touch.pressed = false;
-    _touch.x = 0;
-    _touch.y = 0;
-    _visablePage = -1;
+    _begun = true;
+
+    unsigned long calibrationStart = micros();
+    _bootTimes.displayInit = calibrationStart - _bootStart;
+    bool calibrated = _touchEnabled && _touchCalibration.load(_tft);
+    if (!calibrated && calibrateTouch && _touchEnabled && _chipSelect < 0)
+    {
+        _touchCalibration.calibrate(_tft, TFT_MAGENTA, _fillColor);
+        _font.select(_tft);
+        calibrated = true;
+    }
+    _bootTimes.touchCalibration = micros() - calibrationStart;
+
+    return calibrated;
+}
+
+void DisplayMenu::setChipSelect(int8_t chipSelect)
+{
+    _chipSelect = chipSelect;
+    if (_chipSelect > -1)
+    {
+        pinMode(_chipSelect, OUTPUT);
+        digitalWrite(_chipSelect, HIGH);
+    }
+}
+
+void DisplayMenu::beginDraw()
+{
+    if (_drawDepth++ > 0)
+        return;
+
+    //the sketch may have drawn with other fonts since the last draw
+    forgetFont();
+
+    if (_chipSelect > -1)
+        digitalWrite(_chipSelect, LOW);
+    _tft->startWrite();
+}
+
+void DisplayMenu::selectFont(TFT_eSPI *pTarget, DisplayFont *pFont, const char *pText)
+{
+    pFont = resolveFont(pFont);
+    const uint8_t *pGlyphs = NULL;
+#ifdef SMOOTH_FONT
+    if (_pGlyphCache && pText)
+        pGlyphs = _pGlyphCache->getGlyphs(pFont, pText);
+#endif
+    //glyphs loaded from the cache are gone when the cache has freed any
+    if (pFont == _pSelectedFont && pTarget == _pFontTarget && pGlyphs == _pSelectedGlyphs &&
+        (pGlyphs == NULL || _selectedGeneration == _pGlyphCache->getGeneration()))
+        return;
+
+#ifdef SMOOTH_FONT
+    if (pGlyphs)
+        pTarget->loadFont(pGlyphs);
+    else
+#endif
+        pFont->select(pTarget);
+    _pSelectedFont = pFont;
+    _pFontTarget = pTarget;
+    _pSelectedGlyphs = pGlyphs;
+    _selectedGeneration = _pGlyphCache ? _pGlyphCache->getGeneration() : 0;
+}
+
+void DisplayMenu::endDraw()
+{
+    if (_drawDepth == 0 || --_drawDepth > 0)
+        return;
+
+    _tft->endWrite();
+    if (_chipSelect > -1)
+        digitalWrite(_chipSelect, HIGH);
+}
+
+void IRAM_ATTR DisplayMenu::onTouchInterrupt(void *pMenu)
+{
+    DisplayMenu *pThis = (DisplayMenu *)pMenu;
+    pThis->_touchPending = true;
+#if defined(ESP32)
+    if (pThis->_wakeTask)
+    {
+        BaseType_t woken = pdFALSE;
+        vTaskNotifyGiveFromISR(pThis->_wakeTask, &woken);
+        portYIELD_FROM_ISR(woken);
+    }
+#endif
+}
+
+void DisplayMenu::setTouchInterrupt(int8_t pin)
+{
+#if defined(ESP32)
+    if (_touchIrqPin > -1)
+        detachInterrupt(digitalPinToInterrupt(_touchIrqPin));
+#endif
+
+    _touchIrqPin = pin;
+    _touchPending = false;
+    if (_touchIrqPin < 0)
+        return;
+
+    pinMode(_touchIrqPin, INPUT_PULLUP);
+#if defined(ESP32)
+    attachInterruptArg(digitalPinToInterrupt(_touchIrqPin), onTouchInterrupt, this, FALLING);
+#endif
+    //other boards read the pin in update, which still saves reading the touch controller
+}
+
+void DisplayMenu::requestUpdate(unsigned long delayMillis)
+{
+    unsigned long deadline = millis() + delayMillis;
+    if (!_updateRequested || (long)(deadline - _requestedUpdate) < 0)
+        _requestedUpdate = deadline;
+    _updateRequested = true;
+}
+
+unsigned long DisplayMenu::getNextUpdateDelay()
+{
+    //a sleeping display only waits for a touch, or for the panel to come out of sleep
+    if (_asleep)
+    {
+        if (_waking)
+        {
+            long left = (long)(_wakeAt - millis());
+            return left > 0 ? left : 0;
+        }
+        if (_touchInjected || (_pTouchRecorder && _pTouchRecorder->isReplaying()) || _touchPending)
+            return 0;
+        return _touchEnabled && _touchIrqPin < 0 ? _touchPollMillis : DISPLAY_MENU_NO_DEADLINE;
+    }
+
+    if (_releasePending || isDrawingPage() || _drawnStyleChange != DisplayStyle::getLastChange())
+        return 0;
+
+    unsigned long delayMillis = DISPLAY_MENU_NO_DEADLINE;
+
+    //a pressed button waits for it's next step, neither the screen, a replay nor the page cache are read meanwhile
+    if (_pressState != PRESS_IDLE)
+    {
+        unsigned long elapsed = millis() - _pressMillis,
+                      wait = getPressWaitMillis();
+        delayMillis = elapsed >= wait ? 0 : wait - elapsed;
+    }
+    else if (_touchPending || _touchInjected || _prerenderPending || (_pTouchRecorder && _pTouchRecorder->isReplaying()))
+    {
+        return 0;
+    }
+    //a touch is followed until it ends, without an interrupt the screen is always polled
+    else if (_touchEnabled && (_touch.pressed || _widgetTouched || _touchIrqPin < 0))
+    {
+        unsigned long elapsed = (micros() - _touchReadMicros) / 1000;
+        delayMillis = elapsed >= _touchPollMillis ? 0 : _touchPollMillis - elapsed;
+    }
+
+    if (_updateRequested)
+    {
+        long left = (long)(_requestedUpdate - millis());
+        if (left <= 0)
+            return 0;
+        if ((unsigned long)left < delayMillis)
+            delayMillis = left;
+    }
+
+    if (_idleMillis > 0 && !_touch.pressed && !_widgetTouched && _pressState == PRESS_IDLE)
+    {
+        unsigned long idle = millis() - _lastActivity;
+        if (idle >= _idleMillis)
+            return 0;
+        if (_idleMillis - idle < delayMillis)
+            delayMillis = _idleMillis - idle;
+    }
+    return delayMillis;
+}
+
+void DisplayMenu::setIdleTimeout(unsigned long seconds, bool panelSleep)
+{
+    _idleMillis = seconds * 1000;
+    _panelSleep = panelSleep;
+    _lastActivity = millis();
+}
+
+void DisplayMenu::setBacklight(int8_t pin, uint8_t onLevel, uint8_t idleLevel)
+{
+    _backlightPin = pin;
+    _backlightOn = onLevel;
+    _backlightIdle = idleLevel;
+    if (_backlightPin < 0)
+        return;
+
+    pinMode(_backlightPin, OUTPUT);
+    setBacklightLevel(_asleep ? _backlightIdle : _backlightOn);
+}
+
+void DisplayMenu::setBacklightLevel(uint8_t level)
+{
+    if (_backlightPin > -1)
+        analogWrite(_backlightPin, level);
+}
+
+void DisplayMenu::sleep()
+{
+    if (_asleep && !_waking)
+        return;
+
+    _asleep = true;
+    _waking = false;
+    setBacklightLevel(_backlightIdle);
+    if (_panelSleep)
+    {
+        beginDraw();
+        _tft->writecommand(TFT_SLPIN);
+        endDraw();
+    }
+}
+
+void DisplayMenu::wake()
+{
+    if (!_asleep || _waking)
+        return;
+
+    _lastActivity = millis();
+    _wakeAt = _lastActivity;
+    if (_panelSleep)
+    {
+        beginDraw();
+        _tft->writecommand(TFT_SLPOUT);
+        endDraw();
+        _wakeAt += DISPLAY_MENU_SLEEP_OUT_MILLIS;
+    }
+    //nothing is drawn until the panel is out of sleep, update finishes waking it
+    _waking = true;
+}
+
+void DisplayMenu::finishWake()
+{
+    _asleep = false;
+    _waking = false;
+
+    //the panel kept the page while it slept, so it is only drawn if another page was shown meanwhile
+    if (_pShowOnWake)
+    {
+        DisplayPage *pPage = _pShowOnWake;
+        _pShowOnWake = NULL;
+        showPage(pPage);
+    }
+    else
+    {
+        DisplayPage *pVisable = getVisablePage();
+        if (pVisable)
+        {
+            beginDraw();
+            pVisable->drawChangingItems();
+            endDraw();
+        }
+        drawStyleChanges();
+    }
+    setBacklightLevel(_backlightOn);
+}
+
+void DisplayMenu::drawStyleChanges()
+{
+    //changes are drawn when the page being drawn in strips is done
+    if (_drawnStyleChange == DisplayStyle::getLastChange() || isDrawingPage())
+        return;
+
+    //only the items of the changed styles are drawn, other pages are drawn with the new styles when they are shown
+    DisplayPage *pVisable = getVisablePage();
+    if (pVisable)
+    {
+        beginDraw();
+        pVisable->drawStyleChanges(_drawnStyleChange);
+        endDraw();
+    }
+    _drawnStyleChange = DisplayStyle::getLastChange();
+}
+
+void DisplayMenu::injectTouch(uint16_t x, uint16_t y, bool pressed)
+{
+    _injectedTouch.x = x;
+    _injectedTouch.y = y;
+    _injectedTouch.pressed = pressed;
+    _touchInjected = true;
+}
+
+bool DisplayMenu::readTouch()
+{
+    if (_touchInjected)
+    {
+        _touchInjected = false;
+        _touch = _injectedTouch;
+        _touchReadMicros = micros();
+        return _touch.pressed;
+    }
+
+    if (_pTouchRecorder && _pTouchRecorder->isReplaying())
+    {
+        _pTouchRecorder->next(&_touch.x, &_touch.y, &_touch.pressed);
+        _touchReadMicros = micros();
+        return _touch.pressed;
+    }
+
+    if (!_touchEnabled)
+    {
+        _touch.pressed = false;
+        return false;
+    }
+
+    //with a touch interrupt the controller is only read after a touch started, and until it ends
+    if (_touchIrqPin > -1 && !_touchPending && !_touch.pressed && digitalRead(_touchIrqPin) == HIGH)
+    {
+        _touchReadMicros = micros();
+        if (_pTouchRecorder)
+            _pTouchRecorder->add(0, 0, false);
+        return false;
+    }
+    _touchPending = false;
+
+    //the touch controller is read with it's own chip select and bus speed
+    uint8_t depth = _drawDepth;
+    if (depth > 0)
+    {
+        _drawDepth = 1;
+        endDraw();
+    }
+
+    _touch.pressed = _tft->getTouch(&_touch.x, &_touch.y);
+    _touchReadMicros = micros();
+    if (_pTouchRecorder)
+        _pTouchRecorder->add(_touch.x, _touch.y, _touch.pressed);
+
+    if (depth > 0)
+    {
+        beginDraw();
+        _drawDepth = depth;
+    }
+    return _touch.pressed;
 }
 
 void DisplayMenu::showPage(int index)
 {
 
+    DisplayPage *pPage = getPage(index);
+    if (!pPage)
+        return;
+
+    //drawn when the display wakes up
+    if (_asleep)
+    {
+        _pShowOnWake = pPage;
+        return;
+    }
+
+    //sketches written before begin existed
+    if (!_begun)
+        begin(1, false);
+
+    _frameStart = micros();
+    DisplayPage *pHidden = getVisablePage();
+    if (pHidden && pHidden != pPage)
+        pHidden->hideWidgets();
+    _widgetTouched = false;
+    //a button pressed on the page being left is forgotten, it may be released with the page
+    _pressState = PRESS_IDLE;
+    _pPressedButton = NULL;
+
     _visablePage = index;
-    DisplayPage *pPage = getPage(_visablePage);
-    pPage->show();
+    pPage->setLastShown(++_showCount);
+    pPage->build();
+    //the page being left may still be running a button command, so release pages on the next update
+    _releasePending = _pageMemoryBudget > 0;
+    if (_pPageRender)
+        _pPageRender->cancel();
+    beginDraw();
+    if (!_pPageCache || !_pPageCache->show(pPage))
+    {
+        pPage->callShowEvent();
+        if (_pGlyphCache)
+            _pGlyphCache->prepare(pPage);
+        //with sliced drawing the page is drawn by the following calls to update
+        if (!_pPageRender || !_pPageRender->start(pPage))
+            pPage->draw(true);
+    }
+    endDraw();
+    _drawnStyleChange = DisplayStyle::getLastChange();
+    _prerenderPending = _pPageCache != NULL;
+    _lastActivity = millis();
+
+    if (!isDrawingPage())
+        frameDrawn();
+}
+
+void DisplayMenu::frameDrawn()
+{
+    if (_firstFrameDrawn)
+        return;
+
+    unsigned long now = micros();
+    _firstFrameDrawn = true;
+    _bootTimes.firstFrame = now - _frameStart;
+    _bootTimes.total = now - _bootStart;
 }
 
 void DisplayMenu::showPage(DisplayPage *pPage)
@@ -79,6 +536,235 @@ DisplayPage * DisplayMenu::addPage(DisplayPage page)
     return pages.add(page)? getLastPage() : NULL;
 }
 
+bool DisplayMenu::removePage(DisplayPage *pPage)
+{
+    return removePage(pages.indexOf(pPage));
+}
+
+bool DisplayMenu::removePage(int index)
+{
+    DisplayPage *pPage = getPage(index);
+    if (!pPage || index == _visablePage)
+        return false;
+
+    if (_pMenuFile && !_pMenuFile->pageRemoved(index))
+        return false;
+
+    int count = pages.size();
+    for (int i = 0; i < count; i++)
+    {
+        DisplayPage *pOther = pages.get(i);
+        for (int b = 0; b < pOther->buttonCount(); b++)
+        {
+            DisplayButton *btn = pOther->getButton(b);
+            if (btn->_values.pPageToOpen == pPage)
+                btn->_values.pPageToOpen = NULL;
+        }
+    }
+
+    if (_pPageCache)
+        _pPageCache->remove(pPage);
+    if (_pShowOnWake == pPage)
+        _pShowOnWake = NULL;
+    pages.remove(pPage);
+    if (_visablePage > index)
+        _visablePage--;
+    return true;
+}
+
+void DisplayMenu::enableTextCache(size_t maxBytes)
+{
+    if (_pTextCache)
+    {
+        delete _pTextCache;
+        _pTextCache = NULL;
+    }
+
+    if (maxBytes > 0)
+        _pTextCache = new DisplayTextCache(_tft, maxBytes);
+}
+
+void DisplayMenu::enableGlyphCache(size_t maxBytes, const char *alwaysChars)
+{
+    if (_pGlyphCache)
+    {
+        //a font loaded from the cache must not be used after it's glyphs are freed
+#ifdef SMOOTH_FONT
+        if (_pSelectedGlyphs && _pFontTarget)
+            _pFontTarget->unloadFont();
+#endif
+        forgetFont();
+        delete _pGlyphCache;
+        _pGlyphCache = NULL;
+    }
+
+    if (maxBytes > 0)
+        _pGlyphCache = new DisplayGlyphCache(maxBytes, alwaysChars);
+}
+
+void DisplayMenu::enableSlicedDraw(uint16_t stripHeight, uint8_t colorDepth)
+{
+    if (_pPageRender)
+    {
+        delete _pPageRender;
+        _pPageRender = NULL;
+    }
+
+    if (stripHeight > 0)
+        _pPageRender = new DisplayPageRender(_tft, stripHeight, colorDepth);
+}
+
+void DisplayMenu::enablePrerender(size_t maxBytes, uint8_t colorDepth, unsigned long sliceMicros)
+{
+    if (_pPageCache)
+    {
+        delete _pPageCache;
+        _pPageCache = NULL;
+    }
+
+    if (maxBytes > 0)
+        _pPageCache = new DisplayPageCache(_tft, maxBytes, colorDepth, sliceMicros);
+}
+
+DisplayPage * DisplayMenu::addLazyPage(DisplayPageDelegate pOnBuildDisplayPage, bool pinned)
+{
+    return addLazyPage(pOnBuildDisplayPage, pinned, _fillColor);
+}
+
+DisplayPage * DisplayMenu::addLazyPage(DisplayPageDelegate pOnBuildDisplayPage, bool pinned, uint16_t fillColor)
+{
+    DisplayPage page(_tft, this, fillColor);
+    page.registerOnBuildEvent(pOnBuildDisplayPage);
+    page.setPinned(pinned);
+    return pages.add(page)? getLastPage() : NULL;
+}
+
+bool DisplayMenu::loadMenu(DisplayMenuFile *pMenuFile)
+{
+    if (!pMenuFile || !pMenuFile->open(pages.count()))
+        return false;
+
+    _pMenuFile = pMenuFile;
+    for (uint16_t i = 0; i < pMenuFile->getPageCount(); i++)
+        addLazyPage(DisplayMenuFile::onBuildPage, false, pMenuFile->getPageFillColor(i));
+
+    return true;
+}
+
+size_t DisplayMenu::getPageMemory()
+{
+    size_t bytes = 0;
+    int count = pages.size();
+    for (int i = 0; i < count; i++)
+        bytes += pages.get(i)->getItemMemory();
+    return bytes;
+}
+
+void DisplayMenu::printMemoryReport(Print &out)
+{
+    //widget kinds are few, they are summed in a small table
+    const int maxTypes = 8;
+    const char *typeNames[maxTypes];
+    uint16_t typeCounts[maxTypes];
+    size_t typeBytes[maxTypes];
+    int typeCount = 0;
+    DISPLAY_PAGE_MEMORY report, total;
+    memset(&total, 0, sizeof(total));
+
+    out.printf("%-5s %-5s %8s %8s %8s %8s %8s %8s %7s %10s %10s\n", "page", "built", "buttons", "labels", "widgets",
+               "strings", "layout", "total", "allocs", "largest<", "largest>");
+    int count = pages.size();
+    for (int i = 0; i < count; i++)
+    {
+        DisplayPage *pPage = pages.get(i);
+        pPage->getMemoryReport(&report);
+        const DISPLAY_PAGE_BUILD_MEMORY &build = pPage->getBuildMemory();
+        out.printf("%-5d %-5s %8u %8u %8u %8u %8u %8u %7u %10u %10u\n", i, pPage->isBuilt() ? "yes" : "no",
+                   (unsigned)report.buttons, (unsigned)report.labels, (unsigned)report.widgets, (unsigned)report.strings,
+                   (unsigned)report.layout, (unsigned)report.total, (unsigned)build.allocations, (unsigned)build.largestBefore, (unsigned)build.largestAfter);
+
+        total.buttons += report.buttons;
+        total.labels += report.labels;
+        total.widgets += report.widgets;
+        total.strings += report.strings;
+        total.layout += report.layout;
+        total.total += report.total;
+
+        for (int w = 0; w < report.widgetCount; w++)
+        {
+            DisplayWidget *pWidget = pPage->getWidget(w);
+            const char *name = pWidget->getTypeName();
+            int type = 0;
+            while (type < typeCount && strcmp(typeNames[type], name) != 0)
+                type++;
+
+            if (type == typeCount)
+            {
+                if (typeCount == maxTypes)
+                    continue;
+                typeNames[type] = name;
+                typeCounts[type] = 0;
+                typeBytes[type] = 0;
+                typeCount++;
+            }
+            typeCounts[type]++;
+            typeBytes[type] += pWidget->getMemorySize();
+        }
+    }
+    out.printf("%-11s %8u %8u %8u %8u %8u %8u\n", "all", (unsigned)total.buttons, (unsigned)total.labels,
+               (unsigned)total.widgets, (unsigned)total.strings, (unsigned)total.layout, (unsigned)total.total);
+
+    for (int type = 0; type < typeCount; type++)
+        out.printf("%-20s %5u widgets %8u bytes\n", typeNames[type], typeCounts[type], (unsigned)typeBytes[type]);
+
+    if (_pTextCache)
+        out.printf("text cache %u of %u bytes\n", (unsigned)_pTextCache->getUsedBytes(), (unsigned)_pTextCache->getMaxBytes());
+    if (_pPageCache)
+        out.printf("page cache %u of %u bytes\n", (unsigned)_pPageCache->getUsedBytes(), (unsigned)_pPageCache->getMaxBytes());
+    if (_pGlyphCache)
+        out.printf("glyph cache %u of %u bytes, %lu hits, %lu font file reads\n", (unsigned)_pGlyphCache->getUsedBytes(),
+                   (unsigned)_pGlyphCache->getMaxBytes(), _pGlyphCache->getHits(), _pGlyphCache->getReads());
+    if (_pPageRender)
+        out.printf("sliced draw %u bytes, %u pages drawn\n", (unsigned)_pPageRender->getBytes(), (unsigned)_pPageRender->getFrames());
+    out.printf("styles %u, %u bytes\n", DisplayStyle::getCount(), (unsigned)(DisplayStyle::getCount() * sizeof(DisplayStyle)));
+
+    out.printf("library objects %u bytes, peak %u, %u allocations, %u frees\n", (unsigned)DisplayMemory::getBytesInUse(),
+               (unsigned)DisplayMemory::getPeakBytes(), (unsigned)DisplayMemory::getAllocationCount(), (unsigned)DisplayMemory::getFreeCount());
+    out.printf("heap free %u bytes, largest block %u bytes\n", (unsigned)DisplayMemory::getFreeHeap(), (unsigned)DisplayMemory::getLargestFreeBlock());
+}
+
+void DisplayMenu::releasePages()
+{
+    _releasePending = false;
+    if (_pageMemoryBudget == 0)
+        return;
+
+    DisplayPage *pVisable = getVisablePage();
+    size_t used = getPageMemory();
+    while (used > _pageMemoryBudget)
+    {
+        DisplayPage *pOldest = NULL;
+        int count = pages.size();
+        for (int i = 0; i < count; i++)
+        {
+            DisplayPage *pPage = pages.get(i);
+            if (pPage == pVisable || pPage->isPinned() || !pPage->isLazy() || !pPage->isBuilt())
+                continue;
+            if (!pOldest || pPage->getLastShown() < pOldest->getLastShown())
+                pOldest = pPage;
+        }
+
+        if (!pOldest)
+            return; //nothing left to release
+
+        size_t pageBytes = pOldest->getItemMemory();
+        if (_pPageCache)
+            _pPageCache->remove(pOldest);
+        pOldest->release();
+        used -= pageBytes;
+    }
+}
+
 DisplayPage *DisplayMenu::getLastPage()
 {
     int size = pages.size();
@@ -88,43 +774,185 @@ DisplayPage *DisplayMenu::getLastPage()
     return pages.get(size - 1);
 }
 
-bool DisplayMenu::update()
+unsigned long DisplayMenu::getPressWaitMillis()
+{
+    switch (_pressState)
+    {
+    case PRESS_SHOWN:
+        return DISPLAY_MENU_PRESS_MILLIS;
+    case PRESS_HELD:
+        return _touchPollMillis;
+    case PRESS_RELEASED:
+        return DISPLAY_MENU_RELEASE_MILLIS;
+    default:
+        return 0;
+    }
+}
+
+bool DisplayMenu::updatePress()
+{
+    if (millis() - _pressMillis < getPressWaitMillis())
+        return false;
+
+    //the time from here to the command is added to the press, the waits before are on purpose
+    unsigned long decided = micros();
+    DisplayButton *btn = _pPressedButton;
+    _lastActivity = millis();
+    if (!btn)
+    {
+        _pressState = PRESS_IDLE;
+        return false;
+    }
+
+    if (btn->_values.allowOnlyOneButtonPressedAtATime)
+    {
+        //the command runs when the screen has been released, a short release is a bounce
+        if (_pressState == PRESS_SHOWN)
+            _pressState = PRESS_HELD;
+        else if (readTouch())
+            _pressState = PRESS_HELD;
+        else if (_pressState == PRESS_HELD)
+            _pressState = PRESS_RELEASED;
+        else
+            _pressState = PRESS_IDLE;
+
+        if (_pressState != PRESS_IDLE)
+        {
+            _pressMillis = millis();
+            return false;
+        }
+        decided = micros();
+
+        //make button not inverted
+        beginDraw();
+        btn->resetPressState();
+        btn->draw();
+        endDraw();
+    }
+
+    //the command may show another page, which starts with no button pressed
+    _pressState = PRESS_IDLE;
+    _pPressedButton = NULL;
+    _touchTimes.stage[TOUCH_CALLBACK] = _touchTimes.stage[TOUCH_FLUSHED] + (micros() - decided);
+    if (_pTouchRecorder)
+        _pTouchRecorder->addTimes(_touchTimes);
+    beginDraw();
+    btn->executeCommand();
+    endDraw();
+    return true;
+}
+
+bool DisplayMenu::update(unsigned long budgetMicros)
 {
     bool didUpdate = false;
 
-    _touch.pressed = _tft->getTouch(&_touch.x, &_touch.y);
+    if (_asleep)
+    {
+        if (_waking)
+        {
+            if ((long)(millis() - _wakeAt) < 0)
+                return false;
+            finishWake();
+            return false;
+        }
+
+        //the first touch only wakes the display
+        if (readTouch())
+        {
+            wake();
+            _wakeTouch = true;
+        }
+        return false;
+    }
+
+    if (_updateRequested && (long)(millis() - _requestedUpdate) >= 0)
+        _updateRequested = false;
+
+    if (_releasePending)
+        releasePages();
+
+    //a page being drawn is finished before the touch screen is read, it's buttons are not all on the display yet
+    if (isDrawingPage())
+    {
+        beginDraw();
+        bool more = _pPageRender->update(budgetMicros);
+        endDraw();
+        if (more)
+            return false;
+        frameDrawn();
+
+        //values and styles which changed while the page was drawn, the strips sent first show them as they were
+        DisplayPage *pDrawn = getVisablePage();
+        if (pDrawn)
+        {
+            beginDraw();
+            pDrawn->drawDeferredValues();
+            endDraw();
+        }
+    }
+
+    drawStyleChanges();
+
+    //a pressed button is followed before the screen is read for a new touch
+    if (_pressState != PRESS_IDLE)
+        return updatePress();
+
+    readTouch();
+
+    //the touch which woke the display is not used until it ends
+    if (_wakeTouch)
+    {
+        if (_touch.pressed)
+            return false;
+        _wakeTouch = false;
+    }
+
+    if (_touch.pressed || _widgetTouched)
+        _lastActivity = millis();
+    else if (_idleMillis > 0 && millis() - _lastActivity >= _idleMillis)
+    {
+        sleep();
+        return false;
+    }
+
+    DisplayPage *pTouchedPage = getVisablePage();
+    if (pTouchedPage && (_touch.pressed || _widgetTouched))
+    {
+        //a touch which starts on a widget belongs to it until the screen is released
+        beginDraw();
+        bool used = pTouchedPage->touchWidgets(_touch.x, _touch.y, _touch.pressed);
+        endDraw();
+        if (!_touch.pressed || used || _widgetTouched)
+        {
+            _widgetTouched = _touch.pressed;
+            return true;
+        }
+    }
 
     if (_touch.pressed)
     {
         DisplayPage *pCurrentPage = getVisablePage();
         if (pCurrentPage)
         {
-            DisplayButton *btn = pCurrentPage->getPressedButton(_touch.x, _touch.y);
+            _touchTimes.stage[TOUCH_SAMPLE] = _touchReadMicros;
+            beginDraw();
+            _pPressedButton = pCurrentPage->getPressedButton(_touch.x, _touch.y);
+            _touchTimes.stage[TOUCH_HIT_TEST] = micros();
             pCurrentPage->drawTouchButtonsState();
-            delay(100);
+            endDraw();
+            _touchTimes.stage[TOUCH_FLUSHED] = micros();
+
+            //the pressed state is shown for a while, the following calls to update run the command
+            _pressState = PRESS_SHOWN;
+            _pressMillis = millis();
             didUpdate = true;
-            if (btn)
-            {
-                if (btn->_values.allowOnlyOneButtonPressedAtATime)
-                {
-                    do
-                    {
-                        delay(50);
-                        _touch.pressed = _tft->getTouch(&_touch.x, &_touch.y);
-                        if (!_touch.pressed)
-                        {
-                            delay(10);
-                            _touch.pressed = _tft->getTouch(&_touch.x, &_touch.y);
-                        }
-                    } while (_touch.pressed); //wait until no touch, then execute
-
-                    //make button not inverted
-                    btn->resetPressState();
-                    btn->draw();
-                }
-                btn->executeCommand();
-            }
         }
     }
+    else if (_pPageCache)
+    {
+        //the touch screen has been read, use what is left of this call to draw pages which may be opened next.
+        //The pages are drawn into sprites, so the display is not selected.
+        _prerenderPending = _pPageCache->update(getVisablePage());
+    }
     return didUpdate;
-}
\ No newline at end of file
+}
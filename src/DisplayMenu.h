@@ -9,6 +9,65 @@
 
 #include "DisplayPage.h"
 #include "DisplayPageList.h"
+#include "DisplayTextCache.h"
+#include "DisplayPageCache.h"
+#include "DisplayPageRender.h"
+#include "DisplayGlyphCache.h"
+#include "DisplayMenuFile.h"
+#include "DisplayTouchCalibration.h"
+#include "DisplayMenuGroup.h"
+#include "DisplayTouchRecorder.h"
+
+#if defined(ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
+//boards other than the ESP32 have no instruction RAM to place the touch interrupt in
+#ifndef IRAM_ATTR
+#define IRAM_ATTR
+#endif
+
+/**
+ * @brief Returned by getNextUpdateDelay when the menu has nothing to do until the screen is touched.
+ *
+ */
+#define DISPLAY_MENU_NO_DEADLINE 0xFFFFFFFFUL
+
+/**
+ * @brief How often the touch screen is read while it is pressed, or always when there is no touch interrupt, in milliseconds.
+ *
+ */
+#define DISPLAY_MENU_TOUCH_POLL_MILLIS 20
+
+/**
+ * @brief How long the panel needs after the sleep out command before it can be used, the ILI9341 and ST7789 datasheets ask for 120ms.
+ *
+ */
+#define DISPLAY_MENU_SLEEP_OUT_MILLIS 120
+
+/**
+ * @brief How long a pressed button is shown inverted before it's command runs, and how often a held button repeats, in milliseconds.
+ *
+ */
+#define DISPLAY_MENU_PRESS_MILLIS 100
+
+/**
+ * @brief How long the screen must stay released before a button which waits for the release runs it's command, in milliseconds.
+ *
+ */
+#define DISPLAY_MENU_RELEASE_MILLIS 10
+
+/**
+ * @brief Where update is in handling a pressed button, update returns while it waits so the sketch keeps running.
+ *
+ */
+enum DisplayMenuPressState {
+    PRESS_IDLE,     //no button is being pressed
+    PRESS_SHOWN,    //the pressed button is drawn inverted and shown for DISPLAY_MENU_PRESS_MILLIS
+    PRESS_HELD,     //waiting for the screen to be released, it is read every touch poll interval
+    PRESS_RELEASED  //the screen was released, it is read again after DISPLAY_MENU_RELEASE_MILLIS
+};
 
 struct TOUCHED_STRUCT {
     uint16_t x;
@@ -17,6 +76,17 @@ struct TOUCHED_STRUCT {
 
 };
 
+/**
+ * @brief How long each step of starting the menu took, in microseconds.
+ *
+ */
+struct DISPLAY_MENU_BOOT_TIMES {
+    uint32_t displayInit;      //initializing the display and setting the rotation
+    uint32_t touchCalibration; //loading, or running, the touch calibration
+    uint32_t firstFrame;       //drawing the first page shown
+    uint32_t total;            //from the start of begin until the first page was drawn
+};
+
 class DisplayMenu
 {
 private:
@@ -27,17 +97,381 @@ private:
     DisplayPageList pages;
     unsigned long myTouchTimer;
     unsigned long myTouchDelay;
+    DisplayFont _font;
+    DisplayFont *_pSelectedFont; //font last selected on _pFontTarget, NULL when it is not known
+    TFT_eSPI *_pFontTarget;
+    const uint8_t *_pSelectedGlyphs;  //glyphs loaded from the glyph cache with _pSelectedFont, NULL when it was loaded otherwise
+    uint32_t _selectedGeneration;
+    DisplayGlyphCache *_pGlyphCache;
+    DisplayTextCache *_pTextCache;
+    DisplayPageCache *_pPageCache;
+    DisplayPageRender *_pPageRender;
+    unsigned long _frameStart;
+    size_t _pageMemoryBudget;
+    unsigned long _showCount;
+    bool _releasePending;
+    bool _widgetTouched;
+    DisplayMenuFile *_pMenuFile;
+    bool _begun;
+    bool _firstFrameDrawn;
+    unsigned long _bootStart;
+    DISPLAY_MENU_BOOT_TIMES _bootTimes;
+    DisplayTouchCalibration _touchCalibration;
+    int8_t _chipSelect;
+    uint8_t _drawDepth;
+    bool _touchEnabled;
+    bool _touchInjected;
+    TOUCHED_STRUCT _injectedTouch;
+    unsigned long _touchReadMicros;
+    DisplayTouchRecorder *_pTouchRecorder;
+    DISPLAY_TOUCH_TIMES _touchTimes;
+    uint32_t _drawnStyleChange;
+    int8_t _touchIrqPin;
+    volatile bool _touchPending;
+    unsigned long _touchPollMillis;
+    bool _updateRequested;
+    unsigned long _requestedUpdate;
+    bool _prerenderPending;
+    DisplayMenuPressState _pressState;
+    unsigned long _pressMillis;
+    DisplayButton *_pPressedButton;
+#if defined(ESP32)
+    TaskHandle_t _wakeTask;
+#endif
+
+    unsigned long _idleMillis;
+    unsigned long _lastActivity;
+    bool _panelSleep;
+    bool _asleep;
+    bool _waking; //the panel was sent the sleep out command and is drawn to after _wakeAt
+    unsigned long _wakeAt;
+    bool _wakeTouch;
+    DisplayPage *_pShowOnWake;
+    int8_t _backlightPin;
+    uint8_t _backlightOn;
+    uint8_t _backlightIdle;
+
+    static void IRAM_ATTR onTouchInterrupt(void *pMenu);
+    void setBacklightLevel(uint8_t level);
+
+    /**
+     * @brief Draws what changed while the display slept and turns the backlight on, once the panel is out of sleep
+     * 
+     */
+    void finishWake();
+
+    /**
+     * @brief Draws the items whose style changed since the visable page was drawn
+     * 
+     */
+    void drawStyleChanges();
+
+    /**
+     * @brief Records when the first page shown was drawn
+     * 
+     */
+    void frameDrawn();
 
     void init(TFT_eSPI *tft, uint16_t fillColor);
+
+    /**
+     * @brief Reads the touch screen into _touch. An open draw is paused while the touch controller is read,
+     * as it shares the bus with the display. An injected touch or a replayed recording is read instead of the screen.
+     */
+    bool readTouch();
+
+    /**
+     * @brief Releases the least recently shown pages with build functions until the memory used by
+     * page items is within the budget. The visable page and pinned pages are never released.
+     */
+    void releasePages();
+
+    /**
+     * @brief Moves a button press on when it's wait is over, called by update while a button is pressed
+     * 
+     * @return true if the button's command was run
+     */
+    bool updatePress();
+
+    /**
+     * @brief How long the press state waits, in milliseconds
+     * 
+     */
+    unsigned long getPressWaitMillis();
     
 public:
     void invertColors(bool invert) { _tft->invertDisplay(invert); }
+    /**
+     * @brief Construct a new Display Menu object.
+     * The display is not touched until begin is called, so the menu can be a global variable.
+     * 
+     */
     DisplayMenu(TFT_eSPI *tft, uint16_t fillColor = TFT_BLACK);
+    ~DisplayMenu();
+
+    /**
+     * @brief Initializes the display and applies the stored touch calibration.
+     * The screen is not cleared, the first page shown fills it.
+     * 
+     * @code .cpp
+     * void setup()
+     * {
+     *     menu.begin();
+     *     addPages();
+     *     menu.showPage(0);
+     *     Serial.printf("First frame after %u us\n", menu.getBootTimes().total);
+     * }
+     * @endcode
+     * 
+     * @param rotation The display rotation, the calibration is stored for this rotation
+     * @param calibrateTouch If no calibration is stored, run the calibration on the screen and store it
+     * @return true if the touch screen is calibrated
+     */
+    bool begin(uint8_t rotation = 1, bool calibrateTouch = true);
+    bool isBegun() { return _begun; };
+
+    /**
+     * @brief Where the touch calibration is stored, use it to store it in a file or to clear it
+     * 
+     */
+    DisplayTouchCalibration *getTouchCalibration() { return &_touchCalibration; };
+
+    /**
+     * @brief How long begin and drawing the first page took
+     * 
+     */
+    const DISPLAY_MENU_BOOT_TIMES &getBootTimes() { return _bootTimes; };
+
+    /**
+     * @brief Set a pin which selects the display, for displays sharing the SPI bus with other displays.
+     * TFT_CS must be set to -1 in the TFT_eSPI setup, the menu then holds this pin low while it draws.
+     * The touch calibration screen can not be shown on a display selected this way,
+     * so begin only loads a calibration which has been stored before.
+     * 
+     * @param chipSelect The pin, -1 if TFT_eSPI selects the display
+     */
+    void setChipSelect(int8_t chipSelect);
+    int8_t getChipSelect() { return _chipSelect; };
+
+    /**
+     * @brief Selects the display and starts one bus transaction for all drawing until endDraw is called,
+     * instead of one for every line, rectangle and character drawn.
+     * update and showPage do this themselves, call it around drawing done elsewhere when a chip select pin is set.
+     * Calls can be nested, the transaction ends with the last endDraw.
+     * 
+     * @code .cpp
+     * menu.beginDraw();
+     * pBar->drawChanges();
+     * pChart->sample();
+     * menu.endDraw();
+     * @endcode
+     */
+    void beginDraw();
+    void endDraw();
+
+    /**
+     * @brief Set if update reads the touch screen, only one display of displays sharing a touch controller should.
+     * 
+     */
+    void setTouchEnabled(bool enabled) { _touchEnabled = enabled; };
+    bool isTouchEnabled() { return _touchEnabled; };
+
+    /**
+     * @brief Use the touch controller's interrupt pin, T_IRQ, which is low while the screen is touched.
+     * update then only reads the touch controller after the pin signalled a touch and until the touch ends,
+     * and getNextUpdateDelay does not ask for updates to poll the screen.
+     * 
+     * @param pin The pin T_IRQ is connected to, -1 stops using it
+     */
+    void setTouchInterrupt(int8_t pin);
+    int8_t getTouchInterrupt() { return _touchIrqPin; };
+
+#if defined(ESP32)
+    /**
+     * @brief A task which is notified from the touch interrupt, so it can wait in ulTaskNotifyTake until the screen is touched.
+     * 
+     */
+    void setWakeTask(TaskHandle_t task) { _wakeTask = task; };
+#endif
+
+    /**
+     * @brief Set how often the touch screen needs to be read while it is pressed, or always when there is no touch interrupt.
+     * 
+     */
+    void setTouchPollInterval(unsigned long pollMillis) { _touchPollMillis = pollMillis; };
+    unsigned long getTouchPollInterval() { return _touchPollMillis; };
+
+    /**
+     * @brief Ask for update to be called within the given time, for example when a linked value is to be drawn again.
+     * The earliest request is kept until update is called after it.
+     * 
+     */
+    void requestUpdate(unsigned long delayMillis);
+
+    /**
+     * @brief How long the sketch can wait before update needs to be called again, in milliseconds.
+     * 0 means update has work to do now. DISPLAY_MENU_NO_DEADLINE means nothing is needed until the screen is touched,
+     * which the touch interrupt signals.
+     * 
+     * @code .cpp
+     * void setup()
+     * {
+     *     ...
+     *     menu.setTouchInterrupt(TOUCH_IRQ_PIN);
+     *     menu.setWakeTask(xTaskGetCurrentTaskHandle());
+     * }
+     * 
+     * void loop()
+     * {
+     *     menu.update();
+     *     unsigned long idle = menu.getNextUpdateDelay();
+     *     if (idle > 0)
+     *         ulTaskNotifyTake(pdTRUE, idle == DISPLAY_MENU_NO_DEADLINE ? portMAX_DELAY : pdMS_TO_TICKS(idle));
+     * }
+     * @endcode
+     */
+    unsigned long getNextUpdateDelay();
+
+    /**
+     * @brief Put the display to sleep after a time without touches.
+     * While asleep nothing is drawn, the backlight is set to it's idle level and getNextUpdateDelay only asks for updates
+     * to read the touch screen. The first touch only wakes the display, it does not press a button.
+     * 
+     * @param seconds Time without touches before the display sleeps, 0 never sleeps
+     * @param panelSleep Should the panel be sent the sleep command, pass false to only dim the backlight
+     */
+    void setIdleTimeout(unsigned long seconds, bool panelSleep = true);
+    unsigned long getIdleTimeout() { return _idleMillis / 1000; };
+
+    /**
+     * @brief Set the pin controlling the backlight, it is driven with analogWrite
+     * 
+     * @param pin The backlight pin, -1 if the backlight is not controlled by the menu
+     * @param onLevel Level while the display is awake
+     * @param idleLevel Level while the display is asleep, 0 turns the backlight off
+     */
+    void setBacklight(int8_t pin, uint8_t onLevel = 255, uint8_t idleLevel = 0);
+
+    /**
+     * @brief Stops drawing, sets the backlight to it's idle level and puts the panel to sleep
+     * 
+     */
+    void sleep();
+
+    /**
+     * @brief Wakes the panel, the panel keeps the page while it sleeps, so only a page shown while asleep,
+     * changed styles, items showing values and widgets are drawn.
+     * wake does not wait for the panel to come out of sleep, the display stays asleep until update is called
+     * DISPLAY_MENU_SLEEP_OUT_MILLIS later, getNextUpdateDelay tells when.
+     * 
+     */
+    void wake();
+    bool isAsleep() { return _asleep; };
+
+    /**
+     * @brief The next time update reads the touch screen, this touch is used instead
+     * 
+     * @code .cpp
+     * menu.injectTouch(60, 45, true);  // press the button at 60, 45
+     * menu.update();
+     * menu.injectTouch(0, 0, false);   // and release it
+     * menu.update();
+     * @endcode
+     */
+    void injectTouch(uint16_t x, uint16_t y, bool pressed);
+
+    /**
+     * @brief Set a recorder which records, or replays, what is read from the touch screen
+     * and measures how long it takes to handle presses.
+     * 
+     * @param pRecorder The recorder, NULL to stop using it
+     */
+    void setTouchRecorder(DisplayTouchRecorder *pRecorder) { _pTouchRecorder = pRecorder; };
+    DisplayTouchRecorder *getTouchRecorder() { return _pTouchRecorder; };
+
+    /**
+     * @brief When each step of handling the last button press happened
+     * 
+     */
+    const DISPLAY_TOUCH_TIMES &getTouchTimes() { return _touchTimes; };
     DisplayPage * addPage();
     DisplayPage * addPage(uint16_t fillColor);
     DisplayPage * addPage(DisplayPage page);
+
+    /**
+     * @brief Adds a page which is built by a function the first time it is shown.
+     * 
+     * @code .cpp
+     * void buildSettingsPage(DisplayPage *pPage)
+     * {
+     *     pPage->addPageButton(10, 10, 100, 40, TFT_WHITE, TFT_RED, TFT_GOLD, 1, "Back", pPage->getMenu()->getPage(0));
+     * }
+     * 
+     * menu.addLazyPage(buildSettingsPage);
+     * @endcode
+     * 
+     * @param pOnBuildDisplayPage Function adding the buttons, labels and widgets to the page
+     * @param pinned If true the page items are never released once they have been built
+     * @return DisplayPage* the added page, it has no items until it is shown.
+     */
+    DisplayPage * addLazyPage(DisplayPageDelegate pOnBuildDisplayPage, bool pinned = false);
+    DisplayPage * addLazyPage(DisplayPageDelegate pOnBuildDisplayPage, bool pinned, uint16_t fillColor);
+
+    /**
+     * @brief Set how much heap the items of all built pages may use.
+     * When a page is shown and the budget is exceeded, items of pages with build functions
+     * are released, least recently shown first.
+     * 
+     * @param bytes The budget, 0 means no limit.
+     */
+    void setPageMemoryBudget(size_t bytes) { _pageMemoryBudget = bytes; };
+    size_t getPageMemoryBudget() { return _pageMemoryBudget; };
+
+    /**
+     * @brief Estimates the heap used by the items of all pages
+     * 
+     */
+    size_t getPageMemory();
+
+    /**
+     * @brief Prints how much heap each page, each kind of widget, the caches and the library as a whole use,
+     * and how the heap looked before and after each page was built.
+     * 
+     * @code .cpp
+     * menu.printMemoryReport(Serial);
+     * @endcode
+     */
+    void printMemoryReport(Print &out);
     DisplayPage *getPage(int index);
 
+    /**
+     * @brief Get the index of a page in the menu
+     * 
+     * @return int -1 if the page does not belong to this menu
+     */
+    int getPageIndex(DisplayPage *pPage) { return pages.indexOf(pPage); };
+    int getPageCount() { return pages.count(); };
+
+    /**
+     * @brief Removes a page from the menu and deletes it with all it's items.
+     * Buttons on other pages which open the page are changed to open no page.
+     * The visable page and pages loaded from a menu file can not be removed.
+     * 
+     * @return true if the page was removed
+     */
+    bool removePage(DisplayPage *pPage);
+    bool removePage(int index);
+
+    /**
+     * @brief Adds all pages described in a menu file to the menu.
+     * The pages are added as lazy pages, each page is read from the file when it is shown.
+     * 
+     * @param pMenuFile The menu file, it must exist for as long as the menu does.
+     * @return true if the file was valid and it's pages were added
+     */
+    bool loadMenu(DisplayMenuFile *pMenuFile);
+    DisplayMenuFile *getMenuFile() { return _pMenuFile; };
+
     //called when a page is beeing made visable;
     void showPage(int index);
     void showPage(DisplayPage *pPage);
@@ -51,14 +485,163 @@ public:
     int getVisablePageIndex() { return _visablePage; };
     DisplayPage*  getLastPage();
 
+    /**
+     * @brief Set the font used when drawing buttons, labels and widgets which have no font of their own
+     * 
+     * @param pFont A GFX free font, for example &FreeMonoBold9pt7b
+     */
+    void setFont(const GFXfont *pFont) { _font = DisplayFont(pFont); forgetFont(); };
+
+    /**
+     * @brief Set the menu font to a GFX free font or a smooth font
+     * 
+     */
+    void setFont(const DisplayFont &font) { _font = font; forgetFont(); };
+
+    /**
+     * @brief The menu font as a GFX free font
+     * 
+     * @return const GFXfont* NULL if the menu font is a smooth font
+     */
+    const GFXfont *getFont() { return _font.getGfxFont(); };
+    DisplayFont *getDefaultFont() { return &_font; };
+
+    /**
+     * @brief The font an item with the given font is drawn with
+     * 
+     * @param pFont The item's font, NULL for the menu font
+     */
+    DisplayFont *resolveFont(DisplayFont *pFont) { return pFont ? pFont : &_font; };
+
+    /**
+     * @brief Selects a font on a display or a sprite, unless it is the font last selected there.
+     * Buttons, labels and widgets select their fonts through this, so a smooth font is not loaded again for every item.
+     * 
+     * @param pFont The font, NULL for the menu font
+     * @param pText The text which will be drawn, so a smooth font file can be loaded from the glyph cache.
+     * NULL loads the font from it's file.
+     */
+    void selectFont(TFT_eSPI *pTarget, DisplayFont *pFont, const char *pText = NULL);
+
+    /**
+     * @brief Forget which font was selected, the next selectFont sets it again.
+     * Called when draw functions have run and at the start of each draw, as fonts may have been changed outside the menu.
+     * 
+     */
+    void forgetFont() { _pSelectedFont = NULL; _pSelectedGlyphs = NULL; };
+
+    /**
+     * @brief Keeps the glyphs of the characters the visable page's buttons and labels use with smooth fonts loaded
+     * from files, so drawing a page does not read the font files for every character.
+     * The glyphs are read when a page is shown, and for characters not seen before the first time they are drawn.
+     * 
+     * @code .cpp
+     * DisplayFont large("NotoSans-Bold36", SPIFFS);
+     * menu.enableGlyphCache(64 * 1024); // in PSRAM when there is some
+     * @endcode
+     * 
+     * @param maxBytes Memory the glyphs of all fonts may use together. Passing 0 disables the cache and frees it's memory.
+     * @param alwaysChars Characters kept for every font, so values can change without reading the font file
+     */
+    void enableGlyphCache(size_t maxBytes, const char *alwaysChars = DISPLAY_GLYPH_CACHE_ALWAYS);
+
+    /**
+     * @brief Get the Glyph Cache
+     * 
+     * @return DisplayGlyphCache* NULL if the cache is not enabled
+     */
+    DisplayGlyphCache *getGlyphCache() { return _pGlyphCache; };
+
+    /**
+     * @brief Keeps rendered button and label texts as small 1 bit sprites so they can be
+     * drawn again with a single push instead of being rendered glyph by glyph.
+     * 
+     * @param maxBytes Memory the cache may use, least recently used texts are dropped when it is full.
+     * Passing 0 disables the cache and frees it's memory.
+     */
+    void enableTextCache(size_t maxBytes);
+
+    /**
+     * @brief Get the Text Cache
+     * 
+     * @return DisplayTextCache* NULL if the cache is not enabled
+     */
+    DisplayTextCache *getTextCache() { return _pTextCache; };
+
+    /**
+     * @brief While no button is pressed, update draws the pages the visable page's OPEN_PAGE buttons open
+     * into off screen sprites, a little at a time. When such a page is shown it is pushed to the display in one go.
+     * 
+     * @code .cpp
+     * menu.enablePrerender(2 * 320 * 240 * 2); // two pages in PSRAM
+     * @endcode
+     * 
+     * @param maxBytes Memory the page sprites may use. Passing 0 disables drawing pages ahead of time and frees it's memory.
+     * @param colorDepth 16, or 8 to use half the memory with colors reduced to RGB332.
+     * Only the page pushed from the sprite is reduced, buttons drawn pressed and released, values and style changes
+     * are drawn later in full color, so on pages with colors RGB332 can not show they can stand out as boxes.
+     * Use 8 with colors which are the same in both, such as TFT_BLACK, TFT_WHITE, TFT_RED, TFT_GREEN, TFT_BLUE and TFT_YELLOW.
+     * @param sliceMicros How long each call to update may spend drawing pages ahead of time
+     */
+    void enablePrerender(size_t maxBytes, uint8_t colorDepth = 16, unsigned long sliceMicros = 2000);
+
+    /**
+     * @brief Get the cache of pages drawn ahead of time
+     * 
+     * @return DisplayPageCache* NULL if drawing pages ahead of time is not enabled
+     */
+    DisplayPageCache *getPageCache() { return _pPageCache; };
+
+    /**
+     * @brief Draw pages a strip at a time over many calls to update, instead of all at once when they are shown.
+     * showPage then only starts drawing the page and update(budgetMicros) draws as much of it as fits in the budget,
+     * so a busy page does not hold up the rest of the sketch. Each strip is pushed to the display when all of it has been drawn.
+     * The touch screen is not read until the page has been drawn to the end,
+     * and values and styles which change meanwhile are drawn when it is done.
+     * Pages and items with draw functions are still drawn in one go.
+     * 
+     * @code .cpp
+     * menu.enableSlicedDraw(16);
+     * 
+     * void loop()
+     * {
+     *     menu.update(4000); // draw for at most 4ms
+     *     readSensors();
+     * }
+     * @endcode
+     * 
+     * @param stripHeight Height of a strip in pixels, 0 disables sliced drawing and frees the strip
+     * @param colorDepth 16, or 8 to use half the memory with colors reduced to RGB332.
+     * Only the strips are reduced, buttons drawn pressed and released, values and style changes are drawn later in full color,
+     * so like with enablePrerender use 8 with colors which are the same in both, or they can stand out as boxes.
+     */
+    void enableSlicedDraw(uint16_t stripHeight, uint8_t colorDepth = 16);
+
+    /**
+     * @brief Get the strip drawer used for sliced drawing
+     * 
+     * @return DisplayPageRender* NULL if sliced drawing is not enabled
+     */
+    DisplayPageRender *getPageRender() { return _pPageRender; };
+
+    /**
+     * @brief Is a page being drawn by sliced drawing
+     * 
+     */
+    bool isDrawingPage() { return _pPageRender && _pPageRender->isRendering(); };
+
     //DisplayPage*   getVisablePageIndex() { return _visablePage; };
     /**
      * @brief checks if a button was pressed and updates it's value and runs it's associated actions. 
+     * update does not wait while a button is pressed, it returns and the press is followed by the next calls,
+     * getNextUpdateDelay tells when the next step of the press is due.
      * 
+     * @param budgetMicros How long this call may spend drawing a page started by showPage, when sliced drawing is enabled.
+     * 0 draws the page to the end.
      * @return true a button was pressed and a button status did change.
      * @return false no button was pressed.
      */
-    bool update();
+    bool update(unsigned long budgetMicros = 0);
 };
 
 
@@ -0,0 +1,558 @@
+#include "DisplayMenuFile.h"
+#include "DisplayMenu.h"
+
+#define DISPLAY_MENU_FILE_HEADER_SIZE 10
+#define DISPLAY_MENU_FILE_STYLE_SIZE 7
+#define DISPLAY_MENU_FILE_PAGE_SIZE 8
+//the fixed part of an item record, field by field as in the description in DisplayMenuFile.h, the text follows it
+#define DISPLAY_MENU_FILE_ITEM_SIZE (1 + 1 + 2 + 2 + 2 + 2 + 2 + 1 + 1 + 2 + 2 + 2 + 2 + 1 + 8 + 1)
+
+enum DisplayMenuFileItemType {
+    FILE_ITEM_LABEL,
+    FILE_ITEM_RUN_FUNCTION,
+    FILE_ITEM_OPEN_PAGE,
+    FILE_ITEM_INCREMENT_VALUE
+};
+
+DisplayMenuFile::DisplayMenuFile(fs::FS &fs, const char *path)
+{
+    init();
+    _pFs = &fs;
+    _path = path;
+}
+
+DisplayMenuFile::DisplayMenuFile(const uint8_t *pData, size_t size)
+{
+    init();
+    _pData = pData;
+    _dataSize = size;
+}
+
+DisplayMenuFile::~DisplayMenuFile()
+{
+    freeTables();
+    for (int i = 0; i < _bindings.size(); i++)
+        delete _bindings.get(i);
+    _bindings.clear();
+}
+
+void DisplayMenuFile::init()
+{
+    _pFs = NULL;
+    _pData = NULL;
+    _dataSize = 0;
+    _position = 0;
+    _readOk = false;
+    _styleCount = 0;
+    _pStyles = NULL;
+    _pageCount = 0;
+    _pPages = NULL;
+    _firstPageIndex = 0;
+}
+
+void DisplayMenuFile::freeTables()
+{
+    delete[] _pStyles;
+    delete[] _pPages;
+    _pStyles = NULL;
+    _pPages = NULL;
+    _styleCount = 0;
+    _pageCount = 0;
+}
+
+void DisplayMenuFile::registerAction(uint16_t id, ButtonPressedFunction action)
+{
+    DISPLAY_MENU_FILE_BINDING *pBinding = new DISPLAY_MENU_FILE_BINDING;
+    pBinding->id = id;
+    pBinding->action = action;
+    pBinding->pValue = NULL;
+    _bindings.add(pBinding);
+}
+
+void DisplayMenuFile::registerValue(uint16_t id, double *pValue)
+{
+    DISPLAY_MENU_FILE_BINDING *pBinding = new DISPLAY_MENU_FILE_BINDING;
+    pBinding->id = id;
+    pBinding->action = NULL;
+    pBinding->pValue = pValue;
+    _bindings.add(pBinding);
+}
+
+ButtonPressedFunction DisplayMenuFile::findAction(uint16_t id)
+{
+    for (int i = 0; i < _bindings.size(); i++)
+    {
+        DISPLAY_MENU_FILE_BINDING *pBinding = _bindings.get(i);
+        if (pBinding->action && pBinding->id == id)
+            return pBinding->action;
+    }
+    return NULL;
+}
+
+double *DisplayMenuFile::findValue(uint16_t id)
+{
+    for (int i = 0; i < _bindings.size(); i++)
+    {
+        DISPLAY_MENU_FILE_BINDING *pBinding = _bindings.get(i);
+        if (pBinding->pValue && pBinding->id == id)
+            return pBinding->pValue;
+    }
+    return NULL;
+}
+
+uint16_t DisplayMenuFile::findActionId(ButtonPressedFunction action)
+{
+    for (int i = 0; action && i < _bindings.size(); i++)
+    {
+        DISPLAY_MENU_FILE_BINDING *pBinding = _bindings.get(i);
+        if (pBinding->action == action)
+            return pBinding->id;
+    }
+    return DISPLAY_MENU_FILE_NONE;
+}
+
+uint16_t DisplayMenuFile::findValueId(double *pValue)
+{
+    for (int i = 0; pValue && i < _bindings.size(); i++)
+    {
+        DISPLAY_MENU_FILE_BINDING *pBinding = _bindings.get(i);
+        if (pBinding->pValue == pValue)
+            return pBinding->id;
+    }
+    return DISPLAY_MENU_FILE_NONE;
+}
+
+bool DisplayMenuFile::beginRead(uint32_t offset)
+{
+    _position = offset;
+    if (_pData)
+    {
+        _readOk = offset <= _dataSize;
+        return _readOk;
+    }
+
+    if (!_pFs)
+        return _readOk = false;
+
+    _file = _pFs->open(_path.c_str(), "r");
+    _readOk = _file && _file.seek(offset);
+    return _readOk;
+}
+
+void DisplayMenuFile::endRead()
+{
+    if (_file)
+        _file.close();
+}
+
+void DisplayMenuFile::readBytes(void *buffer, size_t size)
+{
+    if (!_readOk)
+    {
+        memset(buffer, 0, size);
+        return;
+    }
+
+    if (_pData)
+    {
+        if (_position + size > _dataSize)
+        {
+            _readOk = false;
+            memset(buffer, 0, size);
+            return;
+        }
+        memcpy(buffer, _pData + _position, size);
+    }
+    else if (_file.read((uint8_t *)buffer, size) != size)
+    {
+        _readOk = false;
+        memset(buffer, 0, size);
+        return;
+    }
+    _position += size;
+}
+
+uint8_t DisplayMenuFile::readU8()
+{
+    uint8_t value;
+    readBytes(&value, 1);
+    return value;
+}
+
+uint16_t DisplayMenuFile::readU16()
+{
+    uint8_t bytes[2];
+    readBytes(bytes, 2);
+    return bytes[0] | (bytes[1] << 8);
+}
+
+uint32_t DisplayMenuFile::readU32()
+{
+    uint8_t bytes[4];
+    readBytes(bytes, 4);
+    return bytes[0] | (bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+double DisplayMenuFile::readF64()
+{
+    uint8_t bytes[8];
+    uint64_t bits = 0;
+    readBytes(bytes, 8);
+    for (int i = 7; i >= 0; i--)
+        bits = (bits << 8) | bytes[i];
+
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+bool DisplayMenuFile::open(int firstPageIndex)
+{
+    freeTables();
+    _firstPageIndex = firstPageIndex;
+
+    if (!beginRead(0))
+        return false;
+
+    char magic[4];
+    readBytes(magic, 4);
+    uint8_t version = readU8();
+    readU8(); //reserved
+    uint16_t pageCount = readU16();
+    uint16_t styleCount = readU16();
+
+    if (!_readOk || memcmp(magic, "DMNU", 4) != 0 || version != DISPLAY_MENU_FILE_VERSION)
+    {
+        endRead();
+        return false;
+    }
+
+    _pStyles = new DISPLAY_MENU_FILE_STYLE[styleCount > 0 ? styleCount : 1];
+    for (uint16_t i = 0; i < styleCount; i++)
+    {
+        _pStyles[i].outlineColor = readU16();
+        _pStyles[i].fillColor = readU16();
+        _pStyles[i].textColor = readU16();
+        _pStyles[i].textsize = readU8();
+    }
+
+    _pPages = new DISPLAY_MENU_FILE_PAGE[pageCount > 0 ? pageCount : 1];
+    for (uint16_t i = 0; i < pageCount; i++)
+    {
+        _pPages[i].offset = readU32();
+        _pPages[i].fillColor = readU16();
+        _pPages[i].itemCount = readU16();
+    }
+
+    bool ok = _readOk;
+    endRead();
+    if (!ok)
+    {
+        freeTables();
+        return false;
+    }
+
+    _styleCount = styleCount;
+    _pageCount = pageCount;
+    return true;
+}
+
+bool DisplayMenuFile::pageRemoved(int pageIndex)
+{
+    if (pageIndex >= _firstPageIndex && pageIndex < _firstPageIndex + _pageCount)
+        return false;
+
+    if (pageIndex < _firstPageIndex)
+        _firstPageIndex--;
+    return true;
+}
+
+void DisplayMenuFile::onBuildPage(DisplayPage *pPage)
+{
+    DisplayMenu *pMenu = pPage->getMenu();
+    DisplayMenuFile *pFile = pMenu ? pMenu->getMenuFile() : NULL;
+    if (!pFile)
+        return;
+
+    pFile->buildPage(pPage, pMenu->getPageIndex(pPage) - pFile->_firstPageIndex);
+}
+
+bool DisplayMenuFile::buildPage(DisplayPage *pPage, int fileIndex)
+{
+    if (fileIndex < 0 || fileIndex >= _pageCount)
+        return false;
+
+    DisplayMenu *pMenu = pPage->getMenu();
+    const DISPLAY_MENU_FILE_PAGE &page = _pPages[fileIndex];
+    if (!beginRead(page.offset))
+        return false;
+
+    //one item at a time, only the current item text is held outside the page
+    char text[256];
+    for (uint16_t item = 0; item < page.itemCount && _readOk; item++)
+    {
+        uint8_t type = readU8();
+        uint8_t flags = readU8();
+        int16_t x = readU16(),
+                y = readU16();
+        uint16_t width = readU16(),
+                 height = readU16(),
+                 styleIndex = readU16();
+        uint8_t radius = readU8();
+        TextAlign textAlign = (TextAlign)readU8();
+        int16_t xDatumOffset = readU16(),
+                yDatumOffset = readU16();
+        uint16_t target = readU16(),
+                 valueId = readU16();
+        int8_t precision = (int8_t)readU8();
+        double incrementValue = readF64();
+        uint8_t textLength = readU8();
+        readBytes(text, textLength);
+        text[textLength] = '\0';
+
+        if (!_readOk)
+            break;
+
+        DISPLAY_MENU_FILE_STYLE style = {TFT_WHITE, TFT_BLACK, TFT_WHITE, 1};
+        if (styleIndex < _styleCount)
+            style = _pStyles[styleIndex];
+
+        DisplayState state = (flags & 1) ? HIDDEN : VISABLE;
+        bool trimZeros = !(flags & 2);
+        double *pValue = findValue(valueId);
+
+        if (type == FILE_ITEM_LABEL)
+        {
+            DisplayLabel *pLabel = pPage->addPageLabel(x, y, width, height, style.outlineColor, style.fillColor, style.textColor, style.textsize, text, textAlign);
+            if (!pLabel)
+                continue;
+            pLabel->setRadius(radius);
+            pLabel->setTextAlign(textAlign, xDatumOffset, yDatumOffset);
+            pLabel->setState(state);
+            if (pValue)
+                pLabel->setLinkToValue(pValue, "");
+            pLabel->setLinkedValueFormat(precision, trimZeros);
+            continue;
+        }
+
+        DisplayButton *pButton = NULL;
+        if (type == FILE_ITEM_RUN_FUNCTION)
+        {
+            pButton = pPage->addFunctionButton(x, y, width, height, style.outlineColor, style.fillColor, style.textColor, style.textsize, text, findAction(target));
+        }
+        else if (type == FILE_ITEM_OPEN_PAGE)
+        {
+            DisplayPage *pPageToOpen = target == DISPLAY_MENU_FILE_NONE ? NULL : pMenu->getPage(_firstPageIndex + target);
+            pButton = pPage->addPageButton(x, y, width, height, style.outlineColor, style.fillColor, style.textColor, style.textsize, text, pPageToOpen, textAlign);
+        }
+        else if (type == FILE_ITEM_INCREMENT_VALUE)
+        {
+            pButton = pPage->addIncrementButton(x, y, width, height, style.outlineColor, style.fillColor, style.textColor, style.textsize, text, pValue, incrementValue);
+        }
+
+        if (!pButton)
+            continue;
+        pButton->setRadius(radius);
+        pButton->setTextAlign(textAlign, xDatumOffset, yDatumOffset);
+        pButton->setState(state);
+        if (pValue && type != FILE_ITEM_INCREMENT_VALUE)
+            pButton->setLinkToValue(pValue, "");
+        pButton->setLinkedValueFormat(precision, trimZeros);
+    }
+
+    bool ok = _readOk;
+    endRead();
+    return ok;
+}
+
+static size_t writeU8(Print &out, uint8_t value)
+{
+    return out.write(value);
+}
+
+static size_t writeU16(Print &out, uint16_t value)
+{
+    uint8_t bytes[2] = {(uint8_t)(value & 0xFF), (uint8_t)(value >> 8)};
+    return out.write(bytes, 2);
+}
+
+static size_t writeU32(Print &out, uint32_t value)
+{
+    uint8_t bytes[4] = {(uint8_t)(value & 0xFF), (uint8_t)(value >> 8), (uint8_t)(value >> 16), (uint8_t)(value >> 24)};
+    return out.write(bytes, 4);
+}
+
+static size_t writeF64(Print &out, double value)
+{
+    uint64_t bits;
+    uint8_t bytes[8];
+    memcpy(&bits, &value, sizeof(bits));
+    for (int i = 0; i < 8; i++)
+    {
+        bytes[i] = bits & 0xFF;
+        bits >>= 8;
+    }
+    return out.write(bytes, 8);
+}
+
+static uint16_t findStyle(DISPLAY_MENU_FILE_STYLE *pStyles, uint16_t &styleCount, DISPLAY_MENU_FILE_STYLE style, bool addIfMissing)
+{
+    for (uint16_t i = 0; i < styleCount; i++)
+    {
+        if (pStyles[i].outlineColor == style.outlineColor && pStyles[i].fillColor == style.fillColor &&
+            pStyles[i].textColor == style.textColor && pStyles[i].textsize == style.textsize)
+            return i;
+    }
+
+    if (!addIfMissing)
+        return DISPLAY_MENU_FILE_NONE;
+
+    pStyles[styleCount] = style;
+    return styleCount++;
+}
+
+/**
+ * @brief Writes one item record, labels and buttons store the same fields in their value structs.
+ * 
+ * @return size_t bytes written, DISPLAY_MENU_FILE_ITEM_SIZE and the text
+ */
+template <typename VALUES>
+static size_t writeItem(Print &out, VALUES &values, uint8_t type, uint16_t style, uint16_t target, uint16_t valueId, double incrementValue)
+{
+    uint8_t textLength = min(values.text.length(), 255U);
+    size_t written = writeU8(out, type);
+    written += writeU8(out, (values.state == HIDDEN ? 1 : 0) | (values.linkedValueTrimZeros ? 0 : 2));
+    written += writeU16(out, values.x);
+    written += writeU16(out, values.y);
+    written += writeU16(out, values.width);
+    written += writeU16(out, values.height);
+    written += writeU16(out, style);
+    written += writeU8(out, values.pStyle->getRadius(values.width, values.height));
+    written += writeU8(out, values.textAlign);
+    written += writeU16(out, values.xDatumOffset);
+    written += writeU16(out, values.yDatumOffset);
+    written += writeU16(out, target);
+    written += writeU16(out, valueId);
+    written += writeU8(out, (uint8_t)values.linkedValuePrecision);
+    written += writeF64(out, incrementValue);
+    written += writeU8(out, textLength);
+    return written + out.write((const uint8_t *)values.text.c_str(), textLength);
+}
+
+size_t DisplayMenuFile::save(DisplayMenu *pMenu, Print &out)
+{
+    int pageCount = pMenu->getPageCount();
+    int itemCount = 0;
+    for (int p = 0; p < pageCount; p++)
+    {
+        DisplayPage *pPage = pMenu->getPage(p);
+        pPage->build();
+        itemCount += pPage->labelCount() + pPage->buttonCount();
+    }
+
+    //first pass, collect the styles and the size of every page
+    DISPLAY_MENU_FILE_STYLE *pStyles = new DISPLAY_MENU_FILE_STYLE[itemCount > 0 ? itemCount : 1];
+    uint16_t styleCount = 0;
+    uint32_t *pPageSizes = new uint32_t[pageCount > 0 ? pageCount : 1];
+    for (int p = 0; p < pageCount; p++)
+    {
+        DisplayPage *pPage = pMenu->getPage(p);
+        pPageSizes[p] = 0;
+        for (int i = 0; i < pPage->labelCount(); i++)
+        {
+            DISPLAY_LABEL_VALUES &values = pPage->getLabel(i)->_values;
+            DISPLAY_MENU_FILE_STYLE style = {values.pStyle->getOutlineColor(), values.pStyle->getFillColor(), values.pStyle->getTextColor(), values.pStyle->getTextSize()};
+            findStyle(pStyles, styleCount, style, true);
+            pPageSizes[p] += DISPLAY_MENU_FILE_ITEM_SIZE + min(values.text.length(), 255U);
+        }
+        for (int i = 0; i < pPage->buttonCount(); i++)
+        {
+            DISPLAY_BUTTON_VALUES &values = pPage->getButton(i)->_values;
+            DISPLAY_MENU_FILE_STYLE style = {values.pStyle->getOutlineColor(), values.pStyle->getFillColor(), values.pStyle->getTextColor(), values.pStyle->getTextSize()};
+            findStyle(pStyles, styleCount, style, true);
+            pPageSizes[p] += DISPLAY_MENU_FILE_ITEM_SIZE + min(values.text.length(), 255U);
+        }
+    }
+
+    size_t written = 0;
+    out.write((const uint8_t *)"DMNU", 4);
+    writeU8(out, DISPLAY_MENU_FILE_VERSION);
+    writeU8(out, 0);
+    writeU16(out, pageCount);
+    writeU16(out, styleCount);
+    written += DISPLAY_MENU_FILE_HEADER_SIZE;
+
+    for (uint16_t i = 0; i < styleCount; i++)
+    {
+        writeU16(out, pStyles[i].outlineColor);
+        writeU16(out, pStyles[i].fillColor);
+        writeU16(out, pStyles[i].textColor);
+        writeU8(out, pStyles[i].textsize);
+        written += DISPLAY_MENU_FILE_STYLE_SIZE;
+    }
+
+    uint32_t offset = written + (pageCount * DISPLAY_MENU_FILE_PAGE_SIZE);
+    for (int p = 0; p < pageCount; p++)
+    {
+        DisplayPage *pPage = pMenu->getPage(p);
+        writeU32(out, offset);
+        writeU16(out, pPage->getFillColor());
+        writeU16(out, pPage->labelCount() + pPage->buttonCount());
+        written += DISPLAY_MENU_FILE_PAGE_SIZE;
+        offset += pPageSizes[p];
+    }
+
+    //second pass, the page records
+    for (int p = 0; p < pageCount; p++)
+    {
+        DisplayPage *pPage = pMenu->getPage(p);
+        int labelCount = pPage->labelCount();
+        int pageItemCount = labelCount + pPage->buttonCount();
+        for (int i = 0; i < pageItemCount; i++)
+        {
+            uint8_t type = FILE_ITEM_LABEL;
+            uint16_t target = DISPLAY_MENU_FILE_NONE;
+            double incrementValue = 0;
+            DisplayLabel *pLabel = i < labelCount ? pPage->getLabel(i) : NULL;
+            DisplayButton *pButton = i < labelCount ? NULL : pPage->getButton(i - labelCount);
+
+            if (pButton)
+            {
+                DISPLAY_BUTTON_VALUES &values = pButton->_values;
+                incrementValue = values.incrementValue;
+                switch (values.type)
+                {
+                case RUN_FUNCTION:
+                    type = FILE_ITEM_RUN_FUNCTION;
+                    target = findActionId(values.buttonPressedFunction.getFunction());
+                    break;
+                case OPEN_PAGE:
+                    type = FILE_ITEM_OPEN_PAGE;
+                    if (values.pPageToOpen)
+                        target = pMenu->getPageIndex(values.pPageToOpen);
+                    break;
+                case INCREMENT_VALUE:
+                    type = FILE_ITEM_INCREMENT_VALUE;
+                    break;
+                }
+            }
+
+            if (pLabel)
+            {
+                DISPLAY_LABEL_VALUES &values = pLabel->_values;
+                DISPLAY_MENU_FILE_STYLE style = {values.pStyle->getOutlineColor(), values.pStyle->getFillColor(), values.pStyle->getTextColor(), values.pStyle->getTextSize()};
+                written += writeItem(out, values, type, findStyle(pStyles, styleCount, style, false), target, findValueId(values.pLinkedValue), incrementValue);
+            }
+            else
+            {
+                DISPLAY_BUTTON_VALUES &values = pButton->_values;
+                DISPLAY_MENU_FILE_STYLE style = {values.pStyle->getOutlineColor(), values.pStyle->getFillColor(), values.pStyle->getTextColor(), values.pStyle->getTextSize()};
+                written += writeItem(out, values, type, findStyle(pStyles, styleCount, style, false), target, findValueId(values.pLinkedValue), incrementValue);
+            }
+        }
+    }
+
+    delete[] pStyles;
+    delete[] pPageSizes;
+    return written;
+}
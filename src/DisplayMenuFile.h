@@ -0,0 +1,193 @@
+#ifndef DISPLAYMENUFILE_H
+#define DISPLAYMENUFILE_H
+
+#include <Arduino.h>
+
+#include <FS.h>
+
+#include "LinkedList.h"
+#include "DisplayButton.h"
+
+class DisplayMenu;
+class DisplayPage;
+
+#define DISPLAY_MENU_FILE_VERSION 1
+#define DISPLAY_MENU_FILE_NONE 0xFFFF
+
+/*
+    Binary menu description, all numbers are little endian.
+
+    Header
+        char[4] magic "DMNU"
+        u8      version
+        u8      reserved, 0
+        u16     page count
+        u16     style count
+        style   styles[style count]
+        page    page table[page count]
+
+    Style (7 bytes)
+        u16 outline color, u16 fill color, u16 text color, u8 text size
+
+    Page table entry (8 bytes)
+        u32 offset of the page record from the start of the file
+        u16 page fill color
+        u16 item count
+
+    Page record, item count items
+        u8  type              0 label, 1 run function button, 2 open page button, 3 increment value button
+        u8  flags             bit 0 hidden, bit 1 keep ending zeros of the linked value
+        i16 x, i16 y, u16 width, u16 height
+        u16 style index
+        u8  radius
+        u8  text align
+        i16 x datum offset, i16 y datum offset
+        u16 target            action id for run function buttons, page index for open page buttons
+        u16 value id          id of the linked value
+        i8  linked value precision, -1 to draw the item text
+        f64 increment value
+        u8  text length
+        char text[text length]
+*/
+
+/**
+ * @brief A registered id, binding an id in a menu file to a function or a variable in the program.
+ *
+ */
+struct DISPLAY_MENU_FILE_BINDING {
+    uint16_t id;
+    ButtonPressedFunction action;
+    double *pValue;
+};
+
+struct DISPLAY_MENU_FILE_STYLE {
+    uint16_t outlineColor;
+    uint16_t fillColor;
+    uint16_t textColor;
+    uint8_t textsize;
+};
+
+struct DISPLAY_MENU_FILE_PAGE {
+    uint32_t offset;
+    uint16_t fillColor;
+    uint16_t itemCount;
+};
+
+/**
+ * @brief Loads menu pages from a compact binary description stored in a file or in flash.
+ *
+ * Only the header, the styles and the page table are kept in memory. Every page is added to the menu as a lazy page
+ * and it's items are read from the file when the page is shown, so together with
+ * DisplayMenu::setPageMemoryBudget a menu can have more pages than fit in the heap.
+ *
+ * @code .cpp
+ * DisplayMenuFile menuFile(SPIFFS, "/menu.bin");
+ * menuFile.registerAction(1, showPageEditTemperature);
+ * menuFile.registerValue(1, &globalTemperature);
+ * menu.loadMenu(&menuFile);
+ * @endcode
+ */
+class DisplayMenuFile
+{
+private:
+    fs::FS *_pFs;
+    String _path;
+    const uint8_t *_pData;
+    size_t _dataSize;
+
+    File _file;
+    uint32_t _position;
+    bool _readOk;
+
+    uint16_t _styleCount;
+    DISPLAY_MENU_FILE_STYLE *_pStyles;
+    uint16_t _pageCount;
+    DISPLAY_MENU_FILE_PAGE *_pPages;
+    int _firstPageIndex;
+
+    LinkedList<DISPLAY_MENU_FILE_BINDING*> _bindings;
+
+    void init();
+    void freeTables();
+    bool beginRead(uint32_t offset);
+    void endRead();
+    void readBytes(void *buffer, size_t size);
+    uint8_t readU8();
+    uint16_t readU16();
+    uint32_t readU32();
+    double readF64();
+
+    ButtonPressedFunction findAction(uint16_t id);
+    double *findValue(uint16_t id);
+    uint16_t findActionId(ButtonPressedFunction action);
+    uint16_t findValueId(double *pValue);
+    bool buildPage(DisplayPage *pPage, int fileIndex);
+
+public:
+    /**
+     * @brief Construct a menu file reading from a file system, for example SPIFFS or LittleFS
+     *
+     * @param fs The file system, it must be mounted before the menu is loaded
+     * @param path Path to the menu file
+     */
+    DisplayMenuFile(fs::FS &fs, const char *path);
+
+    /**
+     * @brief Construct a menu file reading from memory, for example a const array in flash
+     *
+     * @param pData The menu description
+     * @param size Number of bytes in pData
+     */
+    DisplayMenuFile(const uint8_t *pData, size_t size);
+    ~DisplayMenuFile();
+
+    /**
+     * @brief Binds an action id in the file to a function run by RUN_FUNCTION buttons
+     *
+     */
+    void registerAction(uint16_t id, ButtonPressedFunction action);
+
+    /**
+     * @brief Binds a value id in the file to a variable linked to buttons and labels
+     *
+     */
+    void registerValue(uint16_t id, double *pValue);
+
+    /**
+     * @brief Reads the header, styles and page table.
+     *
+     * @param firstPageIndex Index in the menu of the first page in the file, page targets in the file are relative to it.
+     * @return true if the file is a valid menu description of a supported version.
+     */
+    bool open(int firstPageIndex);
+
+    uint16_t getPageCount() { return _pageCount; };
+
+    /**
+     * @brief Called by the menu before a page is removed, pages from the file are found by their index in the menu.
+     *
+     * @param pageIndex Index in the menu of the page being removed
+     * @return false if the page was loaded from this file, such pages can not be removed
+     */
+    bool pageRemoved(int pageIndex);
+    uint16_t getPageFillColor(uint16_t fileIndex) { return fileIndex < _pageCount ? _pPages[fileIndex].fillColor : 0; };
+
+    /**
+     * @brief The build function used for pages loaded from a menu file
+     *
+     */
+    static void onBuildPage(DisplayPage *pPage);
+
+    /**
+     * @brief Writes all pages of a menu as a menu description.
+     * Functions and variables are written with the ids they are registered with, unregistered ones are left out.
+     * Widgets are not written, only labels and buttons.
+     *
+     * @param pMenu The menu to write
+     * @param out Where to write, for example a File opened for writing
+     * @return size_t number of bytes written
+     */
+    size_t save(DisplayMenu *pMenu, Print &out);
+};
+
+#endif
@@ -0,0 +1,108 @@
+#include "DisplayMenuGroup.h"
+#include "DisplayMenu.h"
+
+DisplayMenuGroup::DisplayMenuGroup(unsigned long sliceMicros)
+{
+    _next = 0;
+    _sliceMicros = sliceMicros;
+#if defined(ESP32)
+    _busLock = xSemaphoreCreateRecursiveMutex();
+#endif
+}
+
+DisplayMenuGroup::~DisplayMenuGroup()
+{
+#if defined(ESP32)
+    if (_busLock)
+        vSemaphoreDelete(_busLock);
+#endif
+}
+
+bool DisplayMenuGroup::addMenu(DisplayMenu *pMenu, int8_t chipSelect, bool touch)
+{
+    if (pMenu == NULL)
+        return false;
+
+    //the pin is set high right away, so the display does not listen to what is sent to the others
+    pMenu->setChipSelect(chipSelect);
+    pMenu->setTouchEnabled(touch);
+    return add(pMenu);
+}
+
+bool DisplayMenuGroup::begin(uint8_t rotation)
+{
+    bool calibrated = false;
+    for (int i = 0; i < _size; i++)
+    {
+        lockBus();
+        DisplayMenu *pMenu = get(i);
+        if (pMenu->begin(rotation, true) && pMenu->isTouchEnabled())
+            calibrated = true;
+        unlockBus();
+    }
+    return calibrated;
+}
+
+bool DisplayMenuGroup::update()
+{
+    if (_size < 1)
+        return false;
+
+    bool didUpdate = false;
+    unsigned long start = micros();
+    for (int i = 0; i < _size; i++)
+    {
+        if (_next >= _size)
+            _next = 0;
+
+        //a page drawn in slices only gets what is left of the slice, a pressed button does not wait in update,
+        //so no menu holds the bus for longer than it's draw
+        unsigned long budgetMicros = 0;
+        if (_sliceMicros > 0)
+            budgetMicros = max(1UL, _sliceMicros - (micros() - start));
+
+        DisplayMenu *pMenu = get(_next++);
+        lockBus();
+        if (pMenu->update(budgetMicros))
+            didUpdate = true;
+        unlockBus();
+
+        if (_sliceMicros > 0 && micros() - start >= _sliceMicros)
+            break;
+    }
+    return didUpdate;
+}
+
+unsigned long DisplayMenuGroup::getNextUpdateDelay()
+{
+    unsigned long delayMillis = DISPLAY_MENU_NO_DEADLINE;
+    for (int i = 0; i < _size; i++)
+    {
+        unsigned long menuDelay = get(i)->getNextUpdateDelay();
+        if (menuDelay < delayMillis)
+            delayMillis = menuDelay;
+    }
+    return delayMillis;
+}
+
+bool DisplayMenuGroup::lockBus(unsigned long timeoutMillis)
+{
+#if defined(ESP32)
+    if (_busLock == NULL)
+        return false;
+
+    TickType_t ticks = timeoutMillis == 0xFFFFFFFF ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMillis);
+    return xSemaphoreTakeRecursive(_busLock, ticks) == pdTRUE;
+#else
+    //without tasks only the sketch itself uses the bus, and it is not drawing while it holds the lock
+    return true;
+#endif
+}
+
+void DisplayMenuGroup::unlockBus()
+{
+#if defined(ESP32)
+    if (_busLock)
+        xSemaphoreGiveRecursive(_busLock);
+#endif
+}
@@ -0,0 +1,119 @@
+#ifndef DISPLAYMENUGROUP_H
+#define DISPLAYMENUGROUP_H
+
+#include <Arduino.h>
+
+#include <TFT_eSPI.h>
+
+#include "LinkedList.h"
+
+#if defined(ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#endif
+
+class DisplayMenu;
+
+/**
+ * @brief Runs the menus of several displays which share one SPI bus.
+ *
+ * Each display has it's own chip select pin, which the menu holds low while it draws, and TFT_CS is set to -1
+ * in the TFT_eSPI setup. A menu draws everything it has to draw in one transaction with it's display selected,
+ * so the displays are never selected in turn for every line or character drawn.
+ * update gives the menus the bus one after the other, starting with the next one each time,
+ * and when a time slice is set it stops when the slice is used and continues with the next menu on the next call.
+ * A menu drawing a page in slices, see DisplayMenu::enableSlicedDraw, is given what is left of the slice to draw in.
+ * The bus is only locked while a menu draws or reads it's touch screen, never while a button is held.
+ *
+ * Other devices on the bus, like an SD card, use lockBus and unlockBus to keep the menus off the bus,
+ * on an ESP32 this also works from other tasks.
+ *
+ * @code .cpp
+ * TFT_eSPI tft = TFT_eSPI();
+ * DisplayMenu mainMenu = DisplayMenu(&tft);
+ * DisplayMenu statusMenu = DisplayMenu(&tft);
+ * DisplayMenuGroup displays;
+ *
+ * void setup()
+ * {
+ *     displays.addMenu(&mainMenu, 15, true);
+ *     displays.addMenu(&statusMenu, 5, false);
+ *     displays.begin();
+ *     ...
+ * }
+ *
+ * void loop()
+ * {
+ *     displays.update();
+ *
+ *     displays.lockBus();
+ *     File log = SD.open("/log.txt", FILE_APPEND);
+ *     ...
+ *     displays.unlockBus();
+ * }
+ * @endcode
+ */
+class DisplayMenuGroup : public LinkedList<DisplayMenu*>
+{
+private:
+    int _next;
+    unsigned long _sliceMicros;
+#if defined(ESP32)
+    SemaphoreHandle_t _busLock;
+#endif
+
+public:
+    /**
+     * @brief Construct a new Display Menu Group object
+     *
+     * @param sliceMicros How long one call to update may use the bus, 0 to update every menu on each call
+     */
+    DisplayMenuGroup(unsigned long sliceMicros = 0);
+    ~DisplayMenuGroup();
+
+    /**
+     * @brief Adds the menu of a display to the group, the group does not own the menu
+     *
+     * @param pMenu The menu
+     * @param chipSelect The pin selecting the menu's display
+     * @param touch Does the menu read the touch screen, only one menu should when the displays share a touch controller
+     * @return true if the menu was added
+     */
+    bool addMenu(DisplayMenu *pMenu, int8_t chipSelect, bool touch);
+
+    /**
+     * @brief Begins all menus, one display at a time
+     *
+     * @return true if the touch screen is calibrated
+     */
+    bool begin(uint8_t rotation = 1);
+
+    /**
+     * @brief Updates the menus, each with the bus locked, menus drawing a page in slices draw for at most what is left of the slice
+     *
+     * @return true if a button was pressed on any of the displays
+     */
+    bool update();
+
+    /**
+     * @brief The shortest time any of the menus can wait before it needs to be updated, in milliseconds
+     *
+     * @return unsigned long DISPLAY_MENU_NO_DEADLINE if no menu needs an update until a screen is touched
+     */
+    unsigned long getNextUpdateDelay();
+
+    void setSliceMicros(unsigned long sliceMicros) { _sliceMicros = sliceMicros; };
+    unsigned long getSliceMicros() { return _sliceMicros; };
+
+    /**
+     * @brief Waits until no menu is using the bus and keeps the menus off it until unlockBus is called.
+     * Can be called again by the same task before unlocking.
+     *
+     * @param timeoutMillis How long to wait for the bus
+     * @return true if the bus was locked
+     */
+    bool lockBus(unsigned long timeoutMillis = 0xFFFFFFFF);
+    void unlockBus();
+};
+
+#endif
@@ -0,0 +1,236 @@
+#include "DisplayNumberFormat.h"
+
+static const uint32_t powersOfTen[DISPLAY_NUMBER_MAX_PRECISION + 1] = {
+    1UL, 10UL, 100UL, 1000UL, 10000UL, 100000UL, 1000000UL, 10000000UL, 100000000UL, 1000000000UL};
+
+static size_t copyText(char *buffer, size_t size, const char *text)
+{
+    size_t len = strlen(text);
+    if (len + 1 > size)
+    {
+        if (size > 0)
+            buffer[0] = '\0';
+        return 0;
+    }
+    memcpy(buffer, text, len + 1);
+    return len;
+}
+
+size_t DisplayNumberFormat::writeDigits(char *buffer, size_t size, size_t pos, uint64_t value, uint8_t minDigits)
+{
+    char digits[DISPLAY_NUMBER_TEXT_SIZE];
+    uint8_t count = 0;
+
+    //32 bit division is a lot cheaper than 64 bit division on the ESP32
+    while (value > 0xFFFFFFFFULL)
+    {
+        digits[count++] = '0' + (char)(value % 10);
+        value /= 10;
+    }
+    uint32_t small = (uint32_t)value;
+    do
+    {
+        digits[count++] = '0' + (char)(small % 10);
+        small /= 10;
+    } while (small > 0);
+
+    while (count < minDigits)
+        digits[count++] = '0';
+
+    if (pos + count + 1 > size)
+        return 0;
+
+    while (count > 0)
+        buffer[pos++] = digits[--count];
+
+    return pos;
+}
+
+size_t DisplayNumberFormat::formatInteger(char *buffer, size_t size, int32_t value)
+{
+    if (size == 0)
+        return 0;
+
+    size_t pos = 0;
+    uint32_t magnitude = (uint32_t)value;
+    if (value < 0)
+    {
+        buffer[pos++] = '-';
+        magnitude = 0 - magnitude;
+    }
+
+    pos = writeDigits(buffer, size, pos, magnitude, 1);
+    if (pos == 0)
+    {
+        buffer[0] = '\0';
+        return 0;
+    }
+    buffer[pos] = '\0';
+    return pos;
+}
+
+size_t DisplayNumberFormat::format(char *buffer, size_t size, double value, uint8_t precision, bool trimZeros)
+{
+    if (size == 0)
+        return 0;
+
+    if (isnan(value))
+        return copyText(buffer, size, "nan");
+
+    if (isinf(value))
+        return copyText(buffer, size, value < 0 ? "-inf" : "inf");
+
+    if (precision > DISPLAY_NUMBER_MAX_PRECISION)
+        precision = DISPLAY_NUMBER_MAX_PRECISION;
+
+    //whole numbers which fit in 32 bits need no fixed point math
+    if ((precision == 0 || trimZeros) && value >= -2147483647.0 && value <= 2147483647.0)
+    {
+        int32_t whole = (int32_t)value;
+        if ((double)whole == value)
+            return formatInteger(buffer, size, whole);
+    }
+
+    bool negative = value < 0;
+    if (negative)
+        value = -value;
+
+    //a double holds about 17 significant digits, decimals past them would be noise, so decimals are dropped
+    //until the fixed point number has no more. Numbers which do not fit in 64 bits even without decimals
+    //are written with an exponent.
+    double scaled = (value * powersOfTen[precision]) + 0.5;
+    while (scaled >= 1e17 && precision > 0)
+    {
+        precision--;
+        scaled = (value * powersOfTen[precision]) + 0.5;
+    }
+    if (scaled >= 18446744073709551615.0)
+        return writeExponent(buffer, size, negative, value, trimZeros);
+
+    return writeFixed(buffer, size, negative, (uint64_t)scaled, precision, trimZeros);
+}
+
+size_t DisplayNumberFormat::writeExponent(char *buffer, size_t size, bool negative, double value, bool trimZeros)
+{
+    //value is at least 1.8e19 here, so the exponent is positive
+    int exponent = (int)floor(log10(value));
+    double mantissa = value / pow(10.0, exponent);
+    uint64_t fixedPoint = (uint64_t)((mantissa * powersOfTen[DISPLAY_NUMBER_EXPONENT_PRECISION]) + 0.5);
+
+    //rounding can carry the mantissa up to 10
+    if (fixedPoint >= 10ULL * powersOfTen[DISPLAY_NUMBER_EXPONENT_PRECISION])
+    {
+        fixedPoint /= 10;
+        exponent++;
+    }
+
+    size_t pos = writeFixed(buffer, size, negative, fixedPoint, DISPLAY_NUMBER_EXPONENT_PRECISION, trimZeros);
+    if (pos == 0 || pos + 2 >= size)
+    {
+        buffer[0] = '\0';
+        return 0;
+    }
+
+    buffer[pos++] = 'e';
+    buffer[pos++] = '+';
+    pos = writeDigits(buffer, size, pos, exponent, 2);
+    if (pos == 0)
+    {
+        buffer[0] = '\0';
+        return 0;
+    }
+    buffer[pos] = '\0';
+    return pos;
+}
+
+size_t DisplayNumberFormat::writeFixed(char *buffer, size_t size, bool negative, uint64_t fixedPoint, uint8_t precision, bool trimZeros)
+{
+    uint32_t scale = powersOfTen[precision];
+    uint64_t whole;
+    uint32_t fraction;
+    if (fixedPoint <= 0xFFFFFFFFULL)
+    {
+        whole = (uint32_t)fixedPoint / scale;
+        fraction = (uint32_t)fixedPoint % scale;
+    }
+    else
+    {
+        whole = fixedPoint / scale;
+        fraction = (uint32_t)(fixedPoint % scale);
+    }
+
+    size_t pos = 0;
+    if (negative && fixedPoint > 0)
+        buffer[pos++] = '-';
+
+    pos = writeDigits(buffer, size, pos, whole, 1);
+    if (pos == 0)
+    {
+        buffer[0] = '\0';
+        return 0;
+    }
+
+    uint8_t decimals = precision;
+    if (trimZeros)
+    {
+        while (decimals > 0 && fraction % 10 == 0)
+        {
+            fraction /= 10;
+            decimals--;
+        }
+    }
+
+    if (decimals > 0)
+    {
+        if (pos + 1 >= size)
+        {
+            buffer[0] = '\0';
+            return 0;
+        }
+        buffer[pos++] = '.';
+        pos = writeDigits(buffer, size, pos, fraction, decimals);
+        if (pos == 0)
+        {
+            buffer[0] = '\0';
+            return 0;
+        }
+    }
+
+    buffer[pos] = '\0';
+    return pos;
+}
+
+size_t DisplayNumberFormat::formatFixed(char *buffer, size_t size, int32_t value, uint8_t decimals, bool trimZeros)
+{
+    if (size == 0)
+        return 0;
+
+    if (decimals == 0)
+        return formatInteger(buffer, size, value);
+
+    if (decimals > DISPLAY_NUMBER_MAX_PRECISION)
+        decimals = DISPLAY_NUMBER_MAX_PRECISION;
+
+    uint32_t magnitude = (uint32_t)value;
+    if (value < 0)
+        magnitude = 0 - magnitude;
+    return writeFixed(buffer, size, value < 0, magnitude, decimals, trimZeros);
+}
+
+size_t DisplayNumberFormat::formatFloat(char *buffer, size_t size, float value, uint8_t precision, bool trimZeros)
+{
+    if (size == 0)
+        return 0;
+
+    if (precision > DISPLAY_NUMBER_MAX_PRECISION)
+        precision = DISPLAY_NUMBER_MAX_PRECISION;
+
+    bool negative = value < 0;
+    float scaled = ((negative ? -value : value) * (float)powersOfTen[precision]) + 0.5f;
+
+    //nan, inf and numbers too big for 32 bits are left to the double version
+    if (!(scaled < 4294967040.0f))
+        return format(buffer, size, (double)value, precision, trimZeros);
+
+    return writeFixed(buffer, size, negative, (uint32_t)scaled, precision, trimZeros);
+}
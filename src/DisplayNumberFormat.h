@@ -0,0 +1,89 @@
+#ifndef DISPLAYNUMBERFORMAT_H
+#define DISPLAYNUMBERFORMAT_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Size of a buffer big enough for any number DisplayNumberFormat writes, including the terminating zero.
+ *
+ */
+#define DISPLAY_NUMBER_TEXT_SIZE 24
+
+/**
+ * @brief The largest number of decimals DisplayNumberFormat will write.
+ *
+ */
+#define DISPLAY_NUMBER_MAX_PRECISION 9
+
+/**
+ * @brief Decimals written for numbers too large for fixed point, which are written with an exponent like "2.5e+20".
+ *
+ */
+#define DISPLAY_NUMBER_EXPONENT_PRECISION 6
+
+/**
+ * @brief Converts numbers to text without using the heap.
+ *
+ * The value is rounded to a fixed point integer and written digit by digit into the callers buffer,
+ * so formatting a value on every refresh does not create any String objects.
+ *
+ */
+class DisplayNumberFormat
+{
+private:
+    static size_t writeDigits(char *buffer, size_t size, size_t pos, uint64_t value, uint8_t minDigits);
+    static size_t writeFixed(char *buffer, size_t size, bool negative, uint64_t fixedPoint, uint8_t precision, bool trimZeros);
+    static size_t writeExponent(char *buffer, size_t size, bool negative, double value, bool trimZeros);
+
+public:
+    /**
+     * @brief Writes a number with a given number of decimals to a buffer.
+     * Decimals beyond the 17 significant digits a double holds are not written,
+     * and numbers of 1.8e19 and above are written with an exponent.
+     *
+     * @code .cpp
+     * char text[DISPLAY_NUMBER_TEXT_SIZE];
+     * DisplayNumberFormat::format(text, sizeof(text), 22.970, 3);        // "22.97"
+     * DisplayNumberFormat::format(text, sizeof(text), 22.970, 3, false); // "22.970"
+     * DisplayNumberFormat::format(text, sizeof(text), 123.0, 2);         // "123"
+     * @endcode
+     *
+     * @param buffer Where to write the text
+     * @param size Size of the buffer, DISPLAY_NUMBER_TEXT_SIZE is always big enough
+     * @param value The number to write
+     * @param precision Number of decimals, at most DISPLAY_NUMBER_MAX_PRECISION
+     * @param trimZeros Should ending zeros in the decimals and an ending dot be removed
+     * @return size_t Length of the text written, 0 if the buffer was too small.
+     */
+    static size_t format(char *buffer, size_t size, double value, uint8_t precision = 2, bool trimZeros = true);
+
+    /**
+     * @brief Writes a whole number to a buffer
+     *
+     * @return size_t Length of the text written, 0 if the buffer was too small.
+     */
+    static size_t formatInteger(char *buffer, size_t size, int32_t value);
+
+    /**
+     * @brief Writes a fixed point number, a whole number counting parts of one, to a buffer using only integer math
+     *
+     * @code .cpp
+     * DisplayNumberFormat::formatFixed(text, sizeof(text), 2297, 2); // "22.97"
+     * DisplayNumberFormat::formatFixed(text, sizeof(text), -5, 1);   // "-0.5"
+     * @endcode
+     *
+     * @param value The number multiplied by 10 to the power of decimals
+     * @param decimals How many of the digits of value are decimals
+     * @return size_t Length of the text written, 0 if the buffer was too small.
+     */
+    static size_t formatFixed(char *buffer, size_t size, int32_t value, uint8_t decimals, bool trimZeros = false);
+
+    /**
+     * @brief Writes a float to a buffer with single precision math, which the ESP32 does in hardware
+     *
+     * @return size_t Length of the text written, 0 if the buffer was too small.
+     */
+    static size_t formatFloat(char *buffer, size_t size, float value, uint8_t precision = 2, bool trimZeros = true);
+};
+
+#endif
@@ -0,0 +1,352 @@
+#include "DisplayNumericEntry.h"
+#include "DisplayMenu.h"
+
+static const double entryPowersOfTen[DISPLAY_NUMERIC_ENTRY_SIZE] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8,
+    1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17};
+
+DisplayNumericEntry::DisplayNumericEntry(TFT_eSPI *tft,
+                                         DisplayPage *page,
+                                         int16_t x,
+                                         int16_t y,
+                                         uint16_t width,
+                                         uint16_t height,
+                                         uint16_t outlineColor,
+                                         uint16_t fillColor,
+                                         uint16_t textColor,
+                                         uint8_t textsize) : DisplayWidget(tft, page, x, y, width, height)
+{
+    _outlineColor = outlineColor;
+    _fillColor = fillColor;
+    _textColor = textColor;
+    _textsize = textsize;
+    _textAlign = ALIGN_LEFT;
+    _xDatumOffset = 10;
+    _yDatumOffset = -4;
+    _allowDecimal = true;
+    _allowMinus = true;
+    _pLinkedValue = NULL;
+    _cellWidth = -1;
+    strcpy(_text, "0");
+    _drawnText[0] = '\0';
+}
+
+void DisplayNumericEntry::setLinkToValue(double *pLinkedValue, String valueName)
+{
+    _pLinkedValue = pLinkedValue;
+    _linkedValueName = valueName;
+}
+
+void DisplayNumericEntry::setTextAlign(TextAlign textAlign, int16_t xDatumOffset, int16_t yDatumOffset)
+{
+    _textAlign = textAlign;
+    _xDatumOffset = xDatumOffset;
+    _yDatumOffset = yDatumOffset;
+}
+
+void DisplayNumericEntry::setText(const char *text)
+{
+    strncpy(_text, text, DISPLAY_NUMERIC_ENTRY_SIZE - 1);
+    _text[DISPLAY_NUMERIC_ENTRY_SIZE - 1] = '\0';
+}
+
+uint8_t DisplayNumericEntry::digitCount()
+{
+    //leading zeros are not significant
+    uint8_t count = 0;
+    bool leading = true;
+    for (const char *p = _text; *p; p++)
+    {
+        if (*p < '0' || *p > '9')
+            continue;
+        if (leading && *p == '0')
+            continue;
+        leading = false;
+        count++;
+    }
+    return count;
+}
+
+bool DisplayNumericEntry::pressKey(char key)
+{
+    uint8_t len = length();
+    bool negative = _text[0] == '-';
+    char *pDigits = negative ? _text + 1 : _text;
+    bool zeroOnly = strcmp(pDigits, "0") == 0;
+
+    switch (key)
+    {
+    case '0':
+    case '1':
+    case '2':
+    case '3':
+    case '4':
+    case '5':
+    case '6':
+    case '7':
+    case '8':
+    case '9':
+        if (zeroOnly)
+        {
+            //no leading zeros, the digit replaces the zero
+            if (key == '0')
+                return false;
+            pDigits[0] = key;
+            return true;
+        }
+        if (len + 1 >= DISPLAY_NUMERIC_ENTRY_SIZE || digitCount() >= DISPLAY_NUMERIC_ENTRY_MAX_DIGITS)
+            return false;
+        _text[len] = key;
+        _text[len + 1] = '\0';
+        return true;
+
+    case '.':
+        if (!_allowDecimal || strchr(_text, '.') || len + 1 >= DISPLAY_NUMERIC_ENTRY_SIZE)
+            return false;
+        _text[len] = key;
+        _text[len + 1] = '\0';
+        return true;
+
+    case '-':
+        if (!_allowMinus)
+            return false;
+        if (negative)
+        {
+            memmove(_text, _text + 1, len);
+            return true;
+        }
+        if (zeroOnly || len + 1 >= DISPLAY_NUMERIC_ENTRY_SIZE)
+            return false;
+        memmove(_text + 1, _text, len + 1);
+        _text[0] = '-';
+        return true;
+
+    case 'D': //Delete
+        if (len <= 1 || (negative && len <= 2))
+        {
+            if (strcmp(_text, "0") == 0)
+                return false;
+            setText("0");
+            return true;
+        }
+        _text[len - 1] = '\0';
+        return true;
+
+    case 'R': //Reset
+        if (strcmp(_text, "0") == 0)
+            return false;
+        setText("0");
+        return true;
+    }
+    return false;
+}
+
+double DisplayNumericEntry::getValue()
+{
+    uint64_t mantissa = 0;
+    int8_t decimals = -1;
+    for (const char *p = _text; *p; p++)
+    {
+        if (*p == '.')
+        {
+            decimals = 0;
+        }
+        else if (*p >= '0' && *p <= '9')
+        {
+            mantissa = (mantissa * 10) + (*p - '0');
+            if (decimals > -1)
+                decimals++;
+        }
+    }
+
+    //both numbers are exact in a double, so the division gives the closest double to the typed text
+    double value = (double)mantissa;
+    if (decimals > 0)
+        value /= entryPowersOfTen[decimals];
+
+    return _text[0] == '-' ? -value : value;
+}
+
+/**
+ * @brief Is the text a number the entry can hold and getValue can read back,
+ * only digits, a decimal point and a leading minus, with no more significant digits than are allowed.
+ */
+static bool isEntryText(const char *text, size_t len)
+{
+    if (len == 0 || len >= DISPLAY_NUMERIC_ENTRY_SIZE)
+        return false;
+
+    uint8_t digits = 0;
+    bool leading = true;
+    for (size_t i = 0; i < len; i++)
+    {
+        char c = text[i];
+        if (c == '-' && i == 0)
+            continue;
+        if (c == '.')
+            continue;
+        if (c < '0' || c > '9')
+            return false;
+        if (leading && c == '0')
+            continue;
+        leading = false;
+        digits++;
+    }
+    return digits <= DISPLAY_NUMERIC_ENTRY_MAX_DIGITS;
+}
+
+bool DisplayNumericEntry::setValue(double value)
+{
+    char text[DISPLAY_NUMBER_TEXT_SIZE];
+    int8_t precision = _allowDecimal ? DISPLAY_NUMBER_MAX_PRECISION : 0;
+    size_t len = DisplayNumberFormat::format(text, sizeof(text), value, precision);
+
+    //drop decimals until the text fits the entry
+    while (!isEntryText(text, len) && precision > 0)
+    {
+        precision--;
+        len = DisplayNumberFormat::format(text, sizeof(text), value, precision);
+    }
+
+    //nan, inf and numbers written with an exponent can not be typed, the text is left as it is
+    if (!isEntryText(text, len))
+        return false;
+
+    setText(text);
+    return true;
+}
+
+bool DisplayNumericEntry::commit()
+{
+    if (!_pLinkedValue)
+        return false;
+
+    *_pLinkedValue = getValue();
+    return true;
+}
+
+void DisplayNumericEntry::prepareText()
+{
+    selectFont();
+    _tft->setTextColor(_textColor);
+    _tft->setTextSize(_textsize);
+    _tft->setTextDatum(ML_DATUM);
+    _tft->setTextPadding(0);
+}
+
+int16_t DisplayNumericEntry::measureCellWidth()
+{
+    //TFT_eSPI measures the last character of a text by the pixels it covers, not by how far it advances,
+    //so each character is measured in front of a '0' to get it's advance
+    const char *entryChars = "0123456789.-";
+    char pair[3] = {'0', '0', '\0'};
+    int16_t zeroWidth = _tft->textWidth(&pair[1]);
+    int16_t width = _tft->textWidth(pair) - zeroWidth;
+
+    for (const char *p = entryChars; *p; p++)
+    {
+        pair[0] = *p;
+        if (_tft->textWidth(pair) - zeroWidth != width)
+            return 0;
+    }
+    return width;
+}
+
+int32_t DisplayNumericEntry::textX(const char *text)
+{
+    int32_t width = _cellWidth > 0 ? (int32_t)strlen(text) * _cellWidth : _tft->textWidth(text);
+
+    if (_textAlign == ALIGN_CENTER)
+        return _rect.x + ((_rect.width - width) / 2) + _xDatumOffset;
+
+    if (_textAlign == ALIGN_RIGHT)
+        return _rect.x + (_rect.width - width) - _xDatumOffset;
+
+    return _rect.x + _xDatumOffset;
+}
+
+void DisplayNumericEntry::drawText()
+{
+    _tft->fillRect(_rect.x + 1, _rect.y + 1, _rect.width - 2, _rect.height - 2, _fillColor);
+    _tft->drawString(_text, textX(_text), textY());
+    strcpy(_drawnText, _text);
+}
+
+void DisplayNumericEntry::draw()
+{
+    if (!isPageVisable())
+        return;
+
+    uint16_t before_color = _tft->textcolor;
+    uint8_t  before_textSize = _tft->textsize;
+    uint8_t  before_textDatum = _tft->getTextDatum();
+    uint8_t  before_textPadding = _tft->getTextPadding();
+
+    prepareText();
+    _cellWidth = measureCellWidth();
+    _tft->drawRect(_rect.x, _rect.y, _rect.width, _rect.height, _outlineColor);
+    drawText();
+
+    _tft->setTextColor(before_color);
+    _tft->setTextSize(before_textSize);
+    _tft->setTextDatum(before_textDatum);
+    _tft->setTextPadding(before_textPadding);
+}
+
+void DisplayNumericEntry::drawChanges()
+{
+    if (_cellWidth < 0)
+    {
+        draw();
+        return;
+    }
+
+    if (!isPageVisable())
+        return;
+
+    uint16_t before_color = _tft->textcolor;
+    uint8_t  before_textSize = _tft->textsize;
+    uint8_t  before_textDatum = _tft->getTextDatum();
+    uint8_t  before_textPadding = _tft->getTextPadding();
+
+    prepareText();
+
+    int32_t oldX = textX(_drawnText),
+            newX = textX(_text),
+            oldLength = strlen(_drawnText),
+            newLength = strlen(_text);
+    int32_t start = min(oldX, newX),
+            end = max(oldX + (oldLength * _cellWidth), newX + (newLength * _cellWidth));
+
+    //Repaint cell by cell only when old and new characters line up on the same grid and stay inside the field
+    if (_cellWidth == 0 || (oldX - newX) % _cellWidth != 0 || start <= _rect.x || end >= _rect.right())
+    {
+        drawText();
+    }
+    else
+    {
+        char glyph[2] = {'\0', '\0'};
+        for (int32_t cellX = start; cellX < end; cellX += _cellWidth)
+        {
+            int32_t oldIndex = (cellX - oldX) / _cellWidth,
+                    newIndex = (cellX - newX) / _cellWidth;
+            char oldChar = cellX >= oldX && oldIndex < oldLength ? _drawnText[oldIndex] : '\0';
+            char newChar = cellX >= newX && newIndex < newLength ? _text[newIndex] : '\0';
+            if (oldChar == newChar)
+                continue;
+
+            _tft->fillRect(cellX, _rect.y + 1, _cellWidth, _rect.height - 2, _fillColor);
+            if (newChar)
+            {
+                glyph[0] = newChar;
+                _tft->drawString(glyph, cellX, textY());
+            }
+        }
+        strcpy(_drawnText, _text);
+    }
+
+    _tft->setTextColor(before_color);
+    _tft->setTextSize(before_textSize);
+    _tft->setTextDatum(before_textDatum);
+    _tft->setTextPadding(before_textPadding);
+}
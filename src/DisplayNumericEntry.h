@@ -0,0 +1,143 @@
+#ifndef DISPLAYNUMERICENTRY_H
+#define DISPLAYNUMERICENTRY_H
+
+#include <Arduino.h>
+
+#include <TFT_eSPI.h>
+
+#include "DisplayWidget.h"
+#include "DisplayNumberFormat.h"
+
+/**
+ * @brief Size of the text buffer of a numeric entry, including the terminating zero.
+ *
+ */
+#define DISPLAY_NUMERIC_ENTRY_SIZE 18
+
+/**
+ * @brief Most significant digits a numeric entry accepts, more than this can not be stored exactly in a double.
+ *
+ */
+#define DISPLAY_NUMERIC_ENTRY_MAX_DIGITS 15
+
+/**
+ * @brief A field for typing in a number with keypad buttons.
+ *
+ * The typed text is kept in a fixed size buffer inside the widget and every key is validated as it is pressed,
+ * so typing and committing a value does not use any heap memory.
+ * When the font draws all the entry characters with the same width, only the characters which changed are
+ * repainted after a key press.
+ *
+ * @code .cpp
+ * DisplayNumericEntry *pEntry = pPage->addNumericEntry(10, 1, 300, 39, TFT_WHITE, TFT_BLACK, TFT_GOLD, 1);
+ * pEntry->setLinkToValue(&myValue, "My value");
+ *
+ * void keyPressed(DisplayButton *btn)
+ * {
+ *     if (pEntry->pressKey(btn->getText().charAt(0)))
+ *         pEntry->drawChanges();
+ * }
+ * @endcode
+ */
+class DisplayNumericEntry : public DisplayWidget
+{
+private:
+    char _text[DISPLAY_NUMERIC_ENTRY_SIZE];
+    char _drawnText[DISPLAY_NUMERIC_ENTRY_SIZE];
+    uint16_t _outlineColor;
+    uint16_t _fillColor;
+    uint16_t _textColor;
+    uint8_t _textsize;
+    TextAlign _textAlign;
+    int16_t _xDatumOffset;
+    int16_t _yDatumOffset;
+    bool _allowDecimal;
+    bool _allowMinus;
+    double *_pLinkedValue;
+    String _linkedValueName;
+
+    //width of every entry character if the font draws them all with the same width,
+    //0 if it does not and -1 if the entry has not been drawn yet.
+    int16_t _cellWidth;
+
+    uint8_t length() { return strlen(_text); };
+    uint8_t digitCount();
+    void setText(const char *text);
+    void prepareText();
+    int16_t measureCellWidth();
+    int32_t textX(const char *text);
+    int32_t textY() { return _rect.y + (_rect.height / 2) + _yDatumOffset; };
+    void drawText();
+
+public:
+    DisplayNumericEntry(TFT_eSPI *tft,
+                        DisplayPage *page,
+                        int16_t x,
+                        int16_t y,
+                        uint16_t width,
+                        uint16_t height,
+                        uint16_t outlineColor,
+                        uint16_t fillColor,
+                        uint16_t textColor,
+                        uint8_t textsize);
+
+    /**
+     * @brief Handles one key from a keypad
+     *
+     * @param key '0' - '9' adds a digit, '.' adds a decimal point, '-' toggles the sign,
+     *            'D' deletes the last character and 'R' resets the entry to 0.
+     * @return true if the text changed and should be drawn
+     * @return false if the key was not allowed, for example a second decimal point
+     */
+    bool pressKey(char key);
+
+    /**
+     * @brief Writes the typed number to the linked value
+     *
+     * @return true if there is a linked value and it was updated
+     */
+    bool commit();
+
+    /**
+     * @brief Get the typed number
+     *
+     */
+    double getValue();
+
+    /**
+     * @brief Replaces the typed text with a number, with as many decimals as fit in the entry
+     *
+     * @return false if the number can not be typed in the entry, like nan or a number with more than
+     * DISPLAY_NUMERIC_ENTRY_MAX_DIGITS digits before the decimal point. The text is then not changed.
+     */
+    bool setValue(double value);
+
+    /**
+     * @brief Sets the typed text from the linked value
+     *
+     * @return false if the linked value can not be typed in the entry, the text is then not changed
+     */
+    bool load() { return setValue(_pLinkedValue ? *_pLinkedValue : 0); }
+
+    const char *getText() { return _text; };
+    void setLinkToValue(double *pLinkedValue, String valueName);
+    double *getLinkedValue() { return _pLinkedValue; };
+    String getLinkedValueName() { return _linkedValueName; };
+    void setAllowDecimal(bool allowDecimal) { _allowDecimal = allowDecimal; };
+    bool getAllowDecimal() { return _allowDecimal; };
+    void setAllowMinus(bool allowMinus) { _allowMinus = allowMinus; };
+    bool getAllowMinus() { return _allowMinus; };
+    void setTextAlign(TextAlign textAlign, int16_t xDatumOffset = 0, int16_t yDatumOffset = 0);
+
+    void draw();
+    size_t getMemorySize() { return sizeof(DisplayNumericEntry) + _linkedValueName.length() + 1; }
+    const char *getTypeName() { return "DisplayNumericEntry"; }
+
+    /**
+     * @brief Repaints only the characters which differ from what was last drawn.
+     * Falls back to repainting the text area when the font is not monospaced.
+     */
+    void drawChanges();
+};
+
+#endif
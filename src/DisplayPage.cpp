@@ -1,4 +1,5 @@
 #include "DisplayPage.h"
+#include "DisplayMenu.h"
 
 // Copy constructor
 DisplayPage::DisplayPage(const DisplayPage &page)
@@ -6,6 +7,9 @@ DisplayPage::DisplayPage(const DisplayPage &page)
 
     DisplayPage &ref = const_cast<DisplayPage &>(page);
     init(ref._tft, ref._pMenu, ref._fillColor);
+    _onBuildDisplayPage = ref._onBuildDisplayPage;
+    _built = ref._built;
+    _pinned = ref._pinned;
     int buttonCount = ref.buttonCount();
     DisplayButton *pBtn;
 
@@ -21,29 +25,126 @@ DisplayPage::DisplayPage(TFT_eSPI *tft, DisplayMenu *menu, uint16_t fillColor)
     init(tft, menu, fillColor);
 }
 
+DisplayPage::~DisplayPage()
+{
+    freeLayout();
+}
+
 void DisplayPage::init(TFT_eSPI *tft, DisplayMenu *menu, uint16_t fillColor)
 {
     _tft = tft;
     _fillColor = fillColor;
-    _onDrawDisplayPage = NULL;
-    _onShowDisplayPage = NULL;
+    _onDrawDisplayPage = DisplayPageDelegate();
+    _onShowDisplayPage = DisplayPageDelegate();
+    _onBuildDisplayPage = DisplayPageDelegate();
+    _built = true;
+    _pinned = false;
+    memset(&_buildMemory, 0, sizeof(_buildMemory));
+    _lastShown = 0;
+    _fontGroups = 1;
+    _valuesPending = false;
+    _pCovers = NULL;
+    _pFirstCover = NULL;
+    _pSpanWork = NULL;
+    _pItemFonts = NULL;
+    _pItemRects = NULL;
+    _layoutCapacity = 0;
+    _coverCount = 0;
+    _layoutHash = 0;
+    _layoutValid = false;
     _pMenu = menu;
 }
 
+bool DisplayPage::build()
+{
+    if (_built)
+        return true;
+
+    if (!_onBuildDisplayPage)
+        return false;
+
+    _built = true;
+    uint32_t allocations = DisplayMemory::getAllocationCount();
+    _buildMemory.freeBefore = DisplayMemory::getFreeHeap();
+    _buildMemory.largestBefore = DisplayMemory::getLargestFreeBlock();
+    _onBuildDisplayPage(this);
+    _buildMemory.allocations = DisplayMemory::getAllocationCount() - allocations;
+    _buildMemory.freeAfter = DisplayMemory::getFreeHeap();
+    _buildMemory.largestAfter = DisplayMemory::getLargestFreeBlock();
+    return true;
+}
+
+bool DisplayPage::release()
+{
+    if (!_onBuildDisplayPage || !_built)
+        return false;
+
+    widgets.removeAll();
+    buttons.removeAll();
+    labels.removeAll();
+    freeLayout();
+    _built = false;
+    return true;
+}
+
+size_t DisplayPage::getItemMemory()
+{
+    DISPLAY_PAGE_MEMORY report;
+    getMemoryReport(&report);
+    return report.total;
+}
+
+void DisplayPage::getMemoryReport(DISPLAY_PAGE_MEMORY *pReport)
+{
+    memset(pReport, 0, sizeof(DISPLAY_PAGE_MEMORY));
+
+    pReport->buttonCount = buttonCount();
+    for (int i = 0; i < pReport->buttonCount; i++)
+    {
+        DisplayButton *btn = buttons.get(i);
+        pReport->buttons += sizeof(ListNode<DisplayButton *>) + sizeof(DisplayButton);
+        pReport->strings += btn->_values.text.length() + 1 + btn->_values.linkedValueName.length() + 1;
+    }
+
+    pReport->labelCount = labelCount();
+    for (int i = 0; i < pReport->labelCount; i++)
+    {
+        DisplayLabel *lbl = labels.get(i);
+        pReport->labels += sizeof(ListNode<DisplayLabel *>) + sizeof(DisplayLabel);
+        pReport->strings += lbl->_values.text.length() + 1 + lbl->_values.linkedValueName.length() + 1;
+    }
+
+    pReport->widgetCount = widgetCount();
+    for (int i = 0; i < pReport->widgetCount; i++)
+        pReport->widgets += sizeof(ListNode<DisplayWidget *>) + widgets.get(i)->getMemorySize();
+
+    if (_pCovers)
+    {
+        int maxCovers = _layoutCapacity * 2;
+        pReport->layout = (sizeof(DisplayRect) * (maxCovers + 1)) + (sizeof(int) * (_layoutCapacity + 1)) +
+                          (sizeof(int32_t) * DisplayRect::getSubtractWorkSize(maxCovers)) +
+                          ((sizeof(DisplayFont *) + sizeof(DisplayRect)) * (_layoutCapacity + 1));
+    }
+
+    pReport->total = pReport->buttons + pReport->labels + pReport->widgets + pReport->strings + pReport->layout;
+}
+
 
 
 DisplayButton *DisplayPage::addButton(const DisplayButton button)
 {
-    if (buttons.add(button))
-        return getLastButton();
-    return NULL;
+    if (!buttons.add(button))
+        return NULL;
+    itemsChanged();
+    return getLastButton();
 }
 
 DisplayLabel *DisplayPage::addLabel(const DisplayLabel label)
 {
-    if (labels.add(label))
-        return getLastLabel();
-    return NULL;
+    if (!labels.add(label))
+        return NULL;
+    itemsChanged();
+    return getLastLabel();
 }
 
 DisplayButton *DisplayPage::addPageButton(int16_t x, 
@@ -63,9 +164,7 @@ DisplayButton *DisplayPage::addPageButton(int16_t x,
     DisplayButton pageButton(getDisplay(), x, y, width, height, outlineColor, fillColor, textColor, textsize, text, DisplayButtonType::OPEN_PAGE, this, pPageToOpen, NULL);
     pageButton.setTextAlign(textAlign);
     
-    if (buttons.add(pageButton))
-        return getLastButton();
-    return NULL;
+    return addButton(pageButton);
 }
 
 DisplayButton *DisplayPage::addFunctionButton(int16_t x, 
@@ -77,14 +176,12 @@ DisplayButton *DisplayPage::addFunctionButton(int16_t x,
                             uint16_t textColor,
                             uint8_t textsize, 
                             const char *text,
-                            ButtonPressedFunction buttonPressedFunction
+                            DisplayButtonDelegate buttonPressedFunction
                             )
 {
 
     DisplayButton functionButton(getDisplay(), x, y, width, height, outlineColor, fillColor, textColor, textsize, text, DisplayButtonType::RUN_FUNCTION, this, NULL, buttonPressedFunction);
-    if (buttons.add(functionButton))
-        return getLastButton();
-    return NULL;
+    return addButton(functionButton);
 }
 
 DisplayButton *DisplayPage::addIncrementButton(   int16_t x,
@@ -102,8 +199,92 @@ DisplayButton *DisplayPage::addIncrementButton(   int16_t x,
 {
 
     DisplayButton incrementButton(getDisplay(), x, y, width, height, outlineColor, fillColor, textColor, textsize, text, DisplayButtonType::INCREMENT_VALUE, this, pLinkedValue, incrementValue);
-    if (buttons.add(incrementButton))
-        return getLastButton();
+    return addButton(incrementButton);
+}
+
+DisplayButton *DisplayPage::addIncrementButton(   int16_t x,
+                                        int16_t y,
+                                        uint16_t width,
+                                        uint16_t height,
+                                        uint16_t outlineColor,
+                                        uint16_t fillColor,
+                                        uint16_t textColor,
+                                        uint8_t textsize, 
+                                        const char *text,
+                                        DisplayValue *pBinding,
+                                        int16_t steps
+                ) 
+{
+
+    DisplayButton incrementButton(getDisplay(), x, y, width, height, outlineColor, fillColor, textColor, textsize, text, DisplayButtonType::INCREMENT_VALUE, this, (double *)NULL, 0);
+    incrementButton.setBinding(pBinding, steps);
+    return addButton(incrementButton);
+}
+
+DisplayNumericEntry *DisplayPage::addNumericEntry(int16_t x,
+                                                  int16_t y,
+                                                  uint16_t width,
+                                                  uint16_t height,
+                                                  uint16_t outlineColor,
+                                                  uint16_t fillColor,
+                                                  uint16_t textColor,
+                                                  uint8_t textsize)
+{
+    DisplayNumericEntry *pEntry = new DisplayNumericEntry(getDisplay(), this, x, y, width, height, outlineColor, fillColor, textColor, textsize);
+    return (DisplayNumericEntry *)addWidget(pEntry);
+}
+
+DisplayList *DisplayPage::addList(int16_t x,
+                                  int16_t y,
+                                  uint16_t width,
+                                  uint16_t height,
+                                  uint16_t rowHeight,
+                                  uint16_t fillColor,
+                                  uint16_t textColor,
+                                  uint16_t lineColor,
+                                  uint8_t textsize)
+{
+    DisplayList *pList = new DisplayList(getDisplay(), this, x, y, width, height, rowHeight, fillColor, textColor, lineColor, textsize);
+    return (DisplayList *)addWidget(pList);
+}
+
+DisplayChart *DisplayPage::addChart(int16_t x,
+                                    int16_t y,
+                                    uint16_t width,
+                                    uint16_t height,
+                                    uint16_t outlineColor,
+                                    uint16_t fillColor,
+                                    uint16_t lineColor,
+                                    uint16_t samplesPerColumn)
+{
+    DisplayChart *pChart = new DisplayChart(getDisplay(), this, x, y, width, height, outlineColor, fillColor, lineColor, samplesPerColumn);
+    return (DisplayChart *)addWidget(pChart);
+}
+
+DisplayBar *DisplayPage::addBar(int16_t x,
+                                int16_t y,
+                                uint16_t width,
+                                uint16_t height,
+                                uint16_t textWidth,
+                                uint16_t outlineColor,
+                                uint16_t fillColor,
+                                uint16_t barColor,
+                                uint16_t textColor,
+                                uint8_t textsize)
+{
+    DisplayBar *pBar = new DisplayBar(getDisplay(), this, x, y, width, height, textWidth, outlineColor, fillColor, barColor, textColor, textsize);
+    return (DisplayBar *)addWidget(pBar);
+}
+
+DisplayWidget *DisplayPage::addWidget(DisplayWidget *pWidget)
+{
+    if (pWidget && widgets.add(pWidget))
+    {
+        itemsChanged();
+        return pWidget;
+    }
+
+    delete pWidget;
     return NULL;
 }
 
@@ -120,54 +301,727 @@ DisplayLabel *DisplayPage::addPageLabel(int16_t x,
 {
     DisplayLabel pageLabel(getDisplay(), x, y, width, height, outlineColor, fillColor, textColor, textsize, text, this);
     pageLabel.setTextAlign(textAlign);
-        if (labels.add(pageLabel))
-        return getLastLabel();
-    return NULL;
+    return addLabel(pageLabel);
 }
 
-void DisplayPage::drawButtons()
+void DisplayPage::drawButtons(int8_t fontGroup)
 {
     int count = buttonCount();
     for (int i = 0; i < count; i++)
     {
         DisplayButton *btn = buttons.get(i);
+        if (!isInFontGroup(btn->getFont(), fontGroup))
+            continue;
         btn->resetPressState();
-        btn->draw();
+        if (!btn->isOccluded())
+            btn->draw();
     }
 }
 
-void DisplayPage::drawLabels()
+void DisplayPage::drawLabels(int8_t fontGroup)
 {
     int count = labelCount();
     for (int i = 0; i < count; i++)
     {
         DisplayLabel *lbl = labels.get(i);
+        if (!isInFontGroup(lbl->getFont(), fontGroup))
+            continue;
         lbl->resetPressState();
-        lbl->draw();
+        if (!lbl->isOccluded())
+            lbl->draw();
+    }
+}
+
+void DisplayPage::drawWidgets(int8_t fontGroup)
+{
+    int count = widgetCount();
+    for (int i = 0; i < count; i++)
+    {
+        DisplayWidget *widget = widgets.get(i);
+        if (!widget->isOccluded() && isInFontGroup(widget->getFont(), fontGroup))
+            widget->draw();
+    }
+}
+
+bool DisplayPage::isInFontGroup(DisplayFont *pFont, int8_t fontGroup)
+{
+    if (fontGroup < 0 || _fontGroups < 2 || !_pMenu)
+        return true;
+    return _pMenu->resolveFont(pFont) == _groupFonts[fontGroup];
+}
+
+void DisplayPage::updateFontGroups()
+{
+    _fontGroups = 1;
+    if (!_pMenu)
+        return;
+
+    int labelCount = this->labelCount(),
+        buttonCount = this->buttonCount(),
+        widgetStart = labelCount + buttonCount,
+        itemCount = widgetStart + widgetCount();
+
+    //the font and rect of every item which is drawn, NULL fonts for items which are not
+    DisplayFont **pFonts = _pItemFonts;
+    DisplayRect *pRects = _pItemRects;
+    uint8_t groups = 0;
+    bool grouped = true;
+
+    for (int i = 0; i < itemCount && grouped; i++)
+    {
+        pFonts[i] = NULL;
+        if (i < labelCount)
+        {
+            DisplayLabel *lbl = labels.get(i);
+            if (lbl->_values.state == VISABLE && !lbl->isOccluded())
+                pFonts[i] = _pMenu->resolveFont(lbl->getFont());
+            pRects[i] = lbl->getRect();
+        }
+        else if (i < widgetStart)
+        {
+            DisplayButton *btn = buttons.get(i - labelCount);
+            if (btn->_values.state == VISABLE && !btn->isOccluded())
+                pFonts[i] = _pMenu->resolveFont(btn->getFont());
+            pRects[i] = btn->getRect();
+        }
+        else
+        {
+            DisplayWidget *widget = widgets.get(i - widgetStart);
+            if (widget->getState() == VISABLE && !widget->isOccluded())
+                pFonts[i] = _pMenu->resolveFont(widget->getFont());
+            pRects[i] = widget->getRect();
+        }
+
+        if (pFonts[i] == NULL)
+            continue;
+
+        uint8_t group = 0;
+        while (group < groups && _groupFonts[group] != pFonts[i])
+            group++;
+        if (group < groups)
+            continue;
+
+        if (groups == DISPLAY_PAGE_FONT_GROUPS)
+            grouped = false;
+        else
+            _groupFonts[groups++] = pFonts[i];
+    }
+
+    //items with different fonts which overlap must be drawn in their order
+    for (int i = 0; i < itemCount && grouped && groups > 1; i++)
+    {
+        for (int j = i + 1; j < itemCount && grouped && pFonts[i]; j++)
+        {
+            if (pFonts[j] && pFonts[j] != pFonts[i] && pRects[i].intersects(pRects[j]))
+                grouped = false;
+        }
+    }
+
+    if (grouped && groups > 1)
+        _fontGroups = groups;
+}
+
+void DisplayPage::selectDefaultFont(TFT_eSPI *pTarget)
+{
+    if (!_pMenu)
+        pTarget->setFreeFont(&FreeMonoBold9pt7b);
+}
+
+void DisplayPage::callDrawEvent()
+{
+    if (!_onDrawDisplayPage)
+        return;
+
+    _onDrawDisplayPage(this);
+    if (_pMenu)
+        _pMenu->forgetFont();
+}
+
+bool DisplayPage::touchWidgets(uint16_t x, uint16_t y, bool pressed)
+{
+    int count = widgetCount();
+    for (int i = count - 1; i >= 0; i--)
+    {
+        //the widget drawn last is on top
+        DisplayWidget *widget = widgets.get(i);
+        if (widget->getState() == VISABLE && widget->touch(x, y, pressed))
+            return true;
+    }
+    return false;
+}
+
+void DisplayPage::hideWidgets()
+{
+    int count = widgetCount();
+    for (int i = 0; i < count; i++)
+        widgets.get(i)->pageHidden();
+}
+
+int DisplayPage::addOpaqueRects(DisplayRect *pRects, DisplayRect rect, uint8_t radius)
+{
+    //a rounded rect does not cover it's corners, but it does cover a horizontal and a vertical core.
+    if (radius == 0)
+    {
+        pRects[0] = rect;
+        return 1;
+    }
+    pRects[0] = DisplayRect(rect.x, rect.y + radius, rect.width, rect.height - (2 * radius));
+    pRects[1] = DisplayRect(rect.x + radius, rect.y, rect.width - (2 * radius), rect.height);
+    return 2;
+}
+
+void DisplayPage::fillBackgroundSpan(const DisplayRect &span, void *pContext)
+{
+    DisplayPage *pPage = (DisplayPage *)pContext;
+    pPage->_tft->fillRect(span.x, span.y, span.width, span.height, pPage->_fillColor);
+}
+
+void DisplayPage::reserveLayout(int itemCount)
+{
+    if (_pCovers && itemCount <= _layoutCapacity)
+        return;
+
+    //grown in steps, so adding items one at a time does not allocate for every item
+    uint16_t capacity = _layoutCapacity ? _layoutCapacity : 8;
+    while (capacity < itemCount)
+        capacity *= 2;
+
+    freeLayout();
+    int maxCovers = capacity * 2;
+    _pCovers = new DisplayRect[maxCovers + 1];
+    _pFirstCover = new int[capacity + 1];
+    _pSpanWork = new int32_t[DisplayRect::getSubtractWorkSize(maxCovers)];
+    _pItemFonts = new DisplayFont *[capacity + 1];
+    _pItemRects = new DisplayRect[capacity + 1];
+    _layoutCapacity = capacity;
+}
+
+void DisplayPage::freeLayout()
+{
+    delete[] _pCovers;
+    delete[] _pFirstCover;
+    delete[] _pSpanWork;
+    delete[] _pItemFonts;
+    delete[] _pItemRects;
+    _pCovers = NULL;
+    _pFirstCover = NULL;
+    _pSpanWork = NULL;
+    _pItemFonts = NULL;
+    _pItemRects = NULL;
+    _layoutCapacity = 0;
+    _coverCount = 0;
+    _layoutValid = false;
+}
+
+void DisplayPage::itemsChanged()
+{
+    reserveLayout(labelCount() + buttonCount() + widgetCount());
+    _layoutValid = false;
+}
+
+uint32_t DisplayPage::getLayoutHash()
+{
+    int count = labelCount();
+    uint32_t hash = hashBytes(2166136261UL, &count, sizeof(count));
+    for (int i = 0; i < count; i++)
+    {
+        DisplayLabel *lbl = labels.get(i);
+        DisplayRect rect = lbl->getRect();
+        int32_t layout[] = {rect.x, rect.y, rect.width, rect.height, lbl->_values.state, lbl->getRadius()};
+        hash = hashBytes(hash, layout, sizeof(layout));
+        DisplayFont *pFont = _pMenu ? _pMenu->resolveFont(lbl->getFont()) : NULL;
+        hash = hashBytes(hash, &pFont, sizeof(pFont));
+    }
+
+    count = buttonCount();
+    hash = hashBytes(hash, &count, sizeof(count));
+    for (int i = 0; i < count; i++)
+    {
+        DisplayButton *btn = buttons.get(i);
+        DisplayRect rect = btn->getRect();
+        int32_t layout[] = {rect.x, rect.y, rect.width, rect.height, btn->_values.state, btn->getRadius()};
+        hash = hashBytes(hash, layout, sizeof(layout));
+        DisplayFont *pFont = _pMenu ? _pMenu->resolveFont(btn->getFont()) : NULL;
+        hash = hashBytes(hash, &pFont, sizeof(pFont));
+    }
+
+    count = widgetCount();
+    hash = hashBytes(hash, &count, sizeof(count));
+    for (int i = 0; i < count; i++)
+    {
+        DisplayWidget *widget = widgets.get(i);
+        DisplayRect rect = widget->getRect();
+        int32_t layout[] = {rect.x, rect.y, rect.width, rect.height, widget->getState(), widget->isOpaque()};
+        hash = hashBytes(hash, layout, sizeof(layout));
+        DisplayFont *pFont = _pMenu ? _pMenu->resolveFont(widget->getFont()) : NULL;
+        hash = hashBytes(hash, &pFont, sizeof(pFont));
+    }
+    return hash;
+}
+
+void DisplayPage::updateOcclusion(bool fillBackground)
+{
+    int labelCount = this->labelCount(),
+        buttonCount = this->buttonCount(),
+        widgetStart = labelCount + buttonCount,
+        itemCount = widgetStart + widgetCount();
+
+    //items are only added through the page, so the buffers already fit them unless the page is empty
+    reserveLayout(itemCount);
+    uint32_t hash = getLayoutHash();
+    if (!_layoutValid || hash != _layoutHash)
+    {
+        //Items are drawn labels first, then buttons and then widgets, so an item can only be covered by items after it.
+        //firstCover[i] is the index of the first opaque rect belonging to item i or any item after it.
+        int coverCount = 0;
+        for (int i = 0; i < itemCount; i++)
+        {
+            _pFirstCover[i] = coverCount;
+            if (i < labelCount)
+            {
+                DisplayLabel *lbl = labels.get(i);
+                if (lbl->_values.state == VISABLE)
+                    coverCount += addOpaqueRects(&_pCovers[coverCount], lbl->getRect(), lbl->getRadius());
+            }
+            else if (i < widgetStart)
+            {
+                DisplayButton *btn = buttons.get(i - labelCount);
+                if (btn->_values.state == VISABLE)
+                    coverCount += addOpaqueRects(&_pCovers[coverCount], btn->getRect(), btn->getRadius());
+            }
+            else
+            {
+                DisplayWidget *widget = widgets.get(i - widgetStart);
+                if (widget->getState() == VISABLE && widget->isOpaque())
+                    coverCount += addOpaqueRects(&_pCovers[coverCount], widget->getRect(), 0);
+            }
+        }
+        _pFirstCover[itemCount] = coverCount;
+
+        for (int i = 0; i < itemCount; i++)
+        {
+            int first = _pFirstCover[i + 1];
+            const DisplayRect *pCovers = &_pCovers[first];
+            if (i < labelCount)
+            {
+                DisplayLabel *lbl = labels.get(i);
+                lbl->setOccluded(DisplayRect::subtract(lbl->getRect(), pCovers, coverCount - first, NULL, NULL, _pSpanWork) == 0);
+            }
+            else if (i < widgetStart)
+            {
+                DisplayButton *btn = buttons.get(i - labelCount);
+                btn->setOccluded(DisplayRect::subtract(btn->getRect(), pCovers, coverCount - first, NULL, NULL, _pSpanWork) == 0);
+            }
+            else
+            {
+                DisplayWidget *widget = widgets.get(i - widgetStart);
+                widget->setOccluded(DisplayRect::subtract(widget->getRect(), pCovers, coverCount - first, NULL, NULL, _pSpanWork) == 0);
+            }
+        }
+        _coverCount = coverCount;
+        _layoutHash = hash;
+        _layoutValid = true;
+        updateFontGroups();
+    }
+
+    if (fillBackground)
+    {
+        DisplayRect screen(0, 0, _tft->width(), _tft->height());
+        DisplayRect::subtract(screen, _pCovers, _coverCount, fillBackgroundSpan, this, _pSpanWork);
     }
 }
 
 void DisplayPage::draw(bool wipeScreen) {
     
-    if (wipeScreen)
-        _tft->fillScreen(_fillColor);
+    updateOcclusion(wipeScreen);
     
-    if (_onDrawDisplayPage) {
-        _onDrawDisplayPage(this);
+    //the sketch may have changed the font since the page was last drawn
+    if (_pMenu)
+        _pMenu->forgetFont();
+    callDrawEvent();
+
+    //one font at a time, so each font is selected once
+    selectDefaultFont(_tft);
+    for (int8_t group = 0; group < _fontGroups; group++)
+    {
+        drawLabels(group);
+        drawButtons(group);
+        drawWidgets(group);
+    }
+}
+
+bool DisplayPage::isVisable()
+{
+    return !_pMenu || _pMenu->getVisablePage() == this;
+}
+
+void DisplayPage::drawArea(const DisplayRect &area)
+{
+    if (area.isEmpty())
+        return;
+
+    updateOcclusion(false);
+    redrawArea(area);
+}
+
+void DisplayPage::redrawArea(const DisplayRect &area)
+{
+    //the viewport only clips, item coordinates stay relative to the screen
+    _tft->setViewport(area.x, area.y, area.width, area.height, false);
+    _tft->fillRect(area.x, area.y, area.width, area.height, _fillColor);
+    callDrawEvent();
+
+    selectDefaultFont(_tft);
+    for (int8_t group = 0; group < _fontGroups; group++)
+    {
+        for (int i = 0; i < labelCount(); i++)
+        {
+            DisplayLabel *lbl = labels.get(i);
+            if (!lbl->isOccluded() && lbl->getRect().intersects(area) && isInFontGroup(lbl->getFont(), group))
+                lbl->draw();
+        }
+        for (int i = 0; i < buttonCount(); i++)
+        {
+            DisplayButton *btn = buttons.get(i);
+            if (!btn->isOccluded() && btn->getRect().intersects(area) && isInFontGroup(btn->getFont(), group))
+                btn->draw();
+        }
+        for (int i = 0; i < widgetCount(); i++)
+        {
+            DisplayWidget *widget = widgets.get(i);
+            if (!widget->isOccluded() && widget->getRect().intersects(area) && isInFontGroup(widget->getFont(), group))
+                widget->draw();
+        }
+    }
+    _tft->resetViewport();
+}
+
+void DisplayPage::drawStyleChanges(uint32_t since)
+{
+    //A new radius can change which items are covered and what is seen in the corners of an item,
+    //so the area of the changed items is drawn again with the background and every item overlapping it, in page order.
+    //The page draw function is called once for all the changed items, so the area is the one rectangle holding them.
+    updateOcclusion(false);
+    DisplayRect area;
+
+    int count = labelCount();
+    for (int i = 0; i < count; i++)
+    {
+        DisplayLabel *lbl = labels.get(i);
+        if (lbl->_values.state == VISABLE && !lbl->isOccluded() && lbl->getStyle()->isChangedSince(since))
+            area = area.united(lbl->getRect());
     }
 
-    _tft->setFreeFont(&FreeMonoBold9pt7b); 
-    drawLabels();
-    drawButtons();
+    count = buttonCount();
+    for (int i = 0; i < count; i++)
+    {
+        DisplayButton *btn = buttons.get(i);
+        if (btn->_values.state == VISABLE && !btn->isOccluded() && btn->getStyle()->isChangedSince(since))
+            area = area.united(btn->getRect());
+    }
+
+    if (!area.isEmpty())
+        redrawArea(area);
+}
+
+void DisplayPage::drawBinding(DisplayValue *pBinding)
+{
+    if (pBinding == NULL || deferValueDraw())
+        return;
+
+    selectDefaultFont(_tft);
+    int count = labelCount();
+    for (int i = 0; i < count; i++)
+    {
+        DisplayLabel *lbl = labels.get(i);
+        if (lbl->getBinding() == pBinding && !lbl->isOccluded())
+            lbl->drawValue();
+    }
+
+    count = buttonCount();
+    for (int i = 0; i < count; i++)
+    {
+        DisplayButton *btn = buttons.get(i);
+        if (btn->getBinding() == pBinding && btn->showsBinding() && !btn->isOccluded())
+            btn->draw();
+    }
+}
+
+void DisplayPage::drawChangingItems()
+{
+    if (deferValueDraw())
+        return;
+
+    selectDefaultFont(_tft);
+    int count = labelCount();
+    for (int i = 0; i < count; i++)
+    {
+        DisplayLabel *lbl = labels.get(i);
+        if (!lbl->isOccluded() && (lbl->showsValue() || lbl->_values.onDrawDisplayLabel))
+            lbl->drawValue();
+    }
+
+    count = buttonCount();
+    for (int i = 0; i < count; i++)
+    {
+        DisplayButton *btn = buttons.get(i);
+        if (!btn->isOccluded() && (btn->showsValue() || btn->_values.onDrawDisplayButton))
+            btn->draw();
+    }
+
+    drawWidgets();
+}
+
+bool DisplayPage::deferValueDraw()
+{
+    if (!_pMenu || !_pMenu->isDrawingPage() || _pMenu->getVisablePage() != this)
+        return false;
+
+    _valuesPending = true;
+    return true;
+}
+
+void DisplayPage::drawDeferredValues()
+{
+    if (!_valuesPending)
+        return;
+
+    _valuesPending = false;
+    drawChangingItems();
+}
+
+bool DisplayPage::removeButton(DisplayButton *pButton, bool redraw)
+{
+    if (pButton == NULL)
+        return false;
+
+    DisplayRect area = pButton->getRect();
+    if (!buttons.remove(pButton))
+        return false;
+    itemsChanged();
+
+    if (redraw && isVisable())
+        drawArea(area);
+    return true;
+}
+
+bool DisplayPage::removeLabel(DisplayLabel *pLabel, bool redraw)
+{
+    if (pLabel == NULL)
+        return false;
+
+    DisplayRect area = pLabel->getRect();
+    if (!labels.remove(pLabel))
+        return false;
+    itemsChanged();
+
+    if (redraw && isVisable())
+        drawArea(area);
+    return true;
+}
+
+bool DisplayPage::removeWidget(DisplayWidget *pWidget, bool redraw)
+{
+    if (pWidget == NULL)
+        return false;
+
+    DisplayRect area = pWidget->getRect();
+    if (!widgets.remove(pWidget))
+        return false;
+    itemsChanged();
+
+    if (redraw && isVisable())
+        drawArea(area);
+    return true;
+}
+
+void DisplayPage::clear()
+{
+    widgets.removeAll();
+    buttons.removeAll();
+    labels.removeAll();
+    itemsChanged();
+}
+
+void DisplayPage::setReusePool(uint16_t buttonCount, uint16_t labelCount)
+{
+    buttons.setPoolSize(buttonCount);
+    labels.setPoolSize(labelCount);
+}
+
+bool DisplayPage::canPrerender()
+{
+    if (!_built || _onShowDisplayPage || _onDrawDisplayPage || widgetCount() > 0)
+        return false;
+
+    int count = buttonCount();
+    for (int i = 0; i < count; i++)
+    {
+        DISPLAY_BUTTON_VALUES &values = buttons.get(i)->_values;
+        if (values.onDrawDisplayButton || buttons.get(i)->showsValue())
+            return false;
+    }
+
+    count = labelCount();
+    for (int i = 0; i < count; i++)
+    {
+        DISPLAY_LABEL_VALUES &values = labels.get(i)->_values;
+        if (values.onDrawDisplayLabel || labels.get(i)->showsValue())
+            return false;
+    }
+
+    return true;
+}
+
+uint32_t DisplayPage::hashBytes(uint32_t hash, const void *pData, size_t size)
+{
+    //FNV-1a
+    const uint8_t *pBytes = (const uint8_t *)pData;
+    for (size_t i = 0; i < size; i++)
+        hash = (hash ^ pBytes[i]) * 16777619UL;
+    return hash;
+}
+
+uint32_t DisplayPage::getDrawHash()
+{
+    uint32_t hash = 2166136261UL;
+    const void *fonts[2] = {NULL, NULL};
+    if (_pMenu)
+    {
+        fonts[0] = _pMenu->getDefaultFont()->getGfxFont();
+        fonts[1] = _pMenu->getDefaultFont()->getSmoothFont();
+    }
+    hash = hashBytes(hash, fonts, sizeof(fonts));
+    hash = hashBytes(hash, &_fillColor, sizeof(_fillColor));
+
+    int count = labelCount();
+    for (int i = 0; i < count; i++)
+    {
+        DISPLAY_LABEL_VALUES &values = labels.get(i)->_values;
+        DisplayStyle *pStyle = values.pStyle;
+        int16_t geometry[11] = {values.x, values.y, (int16_t)values.width, (int16_t)values.height,
+                                (int16_t)pStyle->getOutlineColor(), (int16_t)pStyle->getFillColor(), (int16_t)pStyle->getTextColor(),
+                                (int16_t)((pStyle->getTextSize() << 8) | pStyle->getRadius(values.width, values.height)), (int16_t)((values.textAlign << 8) | values.state),
+                                values.xDatumOffset, values.yDatumOffset};
+        hash = hashBytes(hash, geometry, sizeof(geometry));
+        DisplayFont *pFont = pStyle->getFont();
+        hash = hashBytes(hash, &pFont, sizeof(pFont));
+        hash = hashBytes(hash, values.text.c_str(), values.text.length() + 1);
+    }
+
+    count = buttonCount();
+    for (int i = 0; i < count; i++)
+    {
+        DISPLAY_BUTTON_VALUES &values = buttons.get(i)->_values;
+        DisplayStyle *pStyle = values.pStyle;
+        int16_t geometry[11] = {values.x, values.y, (int16_t)values.width, (int16_t)values.height,
+                                (int16_t)pStyle->getOutlineColor(), (int16_t)pStyle->getFillColor(), (int16_t)pStyle->getTextColor(),
+                                (int16_t)((pStyle->getTextSize() << 8) | pStyle->getRadius(values.width, values.height)), (int16_t)((values.textAlign << 8) | values.state),
+                                values.xDatumOffset, values.yDatumOffset};
+        hash = hashBytes(hash, geometry, sizeof(geometry));
+        DisplayFont *pFont = pStyle->getFont();
+        hash = hashBytes(hash, &pFont, sizeof(pFont));
+        hash = hashBytes(hash, values.text.c_str(), values.text.length() + 1);
+    }
+
+    return hash;
+}
+
+bool DisplayPage::canDrawInStrips()
+{
+    if (!_built || _onDrawDisplayPage)
+        return false;
+
+    int count = buttonCount();
+    for (int i = 0; i < count; i++)
+    {
+        if (buttons.get(i)->_values.onDrawDisplayButton)
+            return false;
+    }
+
+    count = labelCount();
+    for (int i = 0; i < count; i++)
+    {
+        if (labels.get(i)->_values.onDrawDisplayLabel)
+            return false;
+    }
+
+    return true;
+}
+
+bool DisplayPage::drawStep(TFT_eSPI *pTarget, int step, const DisplayRect *pStrip)
+{
+    int labelCount = this->labelCount(),
+        itemCount = labelCount + buttonCount();
+
+    if (step == 0)
+    {
+        //strips are drawn from the top, the occlusion is found once for all of them
+        if (pStrip == NULL || pStrip->y == 0)
+            updateOcclusion(false);
+
+        if (pStrip)
+            pTarget->fillRect(pStrip->x, pStrip->y, pStrip->width, pStrip->height, _fillColor);
+        else
+            pTarget->fillRect(0, 0, _tft->width(), _tft->height(), _fillColor);
+        selectDefaultFont(pTarget);
+        return itemCount > 0;
+    }
+
+    //the items are gone through once for every font group, drawing those with the group's font
+    int item = (step - 1) % itemCount;
+    int8_t group = (step - 1) / itemCount;
+    if (item < labelCount)
+    {
+        DisplayLabel *lbl = labels.get(item);
+        if (!lbl->isOccluded() && (pStrip == NULL || lbl->getRect().intersects(*pStrip)) && isInFontGroup(lbl->getFont(), group))
+        {
+            lbl->_values.tft = pTarget;
+            lbl->draw(false, false);
+            lbl->_values.tft = _tft;
+        }
+    }
+    else if (item < itemCount)
+    {
+        DisplayButton *btn = buttons.get(item - labelCount);
+        if (!btn->isOccluded() && (pStrip == NULL || btn->getRect().intersects(*pStrip)) && isInFontGroup(btn->getFont(), group))
+        {
+            btn->_values.tft = pTarget;
+            btn->draw(false, false);
+            btn->_values.tft = _tft;
+        }
+    }
+
+    return step < itemCount * _fontGroups;
+}
+
+void DisplayPage::showPrerendered(TFT_eSprite *pSprite)
+{
+    //the occlusion flags are used when pressed buttons are drawn
+    updateOcclusion(false);
+
+    int count = buttonCount();
+    for (int i = 0; i < count; i++)
+        buttons.get(i)->resetPressState();
+
+    count = labelCount();
+    for (int i = 0; i < count; i++)
+        labels.get(i)->resetPressState();
+
+    pSprite->pushSprite(0, 0);
 }
 
 void DisplayPage::show() {
     
+    callShowEvent();
+    draw(true);
+}
+
+void DisplayPage::callShowEvent()
+{
     if (_onShowDisplayPage) {
         _onShowDisplayPage(this);
     }
-
-    draw(true);
 }
 
 DisplayButton *DisplayPage::getButton(int index)
@@ -180,6 +1034,11 @@ DisplayLabel *DisplayPage::getLabel(int index)
     return labels.get(index);
 }
 
+DisplayWidget *DisplayPage::getWidget(int index)
+{
+    return widgets.get(index);
+}
+
 
 DisplayButton *DisplayPage::getPressedButton(uint16_t x, uint16_t y){
     
@@ -227,6 +1086,9 @@ void DisplayPage::drawTouchButtonsState() {
     for (int i = 0; i < buttonCount; i++)
     {
          DisplayButton *btn = buttons.get(i);
+         if (btn->isOccluded())
+            continue;
+
          if (btn->justPressed()) 
             btn->draw(true);
 
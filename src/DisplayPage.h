@@ -13,12 +13,58 @@
 #include "DisplayLabelList.h"
 #include "DisplayButton.h"
 #include "DisplayButtonList.h"
+#include "DisplayWidgetList.h"
+#include "DisplayNumericEntry.h"
+#include "DisplayList.h"
+#include "DisplayChart.h"
+#include "DisplayBar.h"
 
 class DisplayMenu;
 
+/**
+ * @brief How many fonts a page groups it's items by when it is drawn, a page with more fonts is drawn in item order.
+ *
+ */
+#define DISPLAY_PAGE_FONT_GROUPS 4
+
 
 typedef void (*OnShowDisplayPage) (DisplayPage *pPage);
 typedef void (*OnDrawDisplayPage) (DisplayPage *pPage);
+typedef void (*OnBuildDisplayPage) (DisplayPage *pPage);
+
+/**
+ * @brief A page event, a function taking the page, which can also carry a context pointer or call a member function.
+ * OnShowDisplayPage, OnDrawDisplayPage and OnBuildDisplayPage functions convert to it.
+ */
+typedef DisplayDelegate<DisplayPage *> DisplayPageDelegate;
+
+/**
+ * @brief Estimated heap used by the items of a page, in bytes.
+ *
+ */
+struct DISPLAY_PAGE_MEMORY {
+    uint16_t buttonCount;
+    uint16_t labelCount;
+    uint16_t widgetCount;
+    size_t buttons; //button objects and their list nodes
+    size_t labels;  //label objects and their list nodes
+    size_t widgets; //widget objects, the memory they allocate and their list nodes
+    size_t strings; //texts and linked value names of buttons and labels
+    size_t layout;  //buffers the page keeps to work out which items are covered
+    size_t total;
+};
+
+/**
+ * @brief The heap before and after a page was last built by it's build function.
+ *
+ */
+struct DISPLAY_PAGE_BUILD_MEMORY {
+    uint32_t allocations; //buttons, labels and widgets created by the build
+    size_t freeBefore;
+    size_t freeAfter;
+    size_t largestBefore; //largest free block, a build can fail even with enough free heap if this is small
+    size_t largestAfter;
+};
 
 class DisplayPage
 {
@@ -28,13 +74,103 @@ private:
     uint16_t _fillColor;
     DisplayButtonList buttons;
     DisplayLabelList labels;
-    OnShowDisplayPage _onShowDisplayPage;
-    OnDrawDisplayPage _onDrawDisplayPage;
+    DisplayWidgetList widgets;
+    DisplayPageDelegate _onShowDisplayPage;
+    DisplayPageDelegate _onDrawDisplayPage;
+    DisplayPageDelegate _onBuildDisplayPage;
+    bool _built;
+    bool _pinned;
+    DISPLAY_PAGE_BUILD_MEMORY _buildMemory;
+    unsigned long _lastShown;
+    DisplayFont *_groupFonts[DISPLAY_PAGE_FONT_GROUPS];
+    uint8_t _fontGroups;
+    bool _valuesPending; //values changed while the page was drawn in strips
+    //occlusion and font groups are worked out in buffers kept with the page, and only again when the layout changes
+    DisplayRect *_pCovers;
+    int *_pFirstCover;
+    int32_t *_pSpanWork;
+    DisplayFont **_pItemFonts;
+    DisplayRect *_pItemRects;
+    uint16_t _layoutCapacity;
+    int _coverCount;
+    uint32_t _layoutHash;
+    bool _layoutValid;
     void init(TFT_eSPI *tft, DisplayMenu *menu, uint16_t fillColor);
     DisplayButton *addButton(const  DisplayButton button);
     DisplayLabel *addLabel(const  DisplayLabel label);
 
+    /**
+     * @brief Marks every label and button which is completely covered by opaque items drawn after it
+     * and optionally clears the parts of the screen which no opaque item will cover.
+     * 
+     * @param fillBackground Should the uncovered parts of the screen be filled with the page fill color
+     */
+    void updateOcclusion(bool fillBackground);
+
+    /**
+     * @brief Hash of what decides which items are covered and how they are grouped by font,
+     * the position, size, state, radius and font of every item
+     * 
+     */
+    uint32_t getLayoutHash();
+
+    /**
+     * @brief Grows the occlusion and font group buffers so they fit the given number of items, called when items are added
+     * so the buffers are not allocated while the page is drawn
+     * 
+     */
+    void reserveLayout(int itemCount);
+
+    /**
+     * @brief Frees the occlusion and font group buffers
+     * 
+     */
+    void freeLayout();
+
+    /**
+     * @brief Called when an item has been added or removed, the occlusion and font groups are worked out again on the next draw
+     * 
+     */
+    void itemsChanged();
+
+    /**
+     * @brief Finds the fonts of the items which are drawn, so they can be drawn one font at a time.
+     * Drawing by font changes the order items are drawn in, so the items are only grouped
+     * when no items with different fonts overlap, otherwise there is one group.
+     * Called by updateOcclusion when the layout has changed, the occlusion must be up to date.
+     * 
+     */
+    void updateFontGroups();
+
+    /**
+     * @brief Is an item with the given font drawn with a font group, -1 is every group
+     * 
+     */
+    bool isInFontGroup(DisplayFont *pFont, int8_t fontGroup);
+
+    /**
+     * @brief Sets the default font on pages without a menu, items on menu pages select their own fonts
+     * 
+     */
+    void selectDefaultFont(TFT_eSPI *pTarget);
+
+    /**
+     * @brief Calls the page draw function, which may change the font behind the menu's back
+     * 
+     */
+    void callDrawEvent();
+
+    /**
+     * @brief Fills an area and draws the items overlapping it, clipped to it, the occlusion must be up to date
+     * 
+     */
+    void redrawArea(const DisplayRect &area);
+    static int addOpaqueRects(DisplayRect *pRects, DisplayRect rect, uint8_t radius);
+    static void fillBackgroundSpan(const DisplayRect &span, void *pContext);
+    static uint32_t hashBytes(uint32_t hash, const void *pData, size_t size);
+
 public:
+    DISPLAY_MEMORY_TRACKED
     /**
      * @brief Construct a new Display Page object (Copy constructor)
      * 
@@ -43,6 +179,7 @@ public:
     DisplayPage(const DisplayPage &page);
 
     DisplayPage(TFT_eSPI *tft, DisplayMenu *menu, uint16_t fillColor = TFT_BLACK);
+    ~DisplayPage();
     /**
      * @brief draws all items on the page
      * 
@@ -74,7 +211,7 @@ public:
                             uint16_t textColor,
                             uint8_t textsize, 
                             const char *text,
-                            ButtonPressedFunction buttonPressedFunction); 
+                            DisplayButtonDelegate buttonPressedFunction); 
     /**
      * @brief Adds a new button which opens a given page
      * 
@@ -132,6 +269,130 @@ public:
                                         double incrementValue
                                     );
 
+    /**
+     * @brief Adds a new increment button which steps a typed variable, no floating point math is done
+     * for int32_t bindings. Only the items bound to the same variable are drawn when the button is pressed.
+     * 
+     * @param text Button text
+     * @param pBinding the variable this button is suppose to change, it must exist for as long as the button does
+     * @param steps how many of the binding's steps the variable is changed by in each press, negative steps decrease it
+     * @return a pointer to the added button
+     */
+    DisplayButton *addIncrementButton(  int16_t x,
+                                        int16_t y,
+                                        uint16_t width,
+                                        uint16_t height,
+                                        uint16_t outlineColor,
+                                        uint16_t fillColor,
+                                        uint16_t textColor,
+                                        uint8_t textsize, 
+                                        const char *text,
+                                        DisplayValue *pBinding,
+                                        int16_t steps
+                                    );
+
+
+    /**
+     * @brief Adds a field for typing in a number with keypad buttons
+     * 
+     * @param x Field upper left corner, x coordinate
+     * @param y Field upper left corner, y coordinate
+     * @param width Field width
+     * @param height Field height
+     * @param outlineColor Color of the line surrounding the field
+     * @param fillColor Field color
+     * @param textColor Field text color
+     * @param textsize Text multiplier size (2 is 100% bigger than normal).
+     * @return a pointer to the added field, it is owned by the page.
+     */
+    DisplayNumericEntry *addNumericEntry(int16_t x,
+                                         int16_t y,
+                                         uint16_t width,
+                                         uint16_t height,
+                                         uint16_t outlineColor,
+                                         uint16_t fillColor,
+                                         uint16_t textColor,
+                                         uint8_t textsize);
+
+    /**
+     * @brief Adds a scrolling list of text rows
+     * 
+     * @param x List upper left corner, x coordinate
+     * @param y List upper left corner, y coordinate
+     * @param width List width
+     * @param height List height
+     * @param rowHeight Height of each row, including the line below it
+     * @param fillColor Row color
+     * @param textColor Row text color
+     * @param lineColor Color of the line between rows
+     * @param textsize Text multiplier size (2 is 100% bigger than normal).
+     * @return a pointer to the added list, it is owned by the page.
+     */
+    DisplayList *addList(int16_t x,
+                         int16_t y,
+                         uint16_t width,
+                         uint16_t height,
+                         uint16_t rowHeight,
+                         uint16_t fillColor,
+                         uint16_t textColor,
+                         uint16_t lineColor,
+                         uint8_t textsize);
+
+    /**
+     * @brief Adds a chart which shows how a value changes over time
+     * 
+     * @param x Chart upper left corner, x coordinate
+     * @param y Chart upper left corner, y coordinate
+     * @param width Chart width, one column of samples for every pixel inside the outline
+     * @param height Chart height
+     * @param outlineColor Color of the chart outline
+     * @param fillColor Chart background color
+     * @param lineColor Color of the line drawn through the samples
+     * @param samplesPerColumn How many samples are combined into one pixel column
+     * @return a pointer to the added chart, it is owned by the page.
+     */
+    DisplayChart *addChart(int16_t x,
+                           int16_t y,
+                           uint16_t width,
+                           uint16_t height,
+                           uint16_t outlineColor,
+                           uint16_t fillColor,
+                           uint16_t lineColor,
+                           uint16_t samplesPerColumn = 1);
+
+    /**
+     * @brief Adds a bar which is filled according to a value, with the value written next to it
+     * 
+     * @param x Bar upper left corner, x coordinate
+     * @param y Bar upper left corner, y coordinate
+     * @param width Bar width, including the text
+     * @param height Bar height
+     * @param textWidth Width of the area to the right of the bar where the value is written, 0 for no text
+     * @param outlineColor Color of the bar outline
+     * @param fillColor Color of the empty part of the bar and behind the text
+     * @param barColor Color of the filled part of the bar
+     * @param textColor Color of the text
+     * @param textsize Text multiplier size (2 is 100% bigger than normal).
+     * @return a pointer to the added bar, it is owned by the page.
+     */
+    DisplayBar *addBar(int16_t x,
+                       int16_t y,
+                       uint16_t width,
+                       uint16_t height,
+                       uint16_t textWidth,
+                       uint16_t outlineColor,
+                       uint16_t fillColor,
+                       uint16_t barColor,
+                       uint16_t textColor,
+                       uint8_t textsize);
+
+    /**
+     * @brief Adds a widget to the page. The page takes ownership of the widget and deletes it when the page is destroyed.
+     * 
+     * @param pWidget A widget created with new
+     * @return DisplayWidget* the added widget or NULL if it could not be added
+     */
+    DisplayWidget *addWidget(DisplayWidget *pWidget);
 
     DisplayLabel *addPageLabel(int16_t x, 
                                 int16_t y, 
@@ -161,6 +422,15 @@ public:
      */
     DisplayLabel* getLabel(int index);
 
+    /**
+     * @brief Get a pointer to a specific widget stored in the page.
+     * 
+     * @param index 
+     * @return DisplayWidget* 
+     * @return if no widget is found at the given index NULL is returned.
+     */
+    DisplayWidget* getWidget(int index);
+
     /**
      * @brief Searches for a button by the button text
      * 
@@ -171,14 +441,242 @@ public:
 
     int buttonCount() { return buttons.count(); } ;
     int labelCount() { return labels.count(); } ;
-    void drawButtons();
-    void drawLabels();
+    int widgetCount() { return widgets.count(); } ;
+    /**
+     * @brief Draws the buttons, labels or widgets which are not covered by other items
+     * 
+     * @param fontGroup Only draw the items with this group's font, -1 draws all of them
+     */
+    void drawButtons(int8_t fontGroup = -1);
+    void drawLabels(int8_t fontGroup = -1);
+    void drawWidgets(int8_t fontGroup = -1);
+
+    /**
+     * @brief How many fonts the items were grouped by when the page was last drawn
+     * 
+     */
+    uint8_t getFontGroupCount() { return _fontGroups; };
+
+    /**
+     * @brief Gives a touch screen reading to the visable widgets
+     * 
+     * @return true if a widget used it
+     */
+    bool touchWidgets(uint16_t x, uint16_t y, bool pressed);
+
+    /**
+     * @brief Tells the widgets the page is no longer visable
+     * 
+     */
+    void hideWidgets();
     void show();
+
+    /**
+     * @brief Calls the function registered with registerOnShowEvent, show does this before it draws the page
+     * 
+     */
+    void callShowEvent();
     void draw(bool wipeScreen = true);
 
+    /**
+     * @brief Draws only the part of the page inside an area, everything drawn is clipped to it.
+     * The area is filled with the page fill color and the items which overlap it are drawn again.
+     * 
+     */
+    void drawArea(const DisplayRect &area);
+
+    /**
+     * @brief Draws the labels and buttons whose style changed after the given style change.
+     * The rectangle holding the changed items is drawn like drawArea, so items below and on top of them stay in their order
+     * and the page draw function is called once.
+     * 
+     * @param since DisplayStyle::getLastChange() when the page was last drawn
+     */
+    void drawStyleChanges(uint32_t since);
+
+    /**
+     * @brief Draws the labels and buttons which show a bound variable, after it changed
+     * 
+     */
+    void drawBinding(DisplayValue *pBinding);
+
+    /**
+     * @brief Draws the items which can change without the page changing, items showing values,
+     * items with draw functions and widgets. Used when the display wakes up and still shows the page.
+     * 
+     */
+    void drawChangingItems();
+
+    /**
+     * @brief While the menu draws the page in strips, remembers that a value changed instead of drawing it,
+     * items in strips already sent to the display would be drawn on top of a half drawn page.
+     * 
+     * @return true if the value is to be drawn when the page is done, the caller does not draw it
+     */
+    bool deferValueDraw();
+
+    /**
+     * @brief Draws the changing items if values changed while the page was drawn in strips, called by the menu when it is done
+     * 
+     */
+    void drawDeferredValues();
+
+    /**
+     * @brief Removes a button from the page, the pointer is invalid after this call.
+     * 
+     * @param redraw Should the area the button covered be drawn again, if the page is visable
+     * @return true if the button was on the page
+     */
+    bool removeButton(DisplayButton *pButton, bool redraw = true);
+
+    /**
+     * @brief Removes a label from the page, the pointer is invalid after this call.
+     * 
+     * @param redraw Should the area the label covered be drawn again, if the page is visable
+     * @return true if the label was on the page
+     */
+    bool removeLabel(DisplayLabel *pLabel, bool redraw = true);
+
+    /**
+     * @brief Removes a widget from the page and deletes it.
+     * 
+     * @param redraw Should the area the widget covered be drawn again, if the page is visable
+     * @return true if the widget was on the page
+     */
+    bool removeWidget(DisplayWidget *pWidget, bool redraw = true);
+
+    /**
+     * @brief Removes all buttons, labels and widgets from the page without drawing anything.
+     * Pointers to items on the page are invalid after this call.
+     * 
+     */
+    void clear();
+
+    /**
+     * @brief Keep up to this many removed buttons and labels to be reused when new ones are added,
+     * for pages which are changed often. 0 deletes them when they are removed, which is the default.
+     * 
+     */
+    void setReusePool(uint16_t buttonCount, uint16_t labelCount);
+
+    /**
+     * @brief Provides a function which adds the buttons, labels and widgets to the page.
+     * A page with a build function is empty until it is about to be shown, and the menu can 
+     * release it's items again when it is not visable and the menu needs the memory.
+     * 
+     * @param pOnBuildDisplayPage a pointer to a function which adds all items to the page.
+     */
+    void registerOnBuildEvent(DisplayPageDelegate pOnBuildDisplayPage) {
+        _onBuildDisplayPage = pOnBuildDisplayPage;
+        _built = !pOnBuildDisplayPage.isSet();
+    }
+
+    /**
+     * @brief Is the page created by a build function
+     * 
+     */
+    bool isLazy() { return _onBuildDisplayPage.isSet(); };
+
+    /**
+     * @brief Are the items of the page in memory
+     * 
+     */
+    bool isBuilt() { return _built; };
+
+    /**
+     * @brief Pinned pages are never released by the menu
+     * 
+     */
+    void setPinned(bool pinned) { _pinned = pinned; };
+    bool isPinned() { return _pinned; };
+
+    /**
+     * @brief Runs the build function if the page has one and it's items are not in memory.
+     * 
+     * @return true if the page items are in memory
+     */
+    bool build();
+
+    /**
+     * @brief Deletes all buttons, labels and widgets of a page which has a build function,
+     * the build function will add them again the next time the page is shown.
+     * Pointers to items on the page are invalid after this call.
+     * 
+     * @return true if the items were released
+     */
+    bool release();
+
+    /**
+     * @brief Estimates how much heap the items on this page use, including their list nodes and texts.
+     * 
+     */
+    size_t getItemMemory();
+
+    /**
+     * @brief Estimates how much heap the items on this page use, by kind of item
+     * 
+     */
+    void getMemoryReport(DISPLAY_PAGE_MEMORY *pReport);
+
+    /**
+     * @brief The heap before and after the page was last built, all zeros if it has not been built by a build function
+     * 
+     */
+    const DISPLAY_PAGE_BUILD_MEMORY &getBuildMemory() { return _buildMemory; };
+
+    /**
+     * @brief Can the page be drawn ahead of time and shown later from the image.
+     * Pages with show or draw functions, widgets, or items drawing linked values or with draw functions
+     * can change between being drawn and being shown, so they are always drawn when they are shown.
+     * 
+     */
+    bool canPrerender();
+
+    /**
+     * @brief A checksum of everything which decides how the page looks.
+     * An image drawn ahead of time is only shown if the checksum has not changed since it was drawn.
+     * 
+     */
+    uint32_t getDrawHash();
+
+    /**
+     * @brief Can the page be drawn a strip at a time into a sprite.
+     * Pages and items with draw functions draw straight on the display, so they are drawn in one go when they are shown.
+     * 
+     */
+    bool canDrawInStrips();
+
+    /**
+     * @brief Draws one part of the page on another display, for example a sprite.
+     * Step 0 fills the background and every step after that draws one label or button,
+     * going through the items once for every font group.
+     * 
+     * @param pTarget Where to draw, it must be as big as the page's display, or have it's origin moved to the strip
+     * @param step The part to draw
+     * @param pStrip Only this part of the page is filled and only items overlapping it are drawn, NULL draws the whole page.
+     * Strips must be drawn from the top of the page.
+     * @return true if there are more steps
+     */
+    bool drawStep(TFT_eSPI *pTarget, int step, const DisplayRect *pStrip = NULL);
+
+    /**
+     * @brief Shows the page by pushing an image of it drawn with drawStep
+     * 
+     */
+    void showPrerendered(TFT_eSprite *pSprite);
+
+    unsigned long getLastShown() { return _lastShown; };
+    void setLastShown(unsigned long lastShown) { _lastShown = lastShown; };
+
     DisplayButton *getPressedButton(uint16_t x, uint16_t y);
     void drawTouchButtonsState();
     DisplayMenu *getMenu() { return _pMenu; };
+
+    /**
+     * @brief Is this the page the menu is showing
+     * 
+     */
+    bool isVisable();
     uint16_t getFillColor() { return _fillColor; };
 
     
@@ -221,7 +719,7 @@ public:
      * 
      * @param pOnDrawDisplayPage a pointer to a function which will be called just before the page is drawn
      */
-    void registerOnDrawEvent(OnDrawDisplayPage pOnDrawDisplayPage) {
+    void registerOnDrawEvent(DisplayPageDelegate pOnDrawDisplayPage) {
         _onDrawDisplayPage = pOnDrawDisplayPage;
     }
 
@@ -230,7 +728,7 @@ public:
      * 
      * @param pOnShowDisplayPage a pointer to a function which will be called just before the page is shown
      */
-    void registerOnShowEvent(OnShowDisplayPage pOnShowDisplayPage) {
+    void registerOnShowEvent(DisplayPageDelegate pOnShowDisplayPage) {
         _onShowDisplayPage = pOnShowDisplayPage;
     }
 
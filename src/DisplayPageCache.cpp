@@ -0,0 +1,182 @@
+#include "DisplayPageCache.h"
+#include "DisplayPage.h"
+
+DisplayPageCache::DisplayPageCache(TFT_eSPI *tft, size_t maxBytes, uint8_t colorDepth, unsigned long sliceMicros)
+{
+    _tft = tft;
+    _maxBytes = maxBytes;
+    _colorDepth = colorDepth == 8 ? 8 : 16;
+    _sliceMicros = sliceMicros;
+    _usedBytes = 0;
+    _hits = 0;
+    _misses = 0;
+}
+
+int DisplayPageCache::find(DisplayPage *pPage)
+{
+    for (int i = 0; i < _size; i++)
+    {
+        if (get(i)->pPage == pPage)
+            return i;
+    }
+    return -1;
+}
+
+void DisplayPageCache::removeEntry(int index)
+{
+    DISPLAY_PAGE_CACHE_ENTRY *pEntry = LinkedList<DISPLAY_PAGE_CACHE_ENTRY *>::remove(index);
+    if (pEntry == NULL)
+        return;
+
+    _usedBytes -= pEntry->bytes;
+    pEntry->pSprite->deleteSprite();
+    delete pEntry->pSprite;
+    delete pEntry;
+}
+
+void DisplayPageCache::remove(DisplayPage *pPage)
+{
+    int index = find(pPage);
+    if (index > -1)
+        removeEntry(index);
+}
+
+bool DisplayPageCache::isCandidate(DisplayPage *pVisable, DisplayPage *pPage)
+{
+    if (pPage == NULL || pPage == pVisable)
+        return false;
+
+    int count = pVisable->buttonCount();
+    for (int i = 0; i < count; i++)
+    {
+        DISPLAY_BUTTON_VALUES &values = pVisable->getButton(i)->_values;
+        if (values.type == OPEN_PAGE && values.state == VISABLE && values.pPageToOpen == pPage)
+            return true;
+    }
+    return false;
+}
+
+DISPLAY_PAGE_CACHE_ENTRY *DisplayPageCache::addEntry(DisplayPage *pVisable, DisplayPage *pPage)
+{
+    int16_t width = _tft->width(),
+            height = _tft->height();
+    size_t bytes = ((size_t)width * height * (_colorDepth / 8)) + sizeof(TFT_eSprite) + sizeof(DISPLAY_PAGE_CACHE_ENTRY);
+    if (bytes > _maxBytes)
+        return NULL;
+
+    //make room by dropping pages which can not be opened from the visable page, oldest first
+    for (int i = _size - 1; i >= 0 && _usedBytes + bytes > _maxBytes; i--)
+    {
+        if (!isCandidate(pVisable, get(i)->pPage))
+            removeEntry(i);
+    }
+
+    if (_usedBytes + bytes > _maxBytes)
+        return NULL;
+
+    TFT_eSprite *pSprite = new TFT_eSprite(_tft);
+    pSprite->setColorDepth(_colorDepth);
+    if (!pSprite->createSprite(width, height))
+    {
+        delete pSprite;
+        return NULL;
+    }
+
+    DISPLAY_PAGE_CACHE_ENTRY *pEntry = new DISPLAY_PAGE_CACHE_ENTRY;
+    pEntry->pPage = pPage;
+    pEntry->pSprite = pSprite;
+    pEntry->hash = 0;
+    pEntry->bytes = bytes;
+    pEntry->nextStep = 0;
+
+    add(pEntry);
+    _usedBytes += bytes;
+    return pEntry;
+}
+
+DISPLAY_PAGE_CACHE_ENTRY *DisplayPageCache::nextWork(DisplayPage *pVisable)
+{
+    int count = pVisable->buttonCount();
+    for (int i = 0; i < count; i++)
+    {
+        DISPLAY_BUTTON_VALUES &values = pVisable->getButton(i)->_values;
+        DisplayPage *pPage = values.pPageToOpen;
+        if (values.type != OPEN_PAGE || values.state != VISABLE || pPage == NULL || pPage == pVisable)
+            continue;
+
+        //pages are not built just to draw them ahead of time
+        if (!pPage->isBuilt() || !pPage->canPrerender())
+            continue;
+
+        int index = find(pPage);
+        if (index < 0)
+        {
+            DISPLAY_PAGE_CACHE_ENTRY *pEntry = addEntry(pVisable, pPage);
+            if (pEntry)
+                return pEntry;
+            continue;
+        }
+
+        DISPLAY_PAGE_CACHE_ENTRY *pEntry = get(index);
+        if (pEntry->nextStep > -1)
+            return pEntry;
+
+        if (pEntry->hash != pPage->getDrawHash())
+        {
+            pEntry->nextStep = 0;
+            return pEntry;
+        }
+    }
+    return NULL;
+}
+
+bool DisplayPageCache::update(DisplayPage *pVisable)
+{
+    if (pVisable == NULL)
+        return false;
+
+    unsigned long start = micros();
+    do
+    {
+        DISPLAY_PAGE_CACHE_ENTRY *pEntry = nextWork(pVisable);
+        if (pEntry == NULL)
+            return false;
+
+        if (pEntry->nextStep == 0)
+            pEntry->hash = pEntry->pPage->getDrawHash();
+
+        bool more = pEntry->pPage->drawStep(pEntry->pSprite, pEntry->nextStep);
+        pEntry->nextStep = more ? pEntry->nextStep + 1 : -1;
+    } while (micros() - start < _sliceMicros);
+
+    return true;
+}
+
+bool DisplayPageCache::show(DisplayPage *pPage)
+{
+    int index = find(pPage);
+    if (index < 0)
+    {
+        if (pPage->canPrerender())
+            _misses++;
+        return false;
+    }
+
+    DISPLAY_PAGE_CACHE_ENTRY *pEntry = get(index);
+    if (pEntry->nextStep > -1 || pEntry->hash != pPage->getDrawHash() || !pPage->canPrerender())
+    {
+        _misses++;
+        return false;
+    }
+
+    pPage->showPrerendered(pEntry->pSprite);
+    _hits++;
+    return true;
+}
+
+void DisplayPageCache::destory()
+{
+    while (_size > 0)
+        removeEntry(_size - 1);
+    clear();
+}
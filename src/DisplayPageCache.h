@@ -0,0 +1,101 @@
+#ifndef DISPLAYPAGECACHE_H
+#define DISPLAYPAGECACHE_H
+
+#include <Arduino.h>
+
+#include <TFT_eSPI.h>
+
+#include "LinkedList.h"
+
+class DisplayPage;
+
+/**
+ * @brief A page drawn ahead of time into a full screen sprite.
+ *
+ */
+struct DISPLAY_PAGE_CACHE_ENTRY {
+    DisplayPage *pPage;
+    TFT_eSprite *pSprite;
+    uint32_t hash;
+    size_t bytes;
+    int nextStep; //next drawStep to run, -1 when the whole page has been drawn
+};
+
+/**
+ * @brief Draws the pages the visable page's OPEN_PAGE buttons open, while the menu is idle.
+ *
+ * Every call to update draws as many parts of the pages as fit in a small time slice, so the
+ * touch screen is read as often as before. When one of the pages is shown it is pushed to the display
+ * from the sprite in one go instead of being drawn item by item.
+ * With 16 bit color each page needs width * height * 2 bytes, on an ESP32 with PSRAM the sprites are
+ * put there. 8 bit color halves the memory but the colors are reduced to RGB332.
+ */
+class DisplayPageCache : public LinkedList<DISPLAY_PAGE_CACHE_ENTRY*>
+{
+private:
+    TFT_eSPI *_tft;
+    size_t _maxBytes;
+    uint8_t _colorDepth;
+    unsigned long _sliceMicros;
+    size_t _usedBytes;
+    unsigned long _hits;
+    unsigned long _misses;
+
+    int find(DisplayPage *pPage);
+    void removeEntry(int index);
+    bool isCandidate(DisplayPage *pVisable, DisplayPage *pPage);
+    DISPLAY_PAGE_CACHE_ENTRY *nextWork(DisplayPage *pVisable);
+    DISPLAY_PAGE_CACHE_ENTRY *addEntry(DisplayPage *pVisable, DisplayPage *pPage);
+
+    /**
+     * @brief The cleanup function used by the list's deconstructor;
+     *
+     */
+    void destory();
+
+public:
+    /**
+     * @brief Construct a new Display Page Cache object
+     *
+     * @param tft The display the pages are shown on
+     * @param maxBytes Memory all the page sprites may use together
+     * @param colorDepth 16 or 8 bits per pixel, items drawn later on a page shown from an 8 bit sprite are in full color
+     * @param sliceMicros How long one call to update may draw
+     */
+    DisplayPageCache(TFT_eSPI *tft, size_t maxBytes, uint8_t colorDepth = 16, unsigned long sliceMicros = 2000);
+
+    /**
+     * @brief Draws parts of the pages which can be opened from the visable page, for at most one time slice
+     *
+     * @return true if there is more to draw
+     */
+    bool update(DisplayPage *pVisable);
+
+    /**
+     * @brief Shows a page from the cache if it has been drawn and has not changed since.
+     *
+     * @return true if the page was shown, false if it must be drawn
+     */
+    bool show(DisplayPage *pPage);
+
+    /**
+     * @brief Removes a page from the cache, for example when it's items are released
+     *
+     */
+    void remove(DisplayPage *pPage);
+
+    /**
+     * @brief Removes all pages from the cache
+     *
+     */
+    void flush() { destory(); }
+
+    size_t getMaxBytes() { return _maxBytes; };
+    size_t getUsedBytes() { return _usedBytes; };
+    unsigned long getHits() { return _hits; };
+    unsigned long getMisses() { return _misses; };
+
+    virtual ~DisplayPageCache() { destory(); }
+};
+
+#endif
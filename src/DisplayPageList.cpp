@@ -3,16 +3,16 @@ bool DisplayPageList::add(DisplayPage page) {
     return LinkedList<DisplayPage*>::add(new DisplayPage(page));
 }
 
+bool DisplayPageList::remove(DisplayPage *pPage) {
+    int index = indexOf(pPage);
+    if (index < 0)
+        return false;
+
+    delete LinkedList<DisplayPage*>::remove(index);
+    return true;
+}
+
 void DisplayPageList::destory() {
-    DisplayPage* p;
-    for (int i = 0; i < size(); i++) {
-        p = get(i);
-        if (p != NULL)
-        {
-            delay(10);
-            delete p;
-            set(i, NULL);
-        }
-    }
-    clear();
-}
\ No newline at end of file
+    while (size() > 0)
+        delete shift();
+}
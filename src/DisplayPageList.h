@@ -24,6 +24,13 @@ public:
      */
     int count() { return size(); };
 
+    /**
+     * @brief Removes one page from the list and deletes it
+     * 
+     * @return true if the page was in the list
+     */
+    bool remove(DisplayPage *pPage);
+
     ~DisplayPageList() { destory(); }
 };
 
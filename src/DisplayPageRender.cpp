@@ -0,0 +1,106 @@
+#include "DisplayPageRender.h"
+#include "DisplayPage.h"
+
+DisplayPageRender::DisplayPageRender(TFT_eSPI *tft, uint16_t stripHeight, uint8_t colorDepth)
+{
+    _tft = tft;
+    _pStrip = NULL;
+    _stripHeight = stripHeight > 0 ? stripHeight : 1;
+    _colorDepth = colorDepth == 8 ? 8 : 16;
+    _pPage = NULL;
+    _stripY = 0;
+    _nextStep = 0;
+    _nextWidget = 0;
+    _frames = 0;
+}
+
+DisplayPageRender::~DisplayPageRender()
+{
+    if (_pStrip)
+    {
+        _pStrip->deleteSprite();
+        delete _pStrip;
+    }
+}
+
+bool DisplayPageRender::createStrip()
+{
+    //created on the first page drawn, when the display has been given it's rotation
+    if (_pStrip)
+        return true;
+
+    _pStrip = new TFT_eSprite(_tft);
+    _pStrip->setColorDepth(_colorDepth);
+    if (!_pStrip->createSprite(_tft->width(), _stripHeight))
+    {
+        delete _pStrip;
+        _pStrip = NULL;
+        return false;
+    }
+    return true;
+}
+
+size_t DisplayPageRender::getBytes()
+{
+    if (!_pStrip)
+        return sizeof(DisplayPageRender);
+    return sizeof(DisplayPageRender) + sizeof(TFT_eSprite) + ((size_t)_tft->width() * _stripHeight * (_colorDepth / 8));
+}
+
+bool DisplayPageRender::start(DisplayPage *pPage)
+{
+    _pPage = NULL;
+    if (pPage == NULL || !pPage->canDrawInStrips() || !createStrip())
+        return false;
+
+    _pPage = pPage;
+    _stripY = 0;
+    _nextStep = 0;
+    _nextWidget = 0;
+    return true;
+}
+
+bool DisplayPageRender::update(unsigned long budgetMicros)
+{
+    if (_pPage == NULL)
+        return false;
+
+    int16_t height = _tft->height();
+    unsigned long start = micros();
+    do
+    {
+        if (_stripY < height)
+        {
+            DisplayRect strip(0, _stripY, _tft->width(), min((int)_stripHeight, height - _stripY));
+
+            //the sprite's origin moves up with the strip, so items are drawn at their place on the display
+            if (_nextStep == 0)
+                _pStrip->setOrigin(0, -_stripY);
+
+            if (_pPage->drawStep(_pStrip, _nextStep, &strip))
+            {
+                _nextStep++;
+                continue;
+            }
+
+            _pStrip->setOrigin(0, 0);
+            _pStrip->pushSprite(0, _stripY);
+            _stripY += _stripHeight;
+            _nextStep = 0;
+        }
+        else if (_nextWidget < _pPage->widgetCount())
+        {
+            DisplayWidget *pWidget = _pPage->getWidget(_nextWidget++);
+            if (!pWidget->isOccluded())
+                pWidget->draw();
+        }
+        else
+        {
+            _pPage = NULL;
+            _frames++;
+            return false;
+        }
+    } while (budgetMicros == 0 || micros() - start < budgetMicros);
+
+    return true;
+}
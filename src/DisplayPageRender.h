@@ -0,0 +1,85 @@
+#ifndef DISPLAYPAGERENDER_H
+#define DISPLAYPAGERENDER_H
+
+#include <Arduino.h>
+
+#include <TFT_eSPI.h>
+
+class DisplayPage;
+
+/**
+ * @brief Draws a page on the display a strip at a time, spread over many calls to update.
+ *
+ * Each strip is drawn into a sprite as wide as the display and pushed to the display only when all of it
+ * has been drawn, so the display shows the old page below the strips already pushed and never a half drawn item.
+ * A strip is drawn in steps, the background and then one label or button at a time, and update stops
+ * between steps when it's time is spent. Widgets draw on the display themselves, they are drawn one per step
+ * after the last strip has been pushed.
+ * With 16 bit color the sprite needs width * stripHeight * 2 bytes.
+ */
+class DisplayPageRender
+{
+private:
+    TFT_eSPI *_tft;
+    TFT_eSprite *_pStrip;
+    uint16_t _stripHeight;
+    uint8_t _colorDepth;
+    DisplayPage *_pPage;
+    int16_t _stripY;
+    int _nextStep;
+    int _nextWidget;
+    unsigned long _frames;
+
+    bool createStrip();
+
+public:
+    /**
+     * @brief Construct a new Display Page Render object
+     *
+     * @param tft The display the pages are shown on
+     * @param stripHeight Height of a strip in pixels
+     * @param colorDepth 16 or 8 bits per pixel in the strip sprite, items drawn later on the page are in full color
+     */
+    DisplayPageRender(TFT_eSPI *tft, uint16_t stripHeight = 16, uint8_t colorDepth = 16);
+
+    /**
+     * @brief Starts drawing a page, replacing a page which has not been drawn to the end.
+     * Nothing is drawn until update is called.
+     *
+     * @return false if the page can not be drawn in strips, it must then be drawn with DisplayPage::show
+     */
+    bool start(DisplayPage *pPage);
+
+    /**
+     * @brief Draws the page until it is done or the time is spent
+     *
+     * @param budgetMicros How long this call may draw, 0 draws the whole page
+     * @return true if there is more to draw
+     */
+    bool update(unsigned long budgetMicros);
+
+    /**
+     * @brief Stops drawing the page, the strips already pushed stay on the display
+     *
+     */
+    void cancel() { _pPage = NULL; };
+    bool isRendering() { return _pPage != NULL; };
+
+    /**
+     * @brief The page being drawn, NULL when no page is being drawn
+     *
+     */
+    DisplayPage *getPage() { return _pPage; };
+    uint16_t getStripHeight() { return _stripHeight; };
+
+    /**
+     * @brief How many pages have been drawn to the end
+     *
+     */
+    unsigned long getFrames() { return _frames; };
+    size_t getBytes();
+
+    ~DisplayPageRender();
+};
+
+#endif
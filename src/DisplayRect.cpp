@@ -0,0 +1,155 @@
+#include "DisplayRect.h"
+
+DisplayRect::DisplayRect()
+{
+    x = y = width = height = 0;
+}
+
+DisplayRect::DisplayRect(int16_t x, int16_t y, int16_t width, int16_t height)
+{
+    this->x = x;
+    this->y = y;
+    this->width = width;
+    this->height = height;
+}
+
+bool DisplayRect::contains(const DisplayRect &rect) const
+{
+    if (isEmpty() || rect.isEmpty())
+        return false;
+
+    return rect.x >= x && rect.right() <= right() &&
+           rect.y >= y && rect.bottom() <= bottom();
+}
+
+bool DisplayRect::intersects(const DisplayRect &rect) const
+{
+    if (isEmpty() || rect.isEmpty())
+        return false;
+
+    return rect.x < right() && x < rect.right() &&
+           rect.y < bottom() && y < rect.bottom();
+}
+
+DisplayRect DisplayRect::intersection(const DisplayRect &rect) const
+{
+    if (!intersects(rect))
+        return DisplayRect();
+
+    int32_t left = max(x, rect.x),
+            top = max(y, rect.y),
+            r = min(right(), rect.right()),
+            b = min(bottom(), rect.bottom());
+
+    return DisplayRect(left, top, r - left, b - top);
+}
+
+DisplayRect DisplayRect::united(const DisplayRect &rect) const
+{
+    if (rect.isEmpty())
+        return *this;
+    if (isEmpty())
+        return rect;
+
+    int32_t left = min(x, rect.x),
+            top = min(y, rect.y),
+            r = max(right(), rect.right()),
+            b = max(bottom(), rect.bottom());
+
+    return DisplayRect(left, top, r - left, b - top);
+}
+
+int DisplayRect::subtract(const DisplayRect &area,
+                          const DisplayRect *pCovers,
+                          int coverCount,
+                          OnDisplayRectSpan onSpan,
+                          void *pContext,
+                          int32_t *pWork)
+{
+    if (area.isEmpty())
+        return 0;
+
+    //band edges, top and bottom of the area plus the edges of every cover inside it
+    int32_t *pAllocated = pWork ? NULL : new int32_t[getSubtractWorkSize(coverCount)];
+    int32_t *pEdges = pWork ? pWork : pAllocated;
+    int32_t *pStarts = pEdges + (coverCount * 2) + 2;
+    int32_t *pEnds = pStarts + coverCount + 1;
+    int edgeCount = 0;
+
+    pEdges[edgeCount++] = area.y;
+    pEdges[edgeCount++] = area.bottom();
+    for (int i = 0; i < coverCount; i++)
+    {
+        if (!pCovers[i].intersects(area))
+            continue;
+        if (pCovers[i].y > area.y)
+            pEdges[edgeCount++] = pCovers[i].y;
+        if (pCovers[i].bottom() < area.bottom())
+            pEdges[edgeCount++] = pCovers[i].bottom();
+    }
+
+    //insertion sort, the lists are short
+    for (int i = 1; i < edgeCount; i++)
+    {
+        int32_t edge = pEdges[i];
+        int j = i - 1;
+        while (j >= 0 && pEdges[j] > edge)
+        {
+            pEdges[j + 1] = pEdges[j];
+            j--;
+        }
+        pEdges[j + 1] = edge;
+    }
+
+    int spanCount = 0;
+    for (int band = 0; band < edgeCount - 1; band++)
+    {
+        int32_t top = pEdges[band],
+                bottom = pEdges[band + 1];
+        if (top == bottom)
+            continue;
+
+        //collect the covered runs in this band, sorted by start
+        int runCount = 0;
+        for (int i = 0; i < coverCount; i++)
+        {
+            const DisplayRect &cover = pCovers[i];
+            if (cover.isEmpty() || cover.y > top || cover.bottom() < bottom)
+                continue;
+
+            int32_t start = max((int32_t)cover.x, (int32_t)area.x),
+                    end = min(cover.right(), area.right());
+            if (start >= end)
+                continue;
+
+            int j = runCount - 1;
+            while (j >= 0 && pStarts[j] > start)
+            {
+                pStarts[j + 1] = pStarts[j];
+                pEnds[j + 1] = pEnds[j];
+                j--;
+            }
+            pStarts[j + 1] = start;
+            pEnds[j + 1] = end;
+            runCount++;
+        }
+
+        //report the gaps between the runs
+        int32_t cursor = area.x;
+        for (int i = 0; i <= runCount; i++)
+        {
+            int32_t runStart = i < runCount ? pStarts[i] : area.right();
+            if (runStart > cursor)
+            {
+                spanCount++;
+                if (onSpan)
+                    onSpan(DisplayRect(cursor, top, runStart - cursor, bottom - top), pContext);
+            }
+            if (i < runCount && pEnds[i] > cursor)
+                cursor = pEnds[i];
+        }
+    }
+
+    delete[] pAllocated;
+    return spanCount;
+}
@@ -0,0 +1,88 @@
+#ifndef DISPLAYRECT_H
+#define DISPLAYRECT_H
+
+#include <Arduino.h>
+
+class DisplayRect;
+
+/**
+ * @brief Called for every uncovered span found by DisplayRect::subtract
+ *
+ */
+typedef void (*OnDisplayRectSpan) (const DisplayRect &span, void *pContext);
+
+/**
+ * @brief A screen rectangle, used for hit testing and for finding out which parts of the screen need to be painted.
+ *
+ */
+class DisplayRect
+{
+public:
+    int16_t x;
+    int16_t y;
+    int16_t width;
+    int16_t height;
+
+    DisplayRect();
+    DisplayRect(int16_t x, int16_t y, int16_t width, int16_t height);
+
+    int32_t right() const { return (int32_t)x + width; };
+    int32_t bottom() const { return (int32_t)y + height; };
+    bool isEmpty() const { return width <= 0 || height <= 0; };
+
+    /**
+     * @brief Checks if the given rectangle is completely inside this rectangle
+     *
+     * @param rect The rectangle to test
+     * @return true if every pixel of rect is also a pixel of this rectangle
+     */
+    bool contains(const DisplayRect &rect) const;
+
+    /**
+     * @brief Checks if the rectangles share at least one pixel
+     *
+     */
+    bool intersects(const DisplayRect &rect) const;
+
+    /**
+     * @brief Get the area shared by this and another rectangle
+     *
+     * @return DisplayRect an empty rectangle if they do not intersect
+     */
+    DisplayRect intersection(const DisplayRect &rect) const;
+
+    /**
+     * @brief Get the smallest rectangle holding both this and another rectangle, an empty rectangle is left out
+     *
+     */
+    DisplayRect united(const DisplayRect &rect) const;
+
+    /**
+     * @brief Splits the part of an area which is not covered by any of the given rectangles into horizontal spans.
+     *
+     * The area is cut into bands at the top and bottom edges of the covering rectangles,
+     * and every uncovered run of pixels in a band is reported as one span.
+     *
+     * @param area The area to test
+     * @param pCovers Rectangles covering parts of the area
+     * @param coverCount Number of rectangles in pCovers
+     * @param onSpan Function called for every uncovered span, can be NULL if only the count is needed
+     * @param pContext Passed on to onSpan
+     * @param pWork Memory for getSubtractWorkSize(coverCount) values, allocated for the call when NULL
+     * @return int Number of uncovered spans, 0 means the area is fully covered
+     */
+    static int subtract(const DisplayRect &area,
+                        const DisplayRect *pCovers,
+                        int coverCount,
+                        OnDisplayRectSpan onSpan = NULL,
+                        void *pContext = NULL,
+                        int32_t *pWork = NULL);
+
+    /**
+     * @brief Number of values subtract needs for it's work memory with the given number of covers
+     *
+     */
+    static int getSubtractWorkSize(int coverCount) { return (coverCount * 4) + 4; };
+};
+
+#endif
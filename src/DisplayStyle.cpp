@@ -0,0 +1,123 @@
+#include "DisplayStyle.h"
+
+DisplayStyle *DisplayStyle::_pFirst = NULL;
+uint32_t DisplayStyle::_lastChange = 0;
+
+DisplayStyle::DisplayStyle(uint16_t outlineColor, uint16_t fillColor, uint16_t textColor, uint8_t textsize, uint8_t radius, DisplayFont *pFont, bool shared)
+{
+    _outlineColor = outlineColor;
+    _fillColor = fillColor;
+    _textColor = textColor;
+    _textsize = textsize;
+    _radius = radius;
+    _pFont = pFont;
+    _shared = shared;
+    _references = 1;
+    _changeCount = 0;
+    _pNext = _pFirst;
+    _pFirst = this;
+}
+
+DisplayStyle::~DisplayStyle()
+{
+    DisplayStyle **ppStyle = &_pFirst;
+    while (*ppStyle && *ppStyle != this)
+        ppStyle = &(*ppStyle)->_pNext;
+    if (*ppStyle)
+        *ppStyle = _pNext;
+}
+
+DisplayStyle *DisplayStyle::get(uint16_t outlineColor, uint16_t fillColor, uint16_t textColor, uint8_t textsize, uint8_t radius, DisplayFont *pFont)
+{
+    for (DisplayStyle *pStyle = _pFirst; pStyle; pStyle = pStyle->_pNext)
+    {
+        if (pStyle->_shared && pStyle->_outlineColor == outlineColor && pStyle->_fillColor == fillColor &&
+            pStyle->_textColor == textColor && pStyle->_textsize == textsize && pStyle->_radius == radius && pStyle->_pFont == pFont)
+        {
+            pStyle->retain();
+            return pStyle;
+        }
+    }
+    return new DisplayStyle(outlineColor, fillColor, textColor, textsize, radius, pFont, true);
+}
+
+DisplayStyle *DisplayStyle::create(uint16_t outlineColor, uint16_t fillColor, uint16_t textColor, uint8_t textsize, uint8_t radius, DisplayFont *pFont)
+{
+    return new DisplayStyle(outlineColor, fillColor, textColor, textsize, radius, pFont, false);
+}
+
+void DisplayStyle::release()
+{
+    if (_references > 0)
+        _references--;
+    if (_references == 0)
+        delete this;
+}
+
+void DisplayStyle::changed()
+{
+    _changeCount = ++_lastChange;
+}
+
+bool DisplayStyle::setColors(uint16_t outlineColor, uint16_t fillColor, uint16_t textColor)
+{
+    //items which only looked the same as the changed item would change with it
+    if (_shared)
+        return false;
+
+    if (_outlineColor == outlineColor && _fillColor == fillColor && _textColor == textColor)
+        return true;
+
+    _outlineColor = outlineColor;
+    _fillColor = fillColor;
+    _textColor = textColor;
+    changed();
+    return true;
+}
+
+bool DisplayStyle::setTextSize(uint8_t textsize)
+{
+    if (_shared)
+        return false;
+
+    if (_textsize == textsize)
+        return true;
+
+    _textsize = textsize;
+    changed();
+    return true;
+}
+
+bool DisplayStyle::setRadius(uint8_t radius)
+{
+    if (_shared)
+        return false;
+
+    if (_radius == radius)
+        return true;
+
+    _radius = radius;
+    changed();
+    return true;
+}
+
+bool DisplayStyle::setFont(DisplayFont *pFont)
+{
+    if (_shared)
+        return false;
+
+    if (_pFont == pFont)
+        return true;
+
+    _pFont = pFont;
+    changed();
+    return true;
+}
+
+uint16_t DisplayStyle::getCount()
+{
+    uint16_t count = 0;
+    for (DisplayStyle *pStyle = _pFirst; pStyle; pStyle = pStyle->_pNext)
+        count++;
+    return count;
+}
@@ -0,0 +1,128 @@
+#ifndef DISPLAYSTYLE_H
+#define DISPLAYSTYLE_H
+
+#include <Arduino.h>
+
+#include "DisplayMemory.h"
+#include "DisplayFont.h"
+
+/**
+ * @brief A radius which makes the corners of an item depend on it's size, a sixth of the shorter side.
+ *
+ */
+#define DISPLAY_STYLE_AUTO_RADIUS 0xFF
+
+/**
+ * @brief Colors, text size, corner radius and font shared by buttons and labels.
+ *
+ * Buttons and labels do not store their own colors, they point to a style. Items created with the same colors
+ * share one style, so a page of buttons which look the same only keeps one copy of how they look.
+ * A style lives for as long as an item uses it, items keep a reference to it and the last one to let go deletes it.
+ *
+ * Styles returned by get are shared by every item which looks the same, so they can not be changed, the setters
+ * return false for them. Styles made with create are never shared by accident and can be changed,
+ * changing one changes exactly the items it was given to.
+ * When a style changes, the menu draws the items using it again on it's next update, the rest of the page is not drawn.
+ *
+ * @code .cpp
+ * DisplayStyle *pKeys = DisplayStyle::create(TFT_WHITE, TFT_NAVY, TFT_WHITE, 1);
+ * for (int i = 0; i < 10; i++)
+ *     pPage->addIncrementButton(...)->setStyle(pKeys);
+ * pKeys->release(); //the buttons keep it alive
+ *
+ * //night mode, only the keys are drawn again
+ * pKeys->setColors(TFT_DARKGREY, TFT_BLACK, TFT_RED);
+ * @endcode
+ */
+class DisplayStyle
+{
+private:
+    uint16_t _outlineColor;
+    uint16_t _fillColor;
+    uint16_t _textColor;
+    uint8_t _textsize;
+    uint8_t _radius;
+    DisplayFont *_pFont;
+    bool _shared;
+    uint16_t _references;
+    uint32_t _changeCount;
+    DisplayStyle *_pNext;
+
+    static DisplayStyle *_pFirst;
+    static uint32_t _lastChange;
+
+    DisplayStyle(uint16_t outlineColor, uint16_t fillColor, uint16_t textColor, uint8_t textsize, uint8_t radius, DisplayFont *pFont, bool shared);
+    ~DisplayStyle();
+    void changed();
+
+public:
+    DISPLAY_MEMORY_TRACKED
+
+    /**
+     * @brief Get a shared style with these values, it is created if no item uses one yet.
+     * The caller owns one reference and must release it.
+     *
+     * @param pFont The font, NULL uses the menu font
+     */
+    static DisplayStyle *get(uint16_t outlineColor, uint16_t fillColor, uint16_t textColor, uint8_t textsize, uint8_t radius = DISPLAY_STYLE_AUTO_RADIUS, DisplayFont *pFont = NULL);
+
+    /**
+     * @brief Create a style which get never returns, to be given to items with setStyle and changed later.
+     * The caller owns one reference and must release it.
+     *
+     */
+    static DisplayStyle *create(uint16_t outlineColor, uint16_t fillColor, uint16_t textColor, uint8_t textsize, uint8_t radius = DISPLAY_STYLE_AUTO_RADIUS, DisplayFont *pFont = NULL);
+
+    void retain() { _references++; };
+
+    /**
+     * @brief Lets go of a reference, the style is deleted when no one references it
+     *
+     */
+    void release();
+    uint16_t getReferenceCount() { return _references; };
+    bool isShared() { return _shared; };
+
+    uint16_t getOutlineColor() { return _outlineColor; };
+    uint16_t getFillColor() { return _fillColor; };
+    uint16_t getTextColor() { return _textColor; };
+    uint8_t getTextSize() { return _textsize; };
+    uint8_t getRadius() { return _radius; };
+
+    /**
+     * @brief The font of the style, NULL when the menu font is used
+     *
+     */
+    DisplayFont *getFont() { return _pFont; };
+
+    /**
+     * @brief The corner radius of an item of this size
+     *
+     */
+    uint8_t getRadius(uint16_t width, uint16_t height) { return _radius == DISPLAY_STYLE_AUTO_RADIUS ? min(width, height) / 6 : _radius; };
+
+    /**
+     * @brief Changes a style made with create, the items using it are drawn again on the next update
+     *
+     * @return false if the style is shared, it is not changed
+     */
+    bool setColors(uint16_t outlineColor, uint16_t fillColor, uint16_t textColor);
+    bool setTextSize(uint8_t textsize);
+    bool setRadius(uint8_t radius);
+    bool setFont(DisplayFont *pFont);
+
+    /**
+     * @brief A number which grows every time any style changes, styles changed after a given number need to be drawn
+     *
+     */
+    static uint32_t getLastChange() { return _lastChange; };
+    bool isChangedSince(uint32_t change) { return _changeCount > change; };
+
+    /**
+     * @brief How many styles exist
+     *
+     */
+    static uint16_t getCount();
+};
+
+#endif
@@ -0,0 +1,126 @@
+#include "DisplayTextCache.h"
+
+DisplayTextCache::DisplayTextCache(TFT_eSPI *tft, size_t maxBytes)
+{
+    _tft = tft;
+    _maxBytes = maxBytes;
+    _usedBytes = 0;
+    _hits = 0;
+    _misses = 0;
+}
+
+int DisplayTextCache::find(const String &text, const GFXfont *pFont, uint8_t textsize)
+{
+    for (int i = 0; i < _size; i++)
+    {
+        DISPLAY_TEXT_CACHE_ENTRY *pEntry = get(i);
+        if (pEntry->pFont == pFont && pEntry->textsize == textsize && pEntry->text.equals(text))
+            return i;
+    }
+    return -1;
+}
+
+DISPLAY_TEXT_CACHE_ENTRY *DisplayTextCache::render(const String &text, const GFXfont *pFont, uint8_t textsize)
+{
+    int16_t width = _tft->textWidth(text),
+            height = _tft->fontHeight();
+
+    if (width < 1 || height < 1)
+        return NULL;
+
+    size_t bytes = (((width + 7) / 8) * height) + sizeof(TFT_eSprite) + sizeof(DISPLAY_TEXT_CACHE_ENTRY) + text.length();
+    if (bytes > _maxBytes)
+        return NULL;
+
+    while (_size > 0 && _usedBytes + bytes > _maxBytes)
+        removeEntry(_size - 1);
+
+    TFT_eSprite *pSprite = new TFT_eSprite(_tft);
+    pSprite->setColorDepth(1);
+    if (!pSprite->createSprite(width, height))
+    {
+        delete pSprite;
+        return NULL;
+    }
+
+    pSprite->fillSprite(TFT_BLACK);
+    pSprite->setFreeFont(pFont);
+    pSprite->setTextSize(textsize);
+    pSprite->setTextColor(TFT_WHITE);
+    pSprite->setTextDatum(ML_DATUM);
+    pSprite->setTextPadding(0);
+    pSprite->drawString(text, 0, height / 2);
+
+    DISPLAY_TEXT_CACHE_ENTRY *pEntry = new DISPLAY_TEXT_CACHE_ENTRY;
+    pEntry->text = text;
+    pEntry->pFont = pFont;
+    pEntry->textsize = textsize;
+    pEntry->yOffset = height / 2;
+    pEntry->bytes = bytes;
+    pEntry->pSprite = pSprite;
+
+    unshift(pEntry);
+    _usedBytes += bytes;
+    return pEntry;
+}
+
+void DisplayTextCache::removeEntry(int index)
+{
+    DISPLAY_TEXT_CACHE_ENTRY *pEntry = remove(index);
+    if (pEntry == NULL)
+        return;
+
+    _usedBytes -= pEntry->bytes;
+    pEntry->pSprite->deleteSprite();
+    delete pEntry->pSprite;
+    delete pEntry;
+}
+
+bool DisplayTextCache::drawString(const GFXfont *pFont, const String &text, int32_t x, int32_t y, uint16_t textColor, uint16_t backColor, DisplayRect bounds)
+{
+    if (text.length() == 0)
+        return false;
+
+    uint8_t textsize = _tft->textsize;
+    DISPLAY_TEXT_CACHE_ENTRY *pEntry = NULL;
+    int index = find(text, pFont, textsize);
+
+    if (index > -1)
+    {
+        pEntry = get(index);
+        if (index > 0)
+        {
+            //most recently used entries are kept first
+            remove(index);
+            unshift(pEntry);
+        }
+        _hits++;
+    }
+    else
+    {
+        //do not spend memory on texts which would not be drawn from the cache anyway
+        DisplayRect textBox(x, y - (_tft->fontHeight() / 2), _tft->textWidth(text), _tft->fontHeight());
+        if (!bounds.contains(textBox))
+            return false;
+
+        pEntry = render(text, pFont, textsize);
+        if (pEntry == NULL)
+            return false;
+        _misses++;
+    }
+
+    DisplayRect textBox(x, y - pEntry->yOffset, pEntry->pSprite->width(), pEntry->pSprite->height());
+    if (!bounds.contains(textBox))
+        return false;
+
+    pEntry->pSprite->setBitmapColor(textColor, backColor);
+    pEntry->pSprite->pushSprite(textBox.x, textBox.y);
+    return true;
+}
+
+void DisplayTextCache::destory()
+{
+    while (_size > 0)
+        removeEntry(_size - 1);
+    clear();
+}
@@ -0,0 +1,93 @@
+#ifndef DISPLAYTEXTCACHE_H
+#define DISPLAYTEXTCACHE_H
+
+#include <Arduino.h>
+
+#include <TFT_eSPI.h>
+
+#include "LinkedList.h"
+#include "DisplayRect.h"
+
+/**
+ * @brief One pre-rendered text, stored as a 1 bit per pixel sprite.
+ * The colors are applied when the sprite is pushed so the same entry
+ * serves both the normal and the inverted (pressed) look of a button.
+ */
+struct DISPLAY_TEXT_CACHE_ENTRY {
+    String text;
+    const GFXfont *pFont;
+    uint8_t textsize;
+    int16_t yOffset;
+    size_t bytes;
+    TFT_eSprite *pSprite;
+};
+
+/**
+ * @brief A least recently used cache of rendered texts.
+ *
+ * Rendering a text with a GFX free font draws it glyph by glyph, pixel run by pixel run.
+ * This cache renders a text once into a 1 bit sprite and later draws are a single pushSprite call.
+ * The most recently used entry is kept first in the list and entries are removed
+ * from the end of the list when the cache grows over it's memory limit.
+ */
+class DisplayTextCache : public LinkedList<DISPLAY_TEXT_CACHE_ENTRY*>
+{
+private:
+    TFT_eSPI *_tft;
+    size_t _maxBytes;
+    size_t _usedBytes;
+    unsigned long _hits;
+    unsigned long _misses;
+
+    int find(const String &text, const GFXfont *pFont, uint8_t textsize);
+    DISPLAY_TEXT_CACHE_ENTRY *render(const String &text, const GFXfont *pFont, uint8_t textsize);
+    void removeEntry(int index);
+
+    /**
+     * @brief The cleanup function used by the list's deconstructor;
+     *
+     */
+    void destory();
+
+public:
+    /**
+     * @brief Construct a new Display Text Cache object
+     *
+     * @param tft The display the texts will be drawn on
+     * @param maxBytes How much memory the cached sprites may use in total
+     */
+    DisplayTextCache(TFT_eSPI *tft, size_t maxBytes);
+
+    /**
+     * @brief Draws a text using the ML_DATUM the same way TFT_eSPI::drawString would.
+     *
+     * The font and text size must already be selected on the display.
+     *
+     * @param pFont The font selected on the display, used as a part of the cache key
+     * @param text Text to draw
+     * @param x Left side of the text
+     * @param y Vertical middle of the text
+     * @param textColor Color of the text
+     * @param backColor Color of the pixels around the glyphs
+     * @param bounds The text is only drawn from cache if the whole text box is inside these bounds
+     * @return true if the text was drawn
+     * @return false if the text was not drawn and the caller should draw it without the cache.
+     */
+    bool drawString(const GFXfont *pFont, const String &text, int32_t x, int32_t y, uint16_t textColor, uint16_t backColor, DisplayRect bounds);
+
+    /**
+     * @brief Removes all entries from the cache
+     *
+     */
+    void flush() { destory(); }
+
+    TFT_eSPI *getDisplay() { return _tft; };
+    size_t getMaxBytes() { return _maxBytes; };
+    size_t getUsedBytes() { return _usedBytes; };
+    unsigned long getHits() { return _hits; };
+    unsigned long getMisses() { return _misses; };
+
+    virtual ~DisplayTextCache() { destory(); }
+};
+
+#endif
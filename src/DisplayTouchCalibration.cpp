@@ -0,0 +1,137 @@
+#include "DisplayTouchCalibration.h"
+
+#if defined(ESP32)
+#include <Preferences.h>
+
+#define DISPLAY_TOUCH_CALIBRATION_NAMESPACE "displaymenu"
+#define DISPLAY_TOUCH_CALIBRATION_KEY "touchcal"
+#endif
+
+DisplayTouchCalibration::DisplayTouchCalibration()
+{
+    _pFs = NULL;
+    _path = NULL;
+    memset(&_record, 0, sizeof(_record));
+}
+
+void DisplayTouchCalibration::setFile(fs::FS &fs, const char *path)
+{
+    _pFs = &fs;
+    _path = path;
+}
+
+uint32_t DisplayTouchCalibration::crc32(const uint8_t *pData, size_t size)
+{
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < size; i++)
+    {
+        crc ^= pData[i];
+        for (uint8_t bit = 0; bit < 8; bit++)
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+    }
+    return ~crc;
+}
+
+bool DisplayTouchCalibration::readRecord(DISPLAY_TOUCH_CALIBRATION_RECORD *pRecord)
+{
+    if (_pFs)
+    {
+        File f = _pFs->open(_path, "r");
+        if (!f)
+            return false;
+        bool ok = f.read((uint8_t *)pRecord, sizeof(*pRecord)) == sizeof(*pRecord);
+        f.close();
+        return ok;
+    }
+
+#if defined(ESP32)
+    Preferences preferences;
+    if (!preferences.begin(DISPLAY_TOUCH_CALIBRATION_NAMESPACE, true))
+        return false;
+    bool ok = preferences.getBytes(DISPLAY_TOUCH_CALIBRATION_KEY, pRecord, sizeof(*pRecord)) == sizeof(*pRecord);
+    preferences.end();
+    return ok;
+#else
+    return false;
+#endif
+}
+
+bool DisplayTouchCalibration::writeRecord(const DISPLAY_TOUCH_CALIBRATION_RECORD *pRecord)
+{
+    if (_pFs)
+    {
+        File f = _pFs->open(_path, "w");
+        if (!f)
+            return false;
+        bool ok = f.write((const uint8_t *)pRecord, sizeof(*pRecord)) == sizeof(*pRecord);
+        f.close();
+        return ok;
+    }
+
+#if defined(ESP32)
+    Preferences preferences;
+    if (!preferences.begin(DISPLAY_TOUCH_CALIBRATION_NAMESPACE, false))
+        return false;
+    bool ok = preferences.putBytes(DISPLAY_TOUCH_CALIBRATION_KEY, pRecord, sizeof(*pRecord)) == sizeof(*pRecord);
+    preferences.end();
+    return ok;
+#else
+    return false;
+#endif
+}
+
+bool DisplayTouchCalibration::load(TFT_eSPI *tft)
+{
+    DISPLAY_TOUCH_CALIBRATION_RECORD record;
+    if (!readRecord(&record))
+        return false;
+
+    if (record.magic != DISPLAY_TOUCH_CALIBRATION_MAGIC || record.version != DISPLAY_TOUCH_CALIBRATION_VERSION)
+        return false;
+
+    if (record.crc != crc32((const uint8_t *)&record, offsetof(DISPLAY_TOUCH_CALIBRATION_RECORD, crc)))
+        return false;
+
+    if (record.rotation != tft->getRotation())
+        return false;
+
+    _record = record;
+    tft->setTouch(_record.data);
+    return true;
+}
+
+bool DisplayTouchCalibration::calibrate(TFT_eSPI *tft, uint16_t cornerColor, uint16_t backColor)
+{
+    tft->fillScreen(backColor);
+    tft->setCursor(20, 0);
+    tft->setTextFont(2);
+    tft->setTextSize(1);
+    tft->setTextColor(TFT_WHITE, backColor);
+    tft->println("Touch corners as indicated");
+
+    tft->calibrateTouch(_record.data, cornerColor, backColor, 15);
+
+    _record.magic = DISPLAY_TOUCH_CALIBRATION_MAGIC;
+    _record.version = DISPLAY_TOUCH_CALIBRATION_VERSION;
+    _record.rotation = tft->getRotation();
+    _record.crc = crc32((const uint8_t *)&_record, offsetof(DISPLAY_TOUCH_CALIBRATION_RECORD, crc));
+    return writeRecord(&_record);
+}
+
+void DisplayTouchCalibration::clear()
+{
+    if (_pFs)
+    {
+        _pFs->remove(_path);
+        return;
+    }
+
+#if defined(ESP32)
+    Preferences preferences;
+    if (preferences.begin(DISPLAY_TOUCH_CALIBRATION_NAMESPACE, false))
+    {
+        preferences.remove(DISPLAY_TOUCH_CALIBRATION_KEY);
+        preferences.end();
+    }
+#endif
+}
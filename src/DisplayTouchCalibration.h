@@ -0,0 +1,76 @@
+#ifndef DISPLAYTOUCHCALIBRATION_H
+#define DISPLAYTOUCHCALIBRATION_H
+
+#include <Arduino.h>
+
+#include <FS.h>
+#include <TFT_eSPI.h>
+
+#define DISPLAY_TOUCH_CALIBRATION_MAGIC 0x4443
+#define DISPLAY_TOUCH_CALIBRATION_VERSION 1
+
+/**
+ * @brief The stored touch calibration.
+ * The calibration depends on the rotation of the display, so the rotation is stored with it
+ * and a record saved for another rotation is not used.
+ */
+struct DISPLAY_TOUCH_CALIBRATION_RECORD {
+    uint16_t magic;
+    uint8_t version;
+    uint8_t rotation;
+    uint16_t data[5];
+    uint32_t crc;
+};
+
+/**
+ * @brief Loads and saves the touch calibration as a small CRC checked record.
+ *
+ * By default the record is kept in the ESP32 NVS (Preferences), which is ready without mounting a file system.
+ * A file can be used instead with setFile, the file system must then be mounted before the menu begins.
+ * On other boards without a file set nothing is stored and the touch screen is calibrated on every boot.
+ */
+class DisplayTouchCalibration
+{
+private:
+    fs::FS *_pFs;
+    const char *_path;
+    DISPLAY_TOUCH_CALIBRATION_RECORD _record;
+
+    bool readRecord(DISPLAY_TOUCH_CALIBRATION_RECORD *pRecord);
+    bool writeRecord(const DISPLAY_TOUCH_CALIBRATION_RECORD *pRecord);
+
+public:
+    DisplayTouchCalibration();
+
+    /**
+     * @brief Store the calibration in a file instead of the NVS
+     *
+     * @param fs A mounted file system, for example SPIFFS or LittleFS
+     * @param path Path of the file, the string must exist as long as the menu does
+     */
+    void setFile(fs::FS &fs, const char *path);
+
+    /**
+     * @brief Reads the stored calibration and applies it to the display
+     *
+     * @return true if a valid record for the display's current rotation was found
+     */
+    bool load(TFT_eSPI *tft);
+
+    /**
+     * @brief Runs the TFT_eSPI touch calibration on the screen and stores the result
+     *
+     * @return true if the result was stored
+     */
+    bool calibrate(TFT_eSPI *tft, uint16_t cornerColor = TFT_MAGENTA, uint16_t backColor = TFT_BLACK);
+
+    /**
+     * @brief Removes the stored calibration, the touch screen will be calibrated again on the next begin
+     *
+     */
+    void clear();
+
+    static uint32_t crc32(const uint8_t *pData, size_t size);
+};
+
+#endif
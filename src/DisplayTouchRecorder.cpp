@@ -0,0 +1,162 @@
+#include "DisplayTouchRecorder.h"
+
+DisplayTouchRecorder::DisplayTouchRecorder(uint16_t capacity)
+{
+    _capacity = capacity;
+    _pSamples = new DISPLAY_TOUCH_SAMPLE[_capacity];
+    _count = 0;
+    _recording = false;
+    _replaying = false;
+    _overflow = false;
+    _replaySample = 0;
+    _replayRead = 0;
+    clearLatency();
+}
+
+DisplayTouchRecorder::~DisplayTouchRecorder()
+{
+    delete[] _pSamples;
+}
+
+void DisplayTouchRecorder::record()
+{
+    _count = 0;
+    _overflow = false;
+    _replaying = false;
+    _recording = true;
+}
+
+void DisplayTouchRecorder::replay()
+{
+    _recording = false;
+    _replaySample = 0;
+    _replayRead = 0;
+    _replaying = _count > 0;
+}
+
+void DisplayTouchRecorder::stop()
+{
+    _recording = false;
+    _replaying = false;
+}
+
+void DisplayTouchRecorder::add(uint16_t x, uint16_t y, bool pressed)
+{
+    if (!_recording)
+        return;
+
+    //where a released screen is read does not matter
+    if (!pressed)
+        x = y = 0;
+
+    if (_count > 0)
+    {
+        DISPLAY_TOUCH_SAMPLE &last = _pSamples[_count - 1];
+        if (last.pressed == pressed && last.x == x && last.y == y && last.reads < 0xFFFF)
+        {
+            last.reads++;
+            return;
+        }
+    }
+
+    if (_count >= _capacity)
+    {
+        _overflow = true;
+        _recording = false;
+        return;
+    }
+
+    DISPLAY_TOUCH_SAMPLE &sample = _pSamples[_count++];
+    sample.x = x;
+    sample.y = y;
+    sample.pressed = pressed;
+    sample.reads = 1;
+}
+
+bool DisplayTouchRecorder::next(uint16_t *pX, uint16_t *pY, bool *pPressed)
+{
+    if (!_replaying || _replaySample >= _count)
+    {
+        _replaying = false;
+        *pPressed = false;
+        return false;
+    }
+
+    DISPLAY_TOUCH_SAMPLE &sample = _pSamples[_replaySample];
+    *pX = sample.x;
+    *pY = sample.y;
+    *pPressed = sample.pressed;
+    if (++_replayRead >= sample.reads)
+    {
+        _replayRead = 0;
+        _replaySample++;
+    }
+    return true;
+}
+
+void DisplayTouchRecorder::save(Print &out)
+{
+    for (uint16_t i = 0; i < _count; i++)
+    {
+        DISPLAY_TOUCH_SAMPLE &sample = _pSamples[i];
+        out.printf("%u %u %u %u\n", sample.reads, sample.pressed ? 1 : 0, sample.x, sample.y);
+    }
+}
+
+bool DisplayTouchRecorder::load(Stream &in)
+{
+    stop();
+    _count = 0;
+    while (in.available())
+    {
+        long reads = in.parseInt();
+        long pressed = in.parseInt();
+        long x = in.parseInt();
+        long y = in.parseInt();
+        if (reads < 1)
+            break;
+
+        if (_count >= _capacity)
+            return false;
+
+        DISPLAY_TOUCH_SAMPLE &sample = _pSamples[_count++];
+        sample.reads = (uint16_t)min(reads, 0xFFFFL);
+        sample.pressed = pressed != 0;
+        sample.x = (uint16_t)x;
+        sample.y = (uint16_t)y;
+    }
+    return true;
+}
+
+void DisplayTouchRecorder::addTimes(const DISPLAY_TOUCH_TIMES &times)
+{
+    for (int i = 0; i < TOUCH_STAGE_COUNT; i++)
+    {
+        uint32_t elapsed = times.stage[i] - times.stage[TOUCH_SAMPLE];
+        DISPLAY_TOUCH_LATENCY &latency = _latency[i];
+        if (latency.count == 0 || elapsed < latency.min)
+            latency.min = elapsed;
+        if (elapsed > latency.max)
+            latency.max = elapsed;
+        latency.total += elapsed;
+        latency.count++;
+    }
+}
+
+void DisplayTouchRecorder::clearLatency()
+{
+    memset(_latency, 0, sizeof(_latency));
+}
+
+void DisplayTouchRecorder::printReport(Print &out)
+{
+    static const char *names[TOUCH_STAGE_COUNT] = {"sample", "hit test", "flushed", "callback"};
+
+    out.printf("%-12s %8s %10s %10s %10s\n", "stage", "presses", "min us", "avg us", "max us");
+    for (int i = 0; i < TOUCH_STAGE_COUNT; i++)
+    {
+        DISPLAY_TOUCH_LATENCY &latency = _latency[i];
+        uint32_t average = latency.count ? (uint32_t)(latency.total / latency.count) : 0;
+        out.printf("%-12s %8u %10u %10u %10u\n", names[i], latency.count, latency.min, average, latency.max);
+    }
+}
@@ -0,0 +1,164 @@
+#ifndef DISPLAYTOUCHRECORDER_H
+#define DISPLAYTOUCHRECORDER_H
+
+#include <Arduino.h>
+
+/**
+ * @brief The steps from reading a touch to running the pressed button's function.
+ *
+ */
+enum DisplayTouchStage {
+    TOUCH_SAMPLE,     //the touch screen was read and it was pressed
+    TOUCH_HIT_TEST,   //the pressed button was found, drawing it inverted starts
+    TOUCH_FLUSHED,    //the inverted buttons have been sent to the display
+    TOUCH_CALLBACK,   //the button's command started, the time the press was shown and held is not counted
+    TOUCH_STAGE_COUNT
+};
+
+/**
+ * @brief When each step of handling the last press happened, in micros()
+ *
+ */
+struct DISPLAY_TOUCH_TIMES {
+    uint32_t stage[TOUCH_STAGE_COUNT];
+};
+
+/**
+ * @brief One or more readings of the touch screen which were the same.
+ *
+ */
+struct DISPLAY_TOUCH_SAMPLE {
+    uint16_t x;
+    uint16_t y;
+    bool pressed;
+    uint16_t reads; //how many times in a row the touch screen was read like this
+};
+
+/**
+ * @brief Microseconds from the touch screen reading to a step, for all presses measured.
+ *
+ */
+struct DISPLAY_TOUCH_LATENCY {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+};
+
+/**
+ * @brief Records what the menu reads from the touch screen so it can be replayed, and measures
+ * how long it takes from a press being read until the button is drawn pressed and it's command runs.
+ *
+ * While recording, every reading of the touch screen is kept, readings which are the same as the one
+ * before are counted instead of stored again. While replaying, the menu reads the recorded samples
+ * instead of the touch screen, one for each time it would have read the screen.
+ * The replay does not depend on timing, so it takes the menu through the same pages and buttons every time.
+ *
+ * @code .cpp
+ * DisplayTouchRecorder recorder(500);
+ * menu.setTouchRecorder(&recorder);
+ * recorder.record();
+ * //... use the menu
+ * recorder.save(Serial);
+ *
+ * //later, or on a host build with a fake display
+ * recorder.load(recordedStream);
+ * recorder.replay();
+ * while (recorder.isReplaying())
+ *     menu.update();
+ * recorder.printReport(Serial);
+ * @endcode
+ */
+class DisplayTouchRecorder
+{
+private:
+    DISPLAY_TOUCH_SAMPLE *_pSamples;
+    uint16_t _capacity;
+    uint16_t _count;
+    bool _recording;
+    bool _replaying;
+    bool _overflow;
+    uint16_t _replaySample;
+    uint16_t _replayRead;
+    DISPLAY_TOUCH_LATENCY _latency[TOUCH_STAGE_COUNT];
+
+public:
+    /**
+     * @brief Construct a new Display Touch Recorder object
+     *
+     * @param capacity How many different samples can be recorded
+     */
+    DisplayTouchRecorder(uint16_t capacity);
+    ~DisplayTouchRecorder();
+
+    /**
+     * @brief Removes the recorded samples and starts recording
+     *
+     */
+    void record();
+
+    /**
+     * @brief Starts feeding the recorded samples to the menu from the first one
+     *
+     */
+    void replay();
+
+    /**
+     * @brief Stops recording or replaying
+     *
+     */
+    void stop();
+    bool isRecording() { return _recording; };
+    bool isReplaying() { return _replaying; };
+
+    /**
+     * @brief Was recording stopped because there was no room for more samples
+     *
+     */
+    bool isOverflow() { return _overflow; };
+
+    /**
+     * @brief Called by the menu with every reading of the touch screen while recording
+     *
+     */
+    void add(uint16_t x, uint16_t y, bool pressed);
+
+    /**
+     * @brief Called by the menu instead of reading the touch screen while replaying
+     *
+     * @return false when all samples have been replayed, the replay is then stopped
+     */
+    bool next(uint16_t *pX, uint16_t *pY, bool *pPressed);
+
+    uint16_t getSampleCount() { return _count; };
+    const DISPLAY_TOUCH_SAMPLE *getSample(uint16_t index) { return index < _count ? &_pSamples[index] : NULL; };
+
+    /**
+     * @brief Writes the samples as text, one sample on each line as "reads pressed x y"
+     *
+     */
+    void save(Print &out);
+
+    /**
+     * @brief Reads samples written by save
+     *
+     * @return true if all the samples fit
+     */
+    bool load(Stream &in);
+
+    /**
+     * @brief Adds the times of a press to the latency report, called by the menu after the button's command ran
+     *
+     */
+    void addTimes(const DISPLAY_TOUCH_TIMES &times);
+    const DISPLAY_TOUCH_LATENCY &getLatency(DisplayTouchStage stage) { return _latency[stage]; };
+    void clearLatency();
+
+    /**
+     * @brief Prints the count, minimum, average and maximum time from the touch screen reading to each step
+     *
+     */
+    void printReport(Print &out);
+};
+
+#endif
@@ -0,0 +1,161 @@
+#ifndef DISPLAYVALUE_H
+#define DISPLAYVALUE_H
+
+#include <Arduino.h>
+
+#include "DisplayNumberFormat.h"
+
+/**
+ * @brief A variable a button or a label is bound to, which knows how to change it by steps and how to write it.
+ *
+ * Buttons and labels only see this interface, DisplayBinding implements it for each type of variable.
+ */
+class DisplayValue
+{
+public:
+    virtual ~DisplayValue() {}
+
+    /**
+     * @brief Adds steps times the binding's step to the variable, keeping it between the minimum and the maximum
+     *
+     * @return true if the variable changed
+     */
+    virtual bool step(int16_t steps) = 0;
+
+    /**
+     * @brief Writes the variable to a buffer
+     *
+     * @return size_t Length of the text written, 0 if the buffer was too small.
+     */
+    virtual size_t format(char *buffer, size_t size) = 0;
+
+    /**
+     * @brief The variable as a double, for code which is not in the redraw path
+     *
+     */
+    virtual double toDouble() = 0;
+};
+
+/**
+ * @brief How a binding adds, clamps, writes and converts a type of variable, specialized for each supported type.
+ *
+ */
+template <typename T>
+struct DisplayValueType;
+
+template <>
+struct DisplayValueType<int32_t>
+{
+    static int32_t add(int32_t value, int32_t step, int16_t steps, int32_t min, int32_t max)
+    {
+        //64 bit integers can not overflow here and are not floating point
+        int64_t result = (int64_t)value + ((int64_t)step * steps);
+        return result < min ? min : (result > max ? max : (int32_t)result);
+    }
+    static size_t format(char *buffer, size_t size, int32_t value, uint8_t decimals, bool trimZeros)
+    {
+        return DisplayNumberFormat::formatFixed(buffer, size, value, decimals, trimZeros);
+    }
+    static double toDouble(int32_t value, uint8_t decimals)
+    {
+        double result = value;
+        while (decimals-- > 0)
+            result /= 10;
+        return result;
+    }
+};
+
+template <>
+struct DisplayValueType<float>
+{
+    static float add(float value, float step, int16_t steps, float min, float max)
+    {
+        float result = value + (step * steps);
+        return result < min ? min : (result > max ? max : result);
+    }
+    static size_t format(char *buffer, size_t size, float value, uint8_t decimals, bool trimZeros)
+    {
+        return DisplayNumberFormat::formatFloat(buffer, size, value, decimals, trimZeros);
+    }
+    static double toDouble(float value, uint8_t decimals) { return value; }
+};
+
+/**
+ * @brief Binds a variable of type T to buttons and labels, with a range, a step and a number of decimals
+ * known when the sketch is compiled.
+ *
+ * An int32_t with DECIMALS above 0 is a fixed point number, the variable counts parts of one,
+ * so 2297 with 2 decimals is written "22.97". Stepping and writing int32_t variables uses only integer math,
+ * float variables use single precision math, which the ESP32 does in hardware.
+ * The minimum, maximum and step are in the same units as the variable.
+ *
+ * @code .cpp
+ * int32_t count = 0;
+ * int32_t tenths = 225;   //22.5 degrees
+ * float flow = 1.5f;
+ *
+ * DisplayBinding<int32_t> countBinding(&count, 0, 100, 1);
+ * DisplayBinding<int32_t, 1> temperatureBinding(&tenths, 50, 300, 5);  //5.0 to 30.0 by 0.5
+ * DisplayBinding<float, 2> flowBinding(&flow, 0.0f, 10.0f, 0.25f);
+ *
+ * pPage->addIncrementButton(10, 10, 40, 40, TFT_WHITE, TFT_BLUE, TFT_WHITE, 1, "+", &temperatureBinding, 1);
+ * pPage->addIncrementButton(60, 10, 40, 40, TFT_WHITE, TFT_BLUE, TFT_WHITE, 1, "-", &temperatureBinding, -1);
+ * pPage->addPageLabel(110, 10, 80, 40, TFT_BLACK, TFT_BLACK, TFT_WHITE, 1, "")->setBinding(&temperatureBinding);
+ * @endcode
+ */
+template <typename T, uint8_t DECIMALS = 0>
+class DisplayBinding : public DisplayValue
+{
+private:
+    T *_pValue;
+    T _min;
+    T _max;
+    T _step;
+    bool _trimZeros;
+
+public:
+    /**
+     * @brief Construct a new Display Binding object
+     *
+     * @param pValue The variable, it must exist for as long as the binding does
+     * @param min Smallest value the variable is stepped to
+     * @param max Largest value the variable is stepped to
+     * @param step How much one step changes the variable
+     * @param trimZeros Should ending zeros in the decimals be removed when the variable is written
+     */
+    DisplayBinding(T *pValue, T min, T max, T step, bool trimZeros = false)
+        : _pValue(pValue), _min(min), _max(max), _step(step), _trimZeros(trimZeros) {}
+
+    T get() { return *_pValue; };
+
+    /**
+     * @brief Sets the variable, kept between the minimum and the maximum
+     *
+     */
+    void set(T value) { *_pValue = value < _min ? _min : (value > _max ? _max : value); };
+    T *getValue() { return _pValue; };
+    T getMin() { return _min; };
+    T getMax() { return _max; };
+    T getStep() { return _step; };
+    void setRange(T min, T max) { _min = min; _max = max; set(*_pValue); };
+    void setStep(T step) { _step = step; };
+
+    bool step(int16_t steps)
+    {
+        T before = *_pValue;
+        *_pValue = DisplayValueType<T>::add(before, _step, steps, _min, _max);
+        return *_pValue != before;
+    }
+
+    size_t format(char *buffer, size_t size)
+    {
+        return DisplayValueType<T>::format(buffer, size, *_pValue, DECIMALS, _trimZeros);
+    }
+
+    double toDouble()
+    {
+        return DisplayValueType<T>::toDouble(*_pValue, DECIMALS);
+    }
+};
+
+#endif
@@ -0,0 +1,28 @@
+#include "DisplayWidget.h"
+#include "DisplayMenu.h"
+
+DisplayWidget::DisplayWidget(TFT_eSPI *tft, DisplayPage *pPage, int16_t x, int16_t y, uint16_t width, uint16_t height)
+{
+    _tft = tft;
+    _pPage = pPage;
+    _rect = DisplayRect(x, y, width, height);
+    _state = VISABLE;
+    _occluded = false;
+    _pFont = NULL;
+}
+
+bool DisplayWidget::isPageVisable()
+{
+    if (_state == HIDDEN)
+        return false;
+
+    DisplayMenu *pMenu = _pPage ? _pPage->getMenu() : NULL;
+    return !pMenu || (_pPage == pMenu->getVisablePage() && !pMenu->isAsleep());
+}
+
+void DisplayWidget::selectFont()
+{
+    DisplayMenu *pMenu = _pPage ? _pPage->getMenu() : NULL;
+    if (pMenu)
+        pMenu->selectFont(_tft, _pFont);
+}
@@ -0,0 +1,105 @@
+#ifndef DISPLAYWIDGET_H
+#define DISPLAYWIDGET_H
+
+#include <Arduino.h>
+
+#include <TFT_eSPI.h>
+
+#include "DisplayGlobals.h"
+#include "DisplayRect.h"
+#include "DisplayFont.h"
+#include "DisplayMemory.h"
+
+class DisplayPage;
+
+/**
+ * @brief Base class for items on a page which draw themselves, like the numeric entry field.
+ * 
+ * Widgets are owned by the page they are added to and are drawn after the page labels and buttons.
+ * 
+ */
+class DisplayWidget
+{
+protected:
+    TFT_eSPI *_tft;
+    DisplayPage *_pPage;
+    DisplayRect _rect;
+    DisplayState _state;
+    bool _occluded;
+    DisplayFont *_pFont;
+
+    /**
+     * @brief Checks if the page this widget belongs to is the one shown on the screen
+     * 
+     * @return true if the widget can be drawn
+     */
+    bool isPageVisable();
+
+    /**
+     * @brief Selects the widget's font, or the menu font, on the widget's display
+     * 
+     */
+    void selectFont();
+
+public:
+    DISPLAY_MEMORY_TRACKED
+    DisplayWidget(TFT_eSPI *tft, DisplayPage *pPage, int16_t x, int16_t y, uint16_t width, uint16_t height);
+    virtual ~DisplayWidget() {}
+
+    /**
+     * @brief Draws the whole widget on to the screen
+     * 
+     */
+    virtual void draw() = 0;
+
+    /**
+     * @brief Does the widget paint every pixel of it's rect when drawn.
+     * Opaque widgets hide the items below them and the page background is not cleared under them.
+     */
+    virtual bool isOpaque() { return true; }
+
+    /**
+     * @brief Heap memory used by the widget, including the widget object itself.
+     * 
+     */
+    virtual size_t getMemorySize() { return sizeof(DisplayWidget); }
+
+    /**
+     * @brief Name of the widget's class, used in memory reports
+     * 
+     */
+    virtual const char *getTypeName() { return "DisplayWidget"; }
+
+    /**
+     * @brief Called by the menu with every touch screen reading while the widget's page is visable,
+     * and once with pressed false when the screen is released.
+     * 
+     * @return true if the widget used the touch, buttons are then not pressed by it.
+     */
+    virtual bool touch(uint16_t x, uint16_t y, bool pressed) { return false; }
+
+    /**
+     * @brief Called when another page is about to be shown instead of the widget's page
+     * 
+     */
+    virtual void pageHidden() {}
+
+    DisplayRect getRect() { return _rect; }
+    DisplayPage *getPage() { return _pPage; }
+    TFT_eSPI *getDisplay() { return _tft; }
+    void setState(DisplayState state) { _state = state; };
+    DisplayState getState() { return _state; };
+    void show() { _state = DisplayState::VISABLE; };
+    void hide() { _state = DisplayState::HIDDEN; };
+    bool isOccluded() { return _occluded; }
+
+    /**
+     * @brief Set the font the widget writes with, NULL uses the menu font
+     * 
+     */
+    void setFont(DisplayFont *pFont) { _pFont = pFont; };
+    DisplayFont *getFont() { return _pFont; };
+    void setOccluded(bool occluded) { _occluded = occluded; }
+};
+
+#endif
@@ -0,0 +1,15 @@
+#include "DisplayWidgetList.h"
+
+bool DisplayWidgetList::remove(DisplayWidget *pWidget) {
+    int index = indexOf(pWidget);
+    if (index < 0)
+        return false;
+
+    delete LinkedList<DisplayWidget*>::remove(index);
+    return true;
+}
+
+void DisplayWidgetList::destory() {
+    while (size() > 0)
+        delete shift();
+}
@@ -0,0 +1,49 @@
+#ifndef DISPLAYWIDGETLIST_H
+#define DISPLAYWIDGETLIST_H
+
+
+#include "LinkedList.h"
+#include "DisplayWidget.h"
+
+/**
+ * @brief A list of widgets. The list owns the widgets added to it and deletes them when it is destroyed.
+ * 
+ */
+class DisplayWidgetList : public LinkedList<DisplayWidget*> {
+
+private:
+    
+    /**
+     * @brief The cleanup function used by the list's deconstructor;
+     * 
+     */
+    void destory();
+
+public:
+    
+    /**
+     * @brief The count of items in the list
+     * 
+     * @return int 
+     */
+    int count() { return size(); };
+
+    /**
+     * @brief Deletes all widgets in the list and empties it
+     * 
+     */
+    void removeAll() { destory(); };
+
+    /**
+     * @brief Removes one widget from the list and deletes it
+     * 
+     * @return true if the widget was in the list
+     */
+    bool remove(DisplayWidget *pWidget);
+
+    
+    ~DisplayWidgetList() { destory(); }
+    
+};
+
+#endif
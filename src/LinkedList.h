@@ -54,7 +54,8 @@ protected:
 
 public:
     LinkedList();
-    ~LinkedList();
+    //virtual, lists are deleted through pointers to the classes deriving from them
+    virtual ~LinkedList();
 
     /*
     Returns current size of LinkedList
@@ -0,0 +1,85 @@
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+/*
+    The few checks the host tests need, a failed check is printed and the test returns 1 from main.
+*/
+
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+
+#include <vector>
+
+static int hostTestFailures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            hostTestFailures++; \
+        } \
+    } while (0)
+
+#define CHECK_EQUAL(expected, actual) \
+    do { \
+        double hostExpected = (double)(expected), hostActual = (double)(actual); \
+        if (hostExpected != hostActual) { \
+            printf("%s:%d: CHECK_EQUAL(%s, %s) failed, %g != %g\n", __FILE__, __LINE__, #expected, #actual, hostExpected, hostActual); \
+            hostTestFailures++; \
+        } \
+    } while (0)
+
+#define CHECK_TEXT(expected, actual) \
+    do { \
+        String hostExpected(expected), hostActual(actual); \
+        if (hostExpected != hostActual) { \
+            printf("%s:%d: CHECK_TEXT(%s, %s) failed, \"%s\" != \"%s\"\n", __FILE__, __LINE__, #expected, #actual, hostExpected.c_str(), hostActual.c_str()); \
+            hostTestFailures++; \
+        } \
+    } while (0)
+
+/**
+ * @brief Prints the result, returned from main
+ *
+ */
+static inline int testResult(const char *name)
+{
+    printf("%s: %s, %d failed checks\n", name, hostTestFailures ? "FAILED" : "passed", hostTestFailures);
+    return hostTestFailures ? 1 : 0;
+}
+
+/**
+ * @brief A Print writing into memory
+ *
+ */
+class HostBuffer : public Stream
+{
+private:
+    size_t _readPosition;
+
+public:
+    std::vector<uint8_t> bytes;
+
+    HostBuffer() : _readPosition(0) {}
+    size_t write(uint8_t value) { bytes.push_back(value); return 1; }
+    using Print::write;
+    int available() { return bytes.size() - _readPosition; }
+    int read() { return available() > 0 ? bytes[_readPosition++] : -1; }
+    int peek() { return available() > 0 ? bytes[_readPosition] : -1; }
+    String text() { return String(std::string(bytes.begin(), bytes.end())); }
+};
+
+/**
+ * @brief Number of pixels which differ between two displays of the same size
+ *
+ */
+static inline int countDifferentPixels(TFT_eSPI &a, TFT_eSPI &b)
+{
+    int count = 0;
+    for (int32_t y = 0; y < a.height(); y++)
+        for (int32_t x = 0; x < a.width(); x++)
+            count += a.readPixel(x, y) != b.readPixel(x, y);
+    return count;
+}
+
+#endif
@@ -0,0 +1,71 @@
+#!/usr/bin/env python3
+"""
+Compares the text placement of the menu compiler with the library.
+
+Every description is compiled with the menu compiler, the menu file is loaded by test_layout, which prints where the
+library drew every text, and each text must be where the compiler preview puts it.
+
+    check_layout.py path/to/test_layout --font stubs/HostFont.h layout.json ...
+"""
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+import tempfile
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "..", "tools", "menucompiler"))
+import menucompiler  # noqa: E402
+
+
+def expected_texts(menu, font):
+    lines = []
+    for index, page in enumerate(menu.pages):
+        for item in menu.drawn_items(page):
+            text, x, baseline = menu.text_placement(font, item)
+            lines.append("%d\t%d\t%d\t%s" % (index, x, baseline, text))
+    return lines
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("program", help="the test_layout program")
+    parser.add_argument("--font", required=True, help="the GFX font the program uses")
+    parser.add_argument("descriptions", nargs="+")
+    args = parser.parse_args()
+
+    font = menucompiler.Font(args.font)
+    failures = 0
+    for path in args.descriptions:
+        with open(path) as f:
+            menu = menucompiler.Menu(json.load(f))
+        data = menu.pack()
+        with tempfile.NamedTemporaryFile(suffix=".bin", delete=False) as f:
+            f.write(data)
+            binary = f.name
+        try:
+            result = subprocess.run([args.program, binary], stdout=subprocess.PIPE, universal_newlines=True)
+        finally:
+            os.remove(binary)
+        if result.returncode != 0:
+            print("%s: %s failed\n%s" % (path, args.program, result.stdout))
+            failures += 1
+            continue
+
+        actual = result.stdout.splitlines()
+        expected = expected_texts(menu, font)
+        for line in range(max(len(actual), len(expected))):
+            a = actual[line] if line < len(actual) else "<missing>"
+            e = expected[line] if line < len(expected) else "<missing>"
+            if a != e:
+                print("%s: the library drew '%s', the compiler expects '%s'" % (path, a.replace("\t", " "), e.replace("\t", " ")))
+                failures += 1
+        print("%s: %d texts compared" % (path, len(expected)))
+
+    print("layout: %s, %d differences" % ("FAILED" if failures else "passed", failures))
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
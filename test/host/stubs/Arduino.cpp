@@ -0,0 +1,147 @@
+#include <Arduino.h>
+
+static unsigned long long hostMicros = 0;
+
+HardwareSerial Serial;
+
+unsigned long millis() { return (unsigned long)(hostMicros / 1000); }
+unsigned long micros() { return (unsigned long)hostMicros; }
+void delay(unsigned long ms) { hostMicros += (unsigned long long)ms * 1000; }
+void delayMicroseconds(unsigned int us) { hostMicros += us; }
+void yield() {}
+void hostAdvanceMicros(unsigned long us) { hostMicros += us; }
+
+void pinMode(uint8_t, uint8_t) {}
+void digitalWrite(uint8_t, uint8_t) {}
+int digitalRead(uint8_t) { return HIGH; }
+void analogWrite(uint8_t, int) {}
+int digitalPinToInterrupt(int pin) { return pin; }
+void attachInterruptArg(uint8_t, void (*)(void *), void *, int) {}
+void detachInterrupt(uint8_t) {}
+
+static std::string toBase(unsigned long long value, unsigned char base, bool negative)
+{
+    std::string s;
+    do
+    {
+        int digit = value % base;
+        s.insert(s.begin(), (char)(digit < 10 ? '0' + digit : 'A' + digit - 10));
+        value /= base;
+    } while (value);
+    if (negative)
+        s.insert(s.begin(), '-');
+    return s;
+}
+
+String::String(int value, unsigned char base) : _s(toBase(value < 0 && base == 10 ? -(long long)value : (unsigned int)value, base, value < 0 && base == 10)) {}
+String::String(unsigned int value, unsigned char base) : _s(toBase(value, base, false)) {}
+String::String(long value, unsigned char base) : _s(toBase(value < 0 && base == 10 ? -(long long)value : (unsigned long)value, base, value < 0 && base == 10)) {}
+String::String(unsigned long value, unsigned char base) : _s(toBase(value, base, false)) {}
+
+String::String(double value, unsigned int decimals)
+{
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%.*f", (int)decimals, value);
+    _s = buffer;
+}
+
+int String::indexOf(char c, unsigned int from) const
+{
+    size_t index = _s.find(c, from);
+    return index == std::string::npos ? -1 : (int)index;
+}
+
+int String::indexOf(const String &s, unsigned int from) const
+{
+    size_t index = _s.find(s._s, from);
+    return index == std::string::npos ? -1 : (int)index;
+}
+
+bool String::endsWith(const String &s) const
+{
+    return _s.length() >= s._s.length() && _s.compare(_s.length() - s._s.length(), s._s.length(), s._s) == 0;
+}
+
+String String::substring(unsigned int from, unsigned int to) const
+{
+    if (from > to)
+        std::swap(from, to);
+    if (from >= _s.length())
+        return String();
+    return String(_s.substr(from, to - from));
+}
+
+void String::getBytes(unsigned char *buffer, unsigned int size, unsigned int index) const
+{
+    if (!size || !buffer)
+        return;
+    size_t count = 0;
+    if (index < _s.length())
+        count = min((size_t)size - 1, _s.length() - index);
+    memcpy(buffer, _s.c_str() + index, count);
+    buffer[count] = 0;
+}
+
+String operator+(const String &a, const String &b) { String s(a); s += b; return s; }
+String operator+(const String &a, const char *b) { String s(a); s += b; return s; }
+String operator+(const char *a, const String &b) { String s(a); s += b; return s; }
+String operator+(const String &a, char b) { String s(a); s += b; return s; }
+
+size_t Print::write(const uint8_t *buffer, size_t size)
+{
+    size_t n = 0;
+    while (size--)
+        n += write(*buffer++);
+    return n;
+}
+
+size_t Print::printf(const char *format, ...)
+{
+    char buffer[512];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    if (length < 0)
+        return 0;
+    return write((const uint8_t *)buffer, min((size_t)length, sizeof(buffer) - 1));
+}
+
+long Stream::parseInt()
+{
+    int c = peek();
+    while (c >= 0 && c != '-' && (c < '0' || c > '9'))
+    {
+        read();
+        c = peek();
+    }
+
+    bool negative = false;
+    long value = 0;
+    if (c == '-')
+    {
+        negative = true;
+        read();
+        c = peek();
+    }
+    while (c >= '0' && c <= '9')
+    {
+        value = (value * 10) + (c - '0');
+        read();
+        c = peek();
+    }
+    return negative ? -value : value;
+}
+
+size_t Stream::readBytes(char *buffer, size_t size)
+{
+    size_t count = 0;
+    while (count < size)
+    {
+        int c = read();
+        if (c < 0)
+            break;
+        buffer[count++] = (char)c;
+    }
+    return count;
+}
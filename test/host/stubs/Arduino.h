@@ -0,0 +1,166 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+/*
+    The parts of the Arduino core used by the library, for building it on the PC.
+    Time does not pass by itself, delay and hostAdvanceMicros move the clock so tests can replay touches exactly.
+*/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <math.h>
+#include <algorithm>
+#include <string>
+
+using std::min;
+using std::max;
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define PROGMEM
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define RISING 1
+#define FALLING 2
+#define CHANGE 3
+
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+#define pgm_read_ptr(addr) (*(void * const *)(addr))
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+/**
+ * @brief Moves the clock used by millis and micros forward
+ *
+ */
+void hostAdvanceMicros(unsigned long us);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+void analogWrite(uint8_t pin, int value);
+int digitalPinToInterrupt(int pin);
+void attachInterruptArg(uint8_t pin, void (*handler)(void *), void *arg, int mode);
+void detachInterrupt(uint8_t pin);
+
+class String
+{
+private:
+    std::string _s;
+
+public:
+    String(const char *s = "") : _s(s ? s : "") {}
+    String(const std::string &s) : _s(s) {}
+    String(char c) : _s(1, c) {}
+    String(int value, unsigned char base = 10);
+    String(unsigned int value, unsigned char base = 10);
+    String(long value, unsigned char base = 10);
+    String(unsigned long value, unsigned char base = 10);
+    String(double value, unsigned int decimals = 2);
+
+    unsigned int length() const { return _s.length(); }
+    const char *c_str() const { return _s.c_str(); }
+    bool isEmpty() const { return _s.empty(); }
+    bool equals(const String &s) const { return _s == s._s; }
+    bool equals(const char *s) const { return _s == s; }
+    char charAt(unsigned int index) const { return index < _s.length() ? _s[index] : 0; }
+    char operator[](unsigned int index) const { return charAt(index); }
+    int indexOf(char c, unsigned int from = 0) const;
+    int indexOf(const String &s, unsigned int from = 0) const;
+    void remove(unsigned int index) { if (index < _s.length()) _s.erase(index); }
+    void remove(unsigned int index, unsigned int count) { if (index < _s.length()) _s.erase(index, count); }
+    bool startsWith(const String &s) const { return _s.compare(0, s._s.length(), s._s) == 0; }
+    bool endsWith(const String &s) const;
+    String substring(unsigned int from) const { return from < _s.length() ? String(_s.substr(from)) : String(); }
+    String substring(unsigned int from, unsigned int to) const;
+    void getBytes(unsigned char *buffer, unsigned int size, unsigned int index = 0) const;
+    long toInt() const { return atol(_s.c_str()); }
+    double toDouble() const { return atof(_s.c_str()); }
+    bool reserve(unsigned int size) { _s.reserve(size); return true; }
+
+    String &operator+=(const String &s) { _s += s._s; return *this; }
+    String &operator+=(const char *s) { _s += s; return *this; }
+    String &operator+=(char c) { _s += c; return *this; }
+    bool operator==(const String &s) const { return _s == s._s; }
+    bool operator==(const char *s) const { return _s == s; }
+    bool operator!=(const String &s) const { return _s != s._s; }
+    bool operator!=(const char *s) const { return _s != s; }
+};
+
+String operator+(const String &a, const String &b);
+String operator+(const String &a, const char *b);
+String operator+(const char *a, const String &b);
+String operator+(const String &a, char b);
+
+class Print
+{
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t value) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size);
+    size_t write(const char *text) { return text ? write((const uint8_t *)text, strlen(text)) : 0; }
+
+    size_t print(const char *text) { return write(text); }
+    size_t print(const String &text) { return write(text.c_str()); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int value, int base = 10) { return print(String(value, base)); }
+    size_t print(unsigned int value, int base = 10) { return print(String(value, base)); }
+    size_t print(long value, int base = 10) { return print(String(value, base)); }
+    size_t print(unsigned long value, int base = 10) { return print(String(value, base)); }
+    size_t print(double value, int decimals = 2) { return print(String(value, decimals)); }
+
+    size_t println() { return write("\r\n"); }
+    template <typename T>
+    size_t println(T value) { size_t n = print(value); return n + println(); }
+    template <typename T>
+    size_t println(T value, int format) { size_t n = print(value, format); return n + println(); }
+
+    size_t printf(const char *format, ...);
+};
+
+class Stream : public Print
+{
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    /**
+     * @brief Skips everything up to a number and reads it, 0 when the stream ends first.
+     *
+     */
+    long parseInt();
+    size_t readBytes(char *buffer, size_t size);
+    size_t readBytes(uint8_t *buffer, size_t size) { return readBytes((char *)buffer, size); }
+};
+
+class HardwareSerial : public Stream
+{
+public:
+    void begin(unsigned long) {}
+    size_t write(uint8_t value) { return fwrite(&value, 1, 1, stdout); }
+    size_t write(const uint8_t *buffer, size_t size) { return fwrite(buffer, 1, size, stdout); }
+    using Print::write;
+    int available() { return 0; }
+    int read() { return -1; }
+    int peek() { return -1; }
+};
+
+extern HardwareSerial Serial;
+
+#endif
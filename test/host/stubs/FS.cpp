@@ -0,0 +1,61 @@
+#include <FS.h>
+
+namespace fs {
+
+size_t File::write(const uint8_t *buffer, size_t size)
+{
+    if (!_data || !_writable)
+        return 0;
+    if (_position + size > _data->size())
+        _data->resize(_position + size);
+    memcpy(_data->data() + _position, buffer, size);
+    _position += size;
+    return size;
+}
+
+int File::read()
+{
+    if (available() <= 0)
+        return -1;
+    return (*_data)[_position++];
+}
+
+size_t File::read(uint8_t *buffer, size_t size)
+{
+    size_t count = min(size, (size_t)max(available(), 0));
+    if (count)
+        memcpy(buffer, _data->data() + _position, count);
+    _position += count;
+    return count;
+}
+
+bool File::seek(uint32_t position)
+{
+    if (!_data || position > _data->size())
+        return false;
+    _position = position;
+    return true;
+}
+
+File FS::open(const char *path, const char *mode, bool create)
+{
+    bool write = mode[0] == 'w' || mode[0] == 'a';
+    std::map<std::string, FileData>::iterator it = _files.find(path);
+    if (it == _files.end())
+    {
+        if (!write && !create)
+            return File();
+        it = _files.insert(std::make_pair(std::string(path), FileData(new std::vector<uint8_t>()))).first;
+    }
+
+    if (mode[0] == 'w')
+        it->second->clear();
+    return File(it->second, path, write, mode[0] == 'a' ? it->second->size() : 0);
+}
+
+void FS::add(const char *path, const uint8_t *pData, size_t size)
+{
+    _files[path] = FileData(new std::vector<uint8_t>(pData, pData + size));
+}
+
+}
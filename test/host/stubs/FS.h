@@ -0,0 +1,74 @@
+#ifndef HOST_FS_H
+#define HOST_FS_H
+
+/*
+    A file system kept in memory, the files are shared by every File opened on them.
+*/
+
+#include <Arduino.h>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+namespace fs {
+
+typedef std::shared_ptr<std::vector<uint8_t>> FileData;
+
+class File : public Stream
+{
+private:
+    FileData _data;
+    String _name;
+    size_t _position;
+    bool _writable;
+
+public:
+    File() : _position(0), _writable(false) {}
+    File(FileData data, const char *name, bool writable, size_t position)
+        : _data(data), _name(name), _position(position), _writable(writable) {}
+
+    size_t write(uint8_t value) { return write(&value, 1); }
+    size_t write(const uint8_t *buffer, size_t size);
+    using Print::write;
+    int available() { return _data ? (int)(_data->size() - _position) : 0; }
+    int read();
+    int peek() { return available() > 0 ? (*_data)[_position] : -1; }
+    size_t read(uint8_t *buffer, size_t size);
+    bool seek(uint32_t position);
+    size_t position() const { return _position; }
+    size_t size() const { return _data ? _data->size() : 0; }
+    const char *name() const { return _name.c_str(); }
+    void close() { _data.reset(); }
+    operator bool() const { return (bool)_data; }
+};
+
+class FS
+{
+private:
+    std::map<std::string, FileData> _files;
+
+public:
+    File open(const char *path, const char *mode = FILE_READ, bool create = false);
+    File open(const String &path, const char *mode = FILE_READ, bool create = false) { return open(path.c_str(), mode, create); }
+    bool exists(const char *path) { return _files.count(path) > 0; }
+    bool exists(const String &path) { return exists(path.c_str()); }
+    bool remove(const char *path) { return _files.erase(path) > 0; }
+
+    /**
+     * @brief Puts a file in the file system, for tests
+     *
+     */
+    void add(const char *path, const uint8_t *pData, size_t size);
+};
+
+}
+
+using fs::FS;
+using fs::File;
+
+#endif
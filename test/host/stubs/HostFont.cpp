@@ -0,0 +1,2 @@
+#include <TFT_eSPI.h>
+#include "HostFont.h"
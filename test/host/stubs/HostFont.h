@@ -0,0 +1,254 @@
+#ifndef HOST_FONT_H
+#define HOST_FONT_H
+
+/*
+    Stands in for FreeMonoBold9pt7b in the tests, with the same advance and heights.
+    Every glyph is a box with the bits of it's character inside, so different texts draw different pixels.
+    The menu compiler reads it with --font, the tests and the preview then measure texts with the same glyphs.
+*/
+
+const uint8_t FreeMonoBold9pt7bBitmaps[] PROGMEM = {
+    0xFF, 0xC0, 0x60, 0x30, 0x1A, 0x1C, 0x06, 0x87, 0x01, 0xA1, 0xC0, 0x68,
+    0x70, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1A, 0x2C,
+    0x06, 0x8B, 0x01, 0xA2, 0xC0, 0x68, 0xB0, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1A, 0x3C, 0x06, 0x8F, 0x01, 0xA3, 0xC0, 0x68,
+    0xF0, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1A, 0x4C,
+    0x06, 0x93, 0x01, 0xA4, 0xC0, 0x69, 0x30, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1A, 0x5C, 0x06, 0x97, 0x01, 0xA5, 0xC0, 0x69,
+    0x70, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1A, 0x6C,
+    0x06, 0x9B, 0x01, 0xA6, 0xC0, 0x69, 0xB0, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1A, 0x7C, 0x06, 0x9F, 0x01, 0xA7, 0xC0, 0x69,
+    0xF0, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1A, 0x8C,
+    0x06, 0xA3, 0x01, 0xA8, 0xC0, 0x6A, 0x30, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1A, 0x9C, 0x06, 0xA7, 0x01, 0xA9, 0xC0, 0x6A,
+    0x70, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1A, 0xAC,
+    0x06, 0xAB, 0x01, 0xAA, 0xC0, 0x6A, 0xB0, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1A, 0xBC, 0x06, 0xAF, 0x01, 0xAB, 0xC0, 0x6A,
+    0xF0, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1A, 0xCC,
+    0x06, 0xB3, 0x01, 0xAC, 0xC0, 0x6B, 0x30, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1A, 0xDC, 0x06, 0xB7, 0x01, 0xAD, 0xC0, 0x6B,
+    0x70, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1A, 0xEC,
+    0x06, 0xBB, 0x01, 0xAE, 0xC0, 0x6B, 0xB0, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1A, 0xFC, 0x06, 0xBF, 0x01, 0xAF, 0xC0, 0x6B,
+    0xF0, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1B, 0x0C,
+    0x06, 0xC3, 0x01, 0xB0, 0xC0, 0x6C, 0x30, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1B, 0x1C, 0x06, 0xC7, 0x01, 0xB1, 0xC0, 0x6C,
+    0x70, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1B, 0x2C,
+    0x06, 0xCB, 0x01, 0xB2, 0xC0, 0x6C, 0xB0, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1B, 0x3C, 0x06, 0xCF, 0x01, 0xB3, 0xC0, 0x6C,
+    0xF0, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1B, 0x4C,
+    0x06, 0xD3, 0x01, 0xB4, 0xC0, 0x6D, 0x30, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1B, 0x5C, 0x06, 0xD7, 0x01, 0xB5, 0xC0, 0x6D,
+    0x70, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1B, 0x6C,
+    0x06, 0xDB, 0x01, 0xB6, 0xC0, 0x6D, 0xB0, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1B, 0x7C, 0x06, 0xDF, 0x01, 0xB7, 0xC0, 0x6D,
+    0xF0, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1B, 0x8C,
+    0x06, 0xE3, 0x01, 0xB8, 0xC0, 0x6E, 0x30, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1B, 0x9C, 0x06, 0xE7, 0x01, 0xB9, 0xC0, 0x6E,
+    0x70, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1B, 0xAC,
+    0x06, 0xEB, 0x01, 0xBA, 0xC0, 0x6E, 0xB0, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1B, 0xBC, 0x06, 0xEF, 0x01, 0xBB, 0xC0, 0x6E,
+    0xF0, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1B, 0xCC,
+    0x06, 0xF3, 0x01, 0xBC, 0xC0, 0x6F, 0x30, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1B, 0xDC, 0x06, 0xF7, 0x01, 0xBD, 0xC0, 0x6F,
+    0x70, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1B, 0xEC,
+    0x06, 0xFB, 0x01, 0xBE, 0xC0, 0x6F, 0xB0, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1B, 0xFC, 0x06, 0xFF, 0x01, 0xBF, 0xC0, 0x6F,
+    0xF0, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1C, 0x0C,
+    0x07, 0x03, 0x01, 0xC0, 0xC0, 0x70, 0x30, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1C, 0x1C, 0x07, 0x07, 0x01, 0xC1, 0xC0, 0x70,
+    0x70, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1C, 0x2C,
+    0x07, 0x0B, 0x01, 0xC2, 0xC0, 0x70, 0xB0, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1C, 0x3C, 0x07, 0x0F, 0x01, 0xC3, 0xC0, 0x70,
+    0xF0, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1C, 0x4C,
+    0x07, 0x13, 0x01, 0xC4, 0xC0, 0x71, 0x30, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1C, 0x5C, 0x07, 0x17, 0x01, 0xC5, 0xC0, 0x71,
+    0x70, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1C, 0x6C,
+    0x07, 0x1B, 0x01, 0xC6, 0xC0, 0x71, 0xB0, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1C, 0x7C, 0x07, 0x1F, 0x01, 0xC7, 0xC0, 0x71,
+    0xF0, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1C, 0x8C,
+    0x07, 0x23, 0x01, 0xC8, 0xC0, 0x72, 0x30, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1C, 0x9C, 0x07, 0x27, 0x01, 0xC9, 0xC0, 0x72,
+    0x70, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1C, 0xAC,
+    0x07, 0x2B, 0x01, 0xCA, 0xC0, 0x72, 0xB0, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1C, 0xBC, 0x07, 0x2F, 0x01, 0xCB, 0xC0, 0x72,
+    0xF0, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1C, 0xCC,
+    0x07, 0x33, 0x01, 0xCC, 0xC0, 0x73, 0x30, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1C, 0xDC, 0x07, 0x37, 0x01, 0xCD, 0xC0, 0x73,
+    0x70, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1C, 0xEC,
+    0x07, 0x3B, 0x01, 0xCE, 0xC0, 0x73, 0xB0, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1C, 0xFC, 0x07, 0x3F, 0x01, 0xCF, 0xC0, 0x73,
+    0xF0, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1D, 0x0C,
+    0x07, 0x43, 0x01, 0xD0, 0xC0, 0x74, 0x30, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1D, 0x1C, 0x07, 0x47, 0x01, 0xD1, 0xC0, 0x74,
+    0x70, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1D, 0x2C,
+    0x07, 0x4B, 0x01, 0xD2, 0xC0, 0x74, 0xB0, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1D, 0x3C, 0x07, 0x4F, 0x01, 0xD3, 0xC0, 0x74,
+    0xF0, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1D, 0x4C,
+    0x07, 0x53, 0x01, 0xD4, 0xC0, 0x75, 0x30, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1D, 0x5C, 0x07, 0x57, 0x01, 0xD5, 0xC0, 0x75,
+    0x70, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1D, 0x6C,
+    0x07, 0x5B, 0x01, 0xD6, 0xC0, 0x75, 0xB0, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1D, 0x7C, 0x07, 0x5F, 0x01, 0xD7, 0xC0, 0x75,
+    0xF0, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1D, 0x8C,
+    0x07, 0x63, 0x01, 0xD8, 0xC0, 0x76, 0x30, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1D, 0x9C, 0x07, 0x67, 0x01, 0xD9, 0xC0, 0x76,
+    0x70, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1D, 0xAC,
+    0x07, 0x6B, 0x01, 0xDA, 0xC0, 0x76, 0xB0, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1D, 0xBC, 0x07, 0x6F, 0x01, 0xDB, 0xC0, 0x76,
+    0xF0, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1D, 0xCC,
+    0x07, 0x73, 0x01, 0xDC, 0xC0, 0x77, 0x30, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1D, 0xDC, 0x07, 0x77, 0x01, 0xDD, 0xC0, 0x77,
+    0x70, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1D, 0xEC,
+    0x07, 0x7B, 0x01, 0xDE, 0xC0, 0x77, 0xB0, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1D, 0xFC, 0x07, 0x7F, 0x01, 0xDF, 0xC0, 0x77,
+    0xF0, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1E, 0x0C,
+    0x07, 0x83, 0x01, 0xE0, 0xC0, 0x78, 0x30, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1E, 0x1C, 0x07, 0x87, 0x01, 0xE1, 0xC0, 0x78,
+    0x70, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1E, 0x2C,
+    0x07, 0x8B, 0x01, 0xE2, 0xC0, 0x78, 0xB0, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1E, 0x3C, 0x07, 0x8F, 0x01, 0xE3, 0xC0, 0x78,
+    0xF0, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1E, 0x4C,
+    0x07, 0x93, 0x01, 0xE4, 0xC0, 0x79, 0x30, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1E, 0x5C, 0x07, 0x97, 0x01, 0xE5, 0xC0, 0x79,
+    0x70, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1E, 0x6C,
+    0x07, 0x9B, 0x01, 0xE6, 0xC0, 0x79, 0xB0, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1E, 0x7C, 0x07, 0x9F, 0x01, 0xE7, 0xC0, 0x79,
+    0xF0, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1E, 0x8C,
+    0x07, 0xA3, 0x01, 0xE8, 0xC0, 0x7A, 0x30, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1E, 0x9C, 0x07, 0xA7, 0x01, 0xE9, 0xC0, 0x7A,
+    0x70, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1E, 0xAC,
+    0x07, 0xAB, 0x01, 0xEA, 0xC0, 0x7A, 0xB0, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1E, 0xBC, 0x07, 0xAF, 0x01, 0xEB, 0xC0, 0x7A,
+    0xF0, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1E, 0xCC,
+    0x07, 0xB3, 0x01, 0xEC, 0xC0, 0x7B, 0x30, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1E, 0xDC, 0x07, 0xB7, 0x01, 0xED, 0xC0, 0x7B,
+    0x70, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1E, 0xEC,
+    0x07, 0xBB, 0x01, 0xEE, 0xC0, 0x7B, 0xB0, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1E, 0xFC, 0x07, 0xBF, 0x01, 0xEF, 0xC0, 0x7B,
+    0xF0, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1F, 0x0C,
+    0x07, 0xC3, 0x01, 0xF0, 0xC0, 0x7C, 0x30, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1F, 0x1C, 0x07, 0xC7, 0x01, 0xF1, 0xC0, 0x7C,
+    0x70, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1F, 0x2C,
+    0x07, 0xCB, 0x01, 0xF2, 0xC0, 0x7C, 0xB0, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1F, 0x3C, 0x07, 0xCF, 0x01, 0xF3, 0xC0, 0x7C,
+    0xF0, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1F, 0x4C,
+    0x07, 0xD3, 0x01, 0xF4, 0xC0, 0x7D, 0x30, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1F, 0x5C, 0x07, 0xD7, 0x01, 0xF5, 0xC0, 0x7D,
+    0x70, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1F, 0x6C,
+    0x07, 0xDB, 0x01, 0xF6, 0xC0, 0x7D, 0xB0, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1F, 0x7C, 0x07, 0xDF, 0x01, 0xF7, 0xC0, 0x7D,
+    0xF0, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1F, 0x8C,
+    0x07, 0xE3, 0x01, 0xF8, 0xC0, 0x7E, 0x30, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1F, 0x9C, 0x07, 0xE7, 0x01, 0xF9, 0xC0, 0x7E,
+    0x70, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1F, 0xAC,
+    0x07, 0xEB, 0x01, 0xFA, 0xC0, 0x7E, 0xB0, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1F, 0xBC, 0x07, 0xEF, 0x01, 0xFB, 0xC0, 0x7E,
+    0xF0, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1F, 0xCC,
+    0x07, 0xF3, 0x01, 0xFC, 0xC0, 0x7F, 0x30, 0x18, 0x0C, 0x06, 0x03, 0xFF,
+    0xFF, 0xC0, 0x60, 0x30, 0x1F, 0xDC, 0x07, 0xF7, 0x01, 0xFD, 0xC0, 0x7F,
+    0x70, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x1F, 0xEC,
+    0x07, 0xFB, 0x01, 0xFE, 0xC0, 0x7F, 0xB0, 0x18, 0x0C, 0x06, 0x03, 0xFF
+};
+
+const GFXglyph FreeMonoBold9pt7bGlyphs[] PROGMEM = {
+    {    0,  0,  0, 11,  0,   1}, // 0x20
+    {    0,  9, 16, 11,  1, -12}, // 0x21
+    {   18,  9, 16, 11,  1, -12}, // 0x22
+    {   36,  9, 16, 11,  1, -12}, // 0x23
+    {   54,  9, 16, 11,  1, -12}, // 0x24
+    {   72,  9, 16, 11,  1, -12}, // 0x25
+    {   90,  9, 16, 11,  1, -12}, // 0x26
+    {  108,  9, 16, 11,  1, -12}, // 0x27
+    {  126,  9, 16, 11,  1, -12}, // 0x28
+    {  144,  9, 16, 11,  1, -12}, // 0x29
+    {  162,  9, 16, 11,  1, -12}, // 0x2A
+    {  180,  9, 16, 11,  1, -12}, // 0x2B
+    {  198,  9, 16, 11,  1, -12}, // 0x2C
+    {  216,  9, 16, 11,  1, -12}, // 0x2D
+    {  234,  9, 16, 11,  1, -12}, // 0x2E
+    {  252,  9, 16, 11,  1, -12}, // 0x2F
+    {  270,  9, 16, 11,  1, -12}, // 0x30
+    {  288,  9, 16, 11,  1, -12}, // 0x31
+    {  306,  9, 16, 11,  1, -12}, // 0x32
+    {  324,  9, 16, 11,  1, -12}, // 0x33
+    {  342,  9, 16, 11,  1, -12}, // 0x34
+    {  360,  9, 16, 11,  1, -12}, // 0x35
+    {  378,  9, 16, 11,  1, -12}, // 0x36
+    {  396,  9, 16, 11,  1, -12}, // 0x37
+    {  414,  9, 16, 11,  1, -12}, // 0x38
+    {  432,  9, 16, 11,  1, -12}, // 0x39
+    {  450,  9, 16, 11,  1, -12}, // 0x3A
+    {  468,  9, 16, 11,  1, -12}, // 0x3B
+    {  486,  9, 16, 11,  1, -12}, // 0x3C
+    {  504,  9, 16, 11,  1, -12}, // 0x3D
+    {  522,  9, 16, 11,  1, -12}, // 0x3E
+    {  540,  9, 16, 11,  1, -12}, // 0x3F
+    {  558,  9, 16, 11,  1, -12}, // 0x40
+    {  576,  9, 16, 11,  1, -12}, // 0x41
+    {  594,  9, 16, 11,  1, -12}, // 0x42
+    {  612,  9, 16, 11,  1, -12}, // 0x43
+    {  630,  9, 16, 11,  1, -12}, // 0x44
+    {  648,  9, 16, 11,  1, -12}, // 0x45
+    {  666,  9, 16, 11,  1, -12}, // 0x46
+    {  684,  9, 16, 11,  1, -12}, // 0x47
+    {  702,  9, 16, 11,  1, -12}, // 0x48
+    {  720,  9, 16, 11,  1, -12}, // 0x49
+    {  738,  9, 16, 11,  1, -12}, // 0x4A
+    {  756,  9, 16, 11,  1, -12}, // 0x4B
+    {  774,  9, 16, 11,  1, -12}, // 0x4C
+    {  792,  9, 16, 11,  1, -12}, // 0x4D
+    {  810,  9, 16, 11,  1, -12}, // 0x4E
+    {  828,  9, 16, 11,  1, -12}, // 0x4F
+    {  846,  9, 16, 11,  1, -12}, // 0x50
+    {  864,  9, 16, 11,  1, -12}, // 0x51
+    {  882,  9, 16, 11,  1, -12}, // 0x52
+    {  900,  9, 16, 11,  1, -12}, // 0x53
+    {  918,  9, 16, 11,  1, -12}, // 0x54
+    {  936,  9, 16, 11,  1, -12}, // 0x55
+    {  954,  9, 16, 11,  1, -12}, // 0x56
+    {  972,  9, 16, 11,  1, -12}, // 0x57
+    {  990,  9, 16, 11,  1, -12}, // 0x58
+    { 1008,  9, 16, 11,  1, -12}, // 0x59
+    { 1026,  9, 16, 11,  1, -12}, // 0x5A
+    { 1044,  9, 16, 11,  1, -12}, // 0x5B
+    { 1062,  9, 16, 11,  1, -12}, // 0x5C
+    { 1080,  9, 16, 11,  1, -12}, // 0x5D
+    { 1098,  9, 16, 11,  1, -12}, // 0x5E
+    { 1116,  9, 16, 11,  1, -12}, // 0x5F
+    { 1134,  9, 16, 11,  1, -12}, // 0x60
+    { 1152,  9, 16, 11,  1, -12}, // 0x61
+    { 1170,  9, 16, 11,  1, -12}, // 0x62
+    { 1188,  9, 16, 11,  1, -12}, // 0x63
+    { 1206,  9, 16, 11,  1, -12}, // 0x64
+    { 1224,  9, 16, 11,  1, -12}, // 0x65
+    { 1242,  9, 16, 11,  1, -12}, // 0x66
+    { 1260,  9, 16, 11,  1, -12}, // 0x67
+    { 1278,  9, 16, 11,  1, -12}, // 0x68
+    { 1296,  9, 16, 11,  1, -12}, // 0x69
+    { 1314,  9, 16, 11,  1, -12}, // 0x6A
+    { 1332,  9, 16, 11,  1, -12}, // 0x6B
+    { 1350,  9, 16, 11,  1, -12}, // 0x6C
+    { 1368,  9, 16, 11,  1, -12}, // 0x6D
+    { 1386,  9, 16, 11,  1, -12}, // 0x6E
+    { 1404,  9, 16, 11,  1, -12}, // 0x6F
+    { 1422,  9, 16, 11,  1, -12}, // 0x70
+    { 1440,  9, 16, 11,  1, -12}, // 0x71
+    { 1458,  9, 16, 11,  1, -12}, // 0x72
+    { 1476,  9, 16, 11,  1, -12}, // 0x73
+    { 1494,  9, 16, 11,  1, -12}, // 0x74
+    { 1512,  9, 16, 11,  1, -12}, // 0x75
+    { 1530,  9, 16, 11,  1, -12}, // 0x76
+    { 1548,  9, 16, 11,  1, -12}, // 0x77
+    { 1566,  9, 16, 11,  1, -12}, // 0x78
+    { 1584,  9, 16, 11,  1, -12}, // 0x79
+    { 1602,  9, 16, 11,  1, -12}, // 0x7A
+    { 1620,  9, 16, 11,  1, -12}, // 0x7B
+    { 1638,  9, 16, 11,  1, -12}, // 0x7C
+    { 1656,  9, 16, 11,  1, -12}, // 0x7D
+    { 1674,  9, 16, 11,  1, -12}  // 0x7E
+};
+
+const GFXfont FreeMonoBold9pt7b PROGMEM = {(uint8_t *)FreeMonoBold9pt7bBitmaps, (GFXglyph *)FreeMonoBold9pt7bGlyphs, 0x20, 0x7E, 18};
+
+#endif
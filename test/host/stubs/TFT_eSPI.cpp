@@ -0,0 +1,471 @@
+#include <TFT_eSPI.h>
+
+TFT_eSPI::TFT_eSPI(int16_t width, int16_t height)
+{
+    _initWidth = _width = width;
+    _initHeight = _height = height;
+    _rotation = 0;
+    _pGfxFont = NULL;
+    _glyphAb = _glyphBb = 0;
+    _padX = 0;
+    _cursorX = _cursorY = 0;
+    _smoothFont = false;
+    _touchX = _touchY = 0;
+    _touchPressed = false;
+    textcolor = TFT_WHITE;
+    textbgcolor = TFT_BLACK;
+    textsize = 1;
+    textdatum = TL_DATUM;
+    textfont = 1;
+    writeDepth = 0;
+    pushMicros = 0;
+    allocate();
+}
+
+void TFT_eSPI::allocate()
+{
+    _pixels.assign((size_t)_width * _height, 0);
+    resetViewport();
+}
+
+void TFT_eSPI::init(uint8_t)
+{
+    resetViewport();
+}
+
+void TFT_eSPI::setRotation(uint8_t rotation)
+{
+    _rotation = rotation & 3;
+    _width = (_rotation & 1) ? _initHeight : _initWidth;
+    _height = (_rotation & 1) ? _initWidth : _initHeight;
+    allocate();
+}
+
+void TFT_eSPI::setViewport(int32_t x, int32_t y, int32_t w, int32_t h, bool vpDatum)
+{
+    _vpX = max(x, (int32_t)0);
+    _vpY = max(y, (int32_t)0);
+    _vpW = min(x + w, (int32_t)_width) - _vpX;
+    _vpH = min(y + h, (int32_t)_height) - _vpY;
+    _xDatum = vpDatum ? x : 0;
+    _yDatum = vpDatum ? y : 0;
+}
+
+void TFT_eSPI::resetViewport()
+{
+    _vpX = _vpY = 0;
+    _vpW = _width;
+    _vpH = _height;
+    _xDatum = _yDatum = 0;
+}
+
+bool TFT_eSPI::clip(int32_t &x, int32_t &y, int32_t &w, int32_t &h)
+{
+    x += _xDatum;
+    y += _yDatum;
+    if (x < _vpX) { w -= _vpX - x; x = _vpX; }
+    if (y < _vpY) { h -= _vpY - y; y = _vpY; }
+    if (x + w > _vpX + _vpW) w = _vpX + _vpW - x;
+    if (y + h > _vpY + _vpH) h = _vpY + _vpH - y;
+    return w > 0 && h > 0;
+}
+
+void TFT_eSPI::putPixel(int32_t x, int32_t y, uint32_t color)
+{
+    _pixels[(size_t)y * _width + x] = color;
+}
+
+uint16_t TFT_eSPI::pixelColor(int32_t x, int32_t y)
+{
+    return _pixels[(size_t)y * _width + x];
+}
+
+uint16_t TFT_eSPI::readPixel(int32_t x, int32_t y)
+{
+    x += _xDatum;
+    y += _yDatum;
+    if (x < 0 || y < 0 || x >= _width || y >= _height)
+        return 0;
+    return pixelColor(x, y);
+}
+
+void TFT_eSPI::drawPixel(int32_t x, int32_t y, uint32_t color)
+{
+    fillRect(x, y, 1, 1, color);
+}
+
+void TFT_eSPI::fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color)
+{
+    if (!clip(x, y, w, h))
+        return;
+    for (int32_t row = y; row < y + h; row++)
+        for (int32_t column = x; column < x + w; column++)
+            putPixel(column, row, color);
+}
+
+void TFT_eSPI::fillScreen(uint32_t color)
+{
+    fillRect(0, 0, _width, _height, color);
+}
+
+void TFT_eSPI::drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color)
+{
+    drawFastHLine(x, y, w, color);
+    drawFastHLine(x, y + h - 1, w, color);
+    drawFastVLine(x, y + 1, h - 2, color);
+    drawFastVLine(x + w - 1, y + 1, h - 2, color);
+}
+
+void TFT_eSPI::drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color)
+{
+    int32_t dx = abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
+    int32_t dy = -abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
+    int32_t error = dx + dy;
+    while (true)
+    {
+        drawPixel(x0, y0, color);
+        if (x0 == x1 && y0 == y1)
+            break;
+        int32_t e2 = 2 * error;
+        if (e2 >= dy) { error += dy; x0 += sx; }
+        if (e2 <= dx) { error += dx; y0 += sy; }
+    }
+}
+
+//the corner helpers of Adafruit_GFX, which TFT_eSPI uses as well
+static void fillCircleHelper(TFT_eSPI *tft, int32_t x0, int32_t y0, int32_t r, uint8_t corners, int32_t delta, uint32_t color)
+{
+    int32_t f = 1 - r, ddF_x = 1, ddF_y = -r - r, y = 0;
+    delta++;
+    while (y < r)
+    {
+        if (f >= 0)
+        {
+            if (corners & 0x1) tft->drawFastHLine(x0 - y, y0 + r, y + y + delta, color);
+            if (corners & 0x2) tft->drawFastHLine(x0 - y, y0 - r, y + y + delta, color);
+            r--;
+            ddF_y += 2;
+            f += ddF_y;
+        }
+        y++;
+        ddF_x += 2;
+        f += ddF_x;
+        if (corners & 0x1) tft->drawFastHLine(x0 - r, y0 + y, r + r + delta, color);
+        if (corners & 0x2) tft->drawFastHLine(x0 - r, y0 - y, r + r + delta, color);
+    }
+}
+
+static void drawCircleHelper(TFT_eSPI *tft, int32_t x0, int32_t y0, int32_t r, uint8_t corners, uint32_t color)
+{
+    int32_t f = 1 - r, ddF_x = 1, ddF_y = -2 * r, x = 0;
+    while (x < r)
+    {
+        if (f >= 0)
+        {
+            r--;
+            ddF_y += 2;
+            f += ddF_y;
+        }
+        x++;
+        ddF_x += 2;
+        f += ddF_x;
+        if (corners & 0x4) { tft->drawPixel(x0 + x, y0 + r, color); tft->drawPixel(x0 + r, y0 + x, color); }
+        if (corners & 0x2) { tft->drawPixel(x0 + x, y0 - r, color); tft->drawPixel(x0 + r, y0 - x, color); }
+        if (corners & 0x8) { tft->drawPixel(x0 - r, y0 + x, color); tft->drawPixel(x0 - x, y0 + r, color); }
+        if (corners & 0x1) { tft->drawPixel(x0 - r, y0 - x, color); tft->drawPixel(x0 - x, y0 - r, color); }
+    }
+}
+
+void TFT_eSPI::fillRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint32_t color)
+{
+    fillRect(x, y + r, w, h - r - r, color);
+    fillCircleHelper(this, x + r, y + h - r - 1, r, 1, w - r - r - 1, color);
+    fillCircleHelper(this, x + r, y + r, r, 2, w - r - r - 1, color);
+}
+
+void TFT_eSPI::drawRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint32_t color)
+{
+    drawFastHLine(x + r, y, w - r - r, color);
+    drawFastHLine(x + r, y + h - 1, w - r - r, color);
+    drawFastVLine(x, y + r, h - r - r, color);
+    drawFastVLine(x + w - 1, y + r, h - r - r, color);
+    drawCircleHelper(this, x + r, y + r, r, 1, color);
+    drawCircleHelper(this, x + w - r - 1, y + r, r, 2, color);
+    drawCircleHelper(this, x + w - r - 1, y + h - r - 1, r, 4, color);
+    drawCircleHelper(this, x + r, y + h - r - 1, r, 8, color);
+}
+
+void TFT_eSPI::setFreeFont(const GFXfont *pFont)
+{
+    _pGfxFont = pFont;
+    _glyphAb = _glyphBb = 0;
+    textfont = 1;
+    if (!pFont)
+        return;
+
+    for (uint16_t c = pFont->first; c <= pFont->last; c++)
+    {
+        const GFXglyph &glyph = pFont->glyph[c - pFont->first];
+        if (-glyph.yOffset > _glyphAb)
+            _glyphAb = -glyph.yOffset;
+        if (glyph.height + glyph.yOffset > _glyphBb)
+            _glyphBb = glyph.height + glyph.yOffset;
+    }
+}
+
+void TFT_eSPI::setTextFont(uint8_t font)
+{
+    _pGfxFont = NULL;
+    textfont = font;
+}
+
+int16_t TFT_eSPI::textWidth(const char *text)
+{
+    if (!_pGfxFont || _smoothFont)
+        return strlen(text) * 6 * textsize;
+
+    //like TFT_eSPI the last character is measured to the end of it's glyph and not by it's advance
+    int32_t width = 0;
+    while (*text)
+    {
+        uint8_t c = *text++;
+        if (c < _pGfxFont->first || c > _pGfxFont->last)
+            continue;
+        const GFXglyph &glyph = _pGfxFont->glyph[c - _pGfxFont->first];
+        if (*text)
+            width += glyph.xAdvance;
+        else
+            width += glyph.xOffset + glyph.width;
+    }
+    return width * textsize;
+}
+
+int16_t TFT_eSPI::fontHeight()
+{
+    if (!_pGfxFont || _smoothFont)
+        return 8 * textsize;
+    return _pGfxFont->yAdvance * textsize;
+}
+
+void TFT_eSPI::drawGlyph(uint8_t c, int32_t x, int32_t baseline)
+{
+    const GFXglyph &glyph = _pGfxFont->glyph[c - _pGfxFont->first];
+    const uint8_t *pBitmap = _pGfxFont->bitmap + glyph.bitmapOffset;
+    uint8_t bits = 0, bit = 0;
+    for (int32_t row = 0; row < glyph.height; row++)
+    {
+        for (int32_t column = 0; column < glyph.width; column++)
+        {
+            if (!(bit++ & 7))
+                bits = *pBitmap++;
+            if (bits & 0x80)
+                fillRect(x + (glyph.xOffset + column) * textsize, baseline + (glyph.yOffset + row) * textsize, textsize, textsize, textcolor);
+            bits <<= 1;
+        }
+    }
+}
+
+int16_t TFT_eSPI::drawString(const char *text, int32_t x, int32_t y)
+{
+    int32_t width = textWidth(text);
+    int32_t height = fontHeight();
+    int32_t baseline = 0;
+    bool freeFont = _pGfxFont && !_smoothFont;
+    if (freeFont)
+    {
+        height = _glyphAb * textsize;
+        y += height;
+        baseline = height;
+    }
+
+    switch (textdatum)
+    {
+    case TC_DATUM: x -= width / 2; break;
+    case TR_DATUM: x -= width; break;
+    case ML_DATUM: y -= height / 2; break;
+    case MC_DATUM: x -= width / 2; y -= height / 2; break;
+    case MR_DATUM: x -= width; y -= height / 2; break;
+    case BL_DATUM: y -= height; break;
+    case BC_DATUM: x -= width / 2; y -= height; break;
+    case BR_DATUM: x -= width; y -= height; break;
+    case L_BASELINE: y -= baseline; break;
+    case C_BASELINE: x -= width / 2; y -= baseline; break;
+    case R_BASELINE: x -= width; y -= baseline; break;
+    }
+
+    if (_padX > width && freeFont)
+    {
+        int32_t padTop = y - _glyphAb * textsize,
+                padHeight = (_glyphAb + _glyphBb) * textsize,
+                extra = _padX - width;
+        switch (textdatum)
+        {
+        case TC_DATUM: case MC_DATUM: case BC_DATUM: case C_BASELINE:
+            fillRect(x - extra / 2, padTop, extra / 2, padHeight, textbgcolor);
+            fillRect(x + width, padTop, extra - extra / 2, padHeight, textbgcolor);
+            break;
+        case TR_DATUM: case MR_DATUM: case BR_DATUM: case R_BASELINE:
+            fillRect(x - extra, padTop, extra, padHeight, textbgcolor);
+            break;
+        default:
+            fillRect(x + width, padTop, extra, padHeight, textbgcolor);
+            break;
+        }
+    }
+
+    HOST_DRAWN_TEXT drawn = {text, x + _xDatum, y + _yDatum, textsize};
+    drawnTexts.push_back(drawn);
+
+    if (freeFont)
+    {
+        int32_t cursor = x;
+        for (const char *p = text; *p; p++)
+        {
+            uint8_t c = *p;
+            if (c < _pGfxFont->first || c > _pGfxFont->last)
+                continue;
+            drawGlyph(c, cursor, y);
+            cursor += _pGfxFont->glyph[c - _pGfxFont->first].xAdvance * textsize;
+        }
+    }
+    return width;
+}
+
+size_t TFT_eSPI::write(uint8_t value)
+{
+    if (value == '\n')
+    {
+        _cursorX = 0;
+        _cursorY += fontHeight();
+    }
+    else if (value != '\r')
+    {
+        char text[2] = {(char)value, 0};
+        _cursorX += textWidth(text);
+    }
+    return 1;
+}
+
+uint8_t TFT_eSPI::getTouch(uint16_t *x, uint16_t *y, uint16_t threshold)
+{
+    (void)threshold;
+    if (!_touchPressed)
+        return 0;
+    *x = _touchX;
+    *y = _touchY;
+    return 1;
+}
+
+void TFT_eSPI::calibrateTouch(uint16_t *parameters, uint32_t colorFg, uint32_t colorBg, uint8_t size)
+{
+    (void)colorFg;
+    (void)colorBg;
+    (void)size;
+    uint16_t calibration[5] = {300, 3500, 300, 3500, 0};
+    memcpy(parameters, calibration, sizeof(calibration));
+}
+
+TFT_eSprite::TFT_eSprite(TFT_eSPI *pParent) : TFT_eSPI(0, 0)
+{
+    _pParent = pParent;
+    _colorDepth = 16;
+    _created = false;
+    _bitmapForeground = TFT_WHITE;
+    _bitmapBackground = TFT_BLACK;
+    setScrollRect(0, 0, 0, 0);
+}
+
+void *TFT_eSprite::createSprite(int16_t width, int16_t height, uint8_t frames)
+{
+    (void)frames;
+    if (_created)
+        return &_pixels[0];
+    if (width <= 0 || height <= 0)
+        return NULL;
+
+    _initWidth = _width = width;
+    _initHeight = _height = height;
+    allocate();
+    setScrollRect(0, 0, width, height);
+    _created = true;
+    return &_pixels[0];
+}
+
+void TFT_eSprite::deleteSprite()
+{
+    _pixels.clear();
+    _width = _height = 0;
+    _created = false;
+}
+
+void *TFT_eSprite::setColorDepth(int8_t depth)
+{
+    _colorDepth = depth;
+    if (!_created)
+        return NULL;
+
+    //like TFT_eSPI the sprite is made again with the new depth
+    int16_t width = _width, height = _height;
+    deleteSprite();
+    return createSprite(width, height);
+}
+
+void TFT_eSprite::putPixel(int32_t x, int32_t y, uint32_t color)
+{
+    TFT_eSPI::putPixel(x, y, _colorDepth == 1 ? (color ? 1 : 0) : color);
+}
+
+void TFT_eSprite::pushSprite(int32_t x, int32_t y)
+{
+    hostAdvanceMicros(_pParent->pushMicros);
+    for (int32_t row = 0; row < _height; row++)
+    {
+        for (int32_t column = 0; column < _width; column++)
+        {
+            uint16_t color = pixelColor(column, row);
+            if (_colorDepth == 1)
+                color = color ? _bitmapForeground : _bitmapBackground;
+            _pParent->drawPixel(x + column, y + row, color);
+        }
+    }
+}
+
+void TFT_eSprite::pushSprite(int32_t x, int32_t y, uint16_t transparent)
+{
+    hostAdvanceMicros(_pParent->pushMicros);
+    for (int32_t row = 0; row < _height; row++)
+    {
+        for (int32_t column = 0; column < _width; column++)
+        {
+            uint16_t color = pixelColor(column, row);
+            if (_colorDepth == 1)
+                color = color ? _bitmapForeground : _bitmapBackground;
+            if (color != transparent)
+                _pParent->drawPixel(x + column, y + row, color);
+        }
+    }
+}
+
+void TFT_eSprite::setScrollRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color)
+{
+    _scrollX = x;
+    _scrollY = y;
+    _scrollW = w;
+    _scrollH = h;
+    _scrollColor = color;
+}
+
+void TFT_eSprite::scroll(int16_t dx, int16_t dy)
+{
+    std::vector<uint16_t> moved(_pixels);
+    for (int32_t row = _scrollY; row < _scrollY + _scrollH; row++)
+    {
+        for (int32_t column = _scrollX; column < _scrollX + _scrollW; column++)
+        {
+            int32_t fromX = column - dx, fromY = row - dy;
+            bool inside = fromX >= _scrollX && fromX < _scrollX + _scrollW && fromY >= _scrollY && fromY < _scrollY + _scrollH;
+            moved[(size_t)row * _width + column] = inside ? _pixels[(size_t)fromY * _width + fromX] : (_colorDepth == 1 ? (_scrollColor ? 1 : 0) : _scrollColor);
+        }
+    }
+    _pixels.swap(moved);
+}
@@ -0,0 +1,244 @@
+#ifndef HOST_TFT_ESPI_H
+#define HOST_TFT_ESPI_H
+
+/*
+    A display in memory with the parts of TFT_eSPI used by the library.
+    Shapes, free fonts, sprites, viewports and the touch screen behave like TFT_eSPI so tests can compare the
+    pixels drawn and where texts were placed.
+*/
+
+#include <Arduino.h>
+#include <FS.h>
+
+#include <vector>
+
+#define LOAD_GFXFF
+#define SMOOTH_FONT
+
+#define TFT_BLACK       0x0000
+#define TFT_NAVY        0x000F
+#define TFT_DARKGREEN   0x03E0
+#define TFT_DARKCYAN    0x03EF
+#define TFT_MAROON      0x7800
+#define TFT_PURPLE      0x780F
+#define TFT_OLIVE       0x7BE0
+#define TFT_LIGHTGREY   0xD69A
+#define TFT_DARKGREY    0x7BEF
+#define TFT_BLUE        0x001F
+#define TFT_GREEN       0x07E0
+#define TFT_CYAN        0x07FF
+#define TFT_RED         0xF800
+#define TFT_MAGENTA     0xF81F
+#define TFT_YELLOW      0xFFE0
+#define TFT_WHITE       0xFFFF
+#define TFT_ORANGE      0xFDA0
+#define TFT_GREENYELLOW 0xB7E0
+#define TFT_PINK        0xFE19
+#define TFT_BROWN       0x9A60
+#define TFT_GOLD        0xFEA0
+#define TFT_SILVER      0xC618
+#define TFT_SKYBLUE     0x867D
+#define TFT_VIOLET      0x915C
+
+#define TL_DATUM 0
+#define TC_DATUM 1
+#define TR_DATUM 2
+#define ML_DATUM 3
+#define CL_DATUM 3
+#define MC_DATUM 4
+#define CC_DATUM 4
+#define MR_DATUM 5
+#define CR_DATUM 5
+#define BL_DATUM 6
+#define BC_DATUM 7
+#define BR_DATUM 8
+#define L_BASELINE 9
+#define C_BASELINE 10
+#define R_BASELINE 11
+
+#define TFT_SLPIN   0x10
+#define TFT_SLPOUT  0x11
+#define TFT_DISPOFF 0x28
+#define TFT_DISPON  0x29
+
+typedef struct {
+    uint16_t bitmapOffset;
+    uint8_t width;
+    uint8_t height;
+    uint8_t xAdvance;
+    int8_t xOffset;
+    int8_t yOffset;
+} GFXglyph;
+
+typedef struct {
+    uint8_t *bitmap;
+    GFXglyph *glyph;
+    uint16_t first;
+    uint16_t last;
+    uint8_t yAdvance;
+} GFXfont;
+
+/**
+ * @brief The font the menu uses by default, in the tests it is the font in HostFont.h
+ *
+ */
+extern const GFXfont FreeMonoBold9pt7b;
+
+/**
+ * @brief A text drawn with drawString, where the first character was placed after the datum was applied
+ *
+ */
+struct HOST_DRAWN_TEXT {
+    String text;
+    int32_t x;         //left of the text, in screen coordinates
+    int32_t baseline;  //baseline of the text, in screen coordinates
+    uint8_t textsize;
+};
+
+class TFT_eSPI : public Print
+{
+protected:
+    int32_t _initWidth, _initHeight;
+    int32_t _width, _height;
+    uint8_t _rotation;
+    std::vector<uint16_t> _pixels;
+
+    int32_t _xDatum, _yDatum;
+    int32_t _vpX, _vpY, _vpW, _vpH;
+
+    const GFXfont *_pGfxFont;
+    uint8_t _glyphAb, _glyphBb;
+    uint16_t _padX;
+    int32_t _cursorX, _cursorY;
+    bool _smoothFont;
+
+    uint16_t _touchX, _touchY;
+    bool _touchPressed;
+
+    /**
+     * @brief Stores a pixel in screen coordinates, already clipped
+     *
+     */
+    virtual void putPixel(int32_t x, int32_t y, uint32_t color);
+    virtual uint16_t pixelColor(int32_t x, int32_t y);
+    void allocate();
+    bool clip(int32_t &x, int32_t &y, int32_t &w, int32_t &h);
+    void drawGlyph(uint8_t c, int32_t x, int32_t baseline);
+
+public:
+    uint32_t textcolor, textbgcolor;
+    uint8_t textsize, textdatum, textfont;
+
+    /**
+     * @brief Every text drawn with drawString on this display, for tests
+     *
+     */
+    std::vector<HOST_DRAWN_TEXT> drawnTexts;
+    std::vector<uint8_t> commands;
+    int writeDepth;
+
+    /**
+     * @brief How long pushing a sprite to this display moves the clock, for tests of drawing in slices
+     *
+     */
+    unsigned long pushMicros;
+
+    TFT_eSPI(int16_t width = 240, int16_t height = 320);
+    virtual ~TFT_eSPI() {}
+
+    void init(uint8_t tc = 0);
+    void begin(uint8_t tc = 0) { init(tc); }
+    void setRotation(uint8_t rotation);
+    uint8_t getRotation() { return _rotation; }
+    int16_t width() { return _width; }
+    int16_t height() { return _height; }
+    void invertDisplay(bool) {}
+
+    void startWrite() { writeDepth++; }
+    void endWrite() { writeDepth--; }
+    void writecommand(uint8_t command) { commands.push_back(command); }
+    void writedata(uint8_t) {}
+
+    void setViewport(int32_t x, int32_t y, int32_t w, int32_t h, bool vpDatum = true);
+    void resetViewport();
+    void setOrigin(int32_t x, int32_t y) { _xDatum = x; _yDatum = y; }
+    int32_t getOriginX() { return _xDatum; }
+    int32_t getOriginY() { return _yDatum; }
+
+    void drawPixel(int32_t x, int32_t y, uint32_t color);
+    void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+    void fillScreen(uint32_t color);
+    void drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+    void drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color) { fillRect(x, y, w, 1, color); }
+    void drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color) { fillRect(x, y, 1, h, color); }
+    void drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color);
+    void fillRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint32_t color);
+    void drawRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint32_t color);
+    uint16_t readPixel(int32_t x, int32_t y);
+    uint16_t color565(uint8_t r, uint8_t g, uint8_t b) { return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3); }
+
+    void setTextColor(uint16_t color) { textcolor = textbgcolor = color; }
+    void setTextColor(uint16_t color, uint16_t backColor, bool bgfill = false) { textcolor = color; textbgcolor = backColor; (void)bgfill; }
+    void setTextSize(uint8_t size) { textsize = size > 0 ? size : 1; }
+    void setTextDatum(uint8_t datum) { textdatum = datum; }
+    uint8_t getTextDatum() { return textdatum; }
+    void setTextPadding(uint16_t padX) { _padX = padX; }
+    uint16_t getTextPadding() { return _padX; }
+    void setFreeFont(const GFXfont *pFont);
+    void setTextFont(uint8_t font);
+    void loadFont(String fontName, fs::FS &ffs) { (void)fontName; (void)ffs; _smoothFont = true; }
+    void loadFont(String fontName, bool flash = true) { (void)fontName; (void)flash; _smoothFont = true; }
+    void loadFont(const uint8_t array[]) { (void)array; _smoothFont = true; }
+    void unloadFont() { _smoothFont = false; }
+    int16_t textWidth(const char *text);
+    int16_t textWidth(const String &text) { return textWidth(text.c_str()); }
+    int16_t fontHeight();
+    int16_t drawString(const char *text, int32_t x, int32_t y);
+    int16_t drawString(const String &text, int32_t x, int32_t y) { return drawString(text.c_str(), x, y); }
+    void setCursor(int16_t x, int16_t y) { _cursorX = x; _cursorY = y; }
+    size_t write(uint8_t value);
+    using Print::write;
+
+    uint8_t getTouch(uint16_t *x, uint16_t *y, uint16_t threshold = 600);
+    void setTouch(uint16_t *parameters) { (void)parameters; }
+    void calibrateTouch(uint16_t *parameters, uint32_t colorFg, uint32_t colorBg, uint8_t size);
+
+    /**
+     * @brief Sets what getTouch returns, for tests
+     *
+     */
+    void setTouchState(uint16_t x, uint16_t y, bool pressed) { _touchX = x; _touchY = y; _touchPressed = pressed; }
+};
+
+class TFT_eSprite : public TFT_eSPI
+{
+private:
+    TFT_eSPI *_pParent;
+    uint8_t _colorDepth;
+    bool _created;
+    uint16_t _bitmapForeground, _bitmapBackground;
+    int32_t _scrollX, _scrollY, _scrollW, _scrollH;
+    uint16_t _scrollColor;
+
+protected:
+    void putPixel(int32_t x, int32_t y, uint32_t color);
+
+public:
+    explicit TFT_eSprite(TFT_eSPI *pParent);
+    ~TFT_eSprite() { deleteSprite(); }
+
+    void *createSprite(int16_t width, int16_t height, uint8_t frames = 1);
+    void deleteSprite();
+    bool created() { return _created; }
+    void *setColorDepth(int8_t depth);
+    int8_t getColorDepth() { return _colorDepth; }
+    void setBitmapColor(uint16_t foreground, uint16_t background) { _bitmapForeground = foreground; _bitmapBackground = background; }
+    void fillSprite(uint32_t color) { fillRect(-_xDatum, -_yDatum, _width, _height, color); }
+    void pushSprite(int32_t x, int32_t y);
+    void pushSprite(int32_t x, int32_t y, uint16_t transparent);
+    void setScrollRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color = TFT_BLACK);
+    void scroll(int16_t dx, int16_t dy = 0);
+    void *getPointer() { return _created ? &_pixels[0] : NULL; }
+};
+
+#endif
@@ -0,0 +1,113 @@
+/*
+    Adds samples to a chart on the screen and compares it with a chart drawn once with the same samples.
+*/
+
+#include "HostTest.h"
+
+#include <DisplayMenu.h>
+
+static double sampleValue(int i)
+{
+    //a slow wave with a spike now and then, so columns span several pixels
+    double value = 50 + 40 * sin(i / 23.0);
+    if (i % 37 == 0)
+        value = 100;
+    return value;
+}
+
+static DisplayChart *addChart(DisplayMenu &menu, uint16_t samplesPerColumn)
+{
+    DisplayPage *pPage = menu.addPage(TFT_NAVY);
+    DisplayChart *pChart = pPage->addChart(10, 40, 100, 80, TFT_DARKGREY, TFT_BLACK, TFT_GOLD, samplesPerColumn);
+    pChart->setRange(0, 100);
+    return pChart;
+}
+
+/**
+ * @brief Adds samples while the chart is shown, then draws a second chart with the same samples in one go
+ *
+ */
+static void checkSameAsDrawn(int sampleCount, uint16_t samplesPerColumn)
+{
+    TFT_eSPI tft;
+    DisplayMenu menu(&tft);
+    DisplayChart *pChart = addChart(menu, samplesPerColumn);
+    menu.showPage(0);
+
+    TFT_eSPI drawnTft;
+    DisplayMenu drawnMenu(&drawnTft);
+    DisplayChart *pDrawn = addChart(drawnMenu, samplesPerColumn);
+
+    for (int i = 0; i < sampleCount; i++)
+    {
+        pChart->addSample(sampleValue(i));
+        pDrawn->addSample(sampleValue(i));
+    }
+    drawnMenu.showPage(0);
+    CHECK_EQUAL(0, countDifferentPixels(drawnTft, tft));
+}
+
+static void testNotFull()
+{
+    checkSameAsDrawn(40, 1);
+    checkSameAsDrawn(97, 1);
+}
+
+static void testScrolling()
+{
+    checkSameAsDrawn(98, 1);
+    checkSameAsDrawn(99, 1);
+    checkSameAsDrawn(500, 1);
+    checkSameAsDrawn(1000, 3);
+}
+
+static void testOnlyNewColumnDrawn()
+{
+    TFT_eSPI tft;
+    DisplayMenu menu(&tft);
+    DisplayChart *pChart = addChart(menu, 1);
+    menu.showPage(0);
+    for (int i = 0; i < 10; i++)
+        pChart->addSample(sampleValue(i));
+
+    //a pixel painted over an earlier column stays when a column is added
+    tft.drawPixel(12, 45, TFT_RED);
+    pChart->addSample(sampleValue(10));
+    CHECK_EQUAL(TFT_RED, tft.readPixel(12, 45));
+}
+
+static void testShownAgain()
+{
+    TFT_eSPI tft;
+    DisplayMenu menu(&tft);
+    DisplayChart *pChart = addChart(menu, 1);
+    DisplayPage *pOther = menu.addPage(TFT_BLACK);
+    menu.showPage(0);
+    for (int i = 0; i < 200; i++)
+        pChart->addSample(sampleValue(i));
+
+    //samples added while the page is hidden are drawn when it is shown again
+    menu.showPage(pOther);
+    for (int i = 200; i < 250; i++)
+        pChart->addSample(sampleValue(i));
+    menu.showPage(0);
+    for (int i = 250; i < 260; i++)
+        pChart->addSample(sampleValue(i));
+
+    TFT_eSPI drawnTft;
+    DisplayMenu drawnMenu(&drawnTft);
+    DisplayChart *pDrawn = addChart(drawnMenu, 1);
+    for (int i = 0; i < 260; i++)
+        pDrawn->addSample(sampleValue(i));
+    drawnMenu.showPage(0);
+    CHECK_EQUAL(0, countDifferentPixels(drawnTft, tft));
+}
+
+int main()
+{
+    testNotFull();
+    testScrolling();
+    testOnlyNewColumnDrawn();
+    testShownAgain();
+    return testResult("chart");
+}
@@ -0,0 +1,58 @@
+/*
+    Loads a menu file and prints where every text of every page was drawn, one line per text:
+        page <tab> x <tab> baseline <tab> text
+    check_layout.py compares the lines with the layout of the menu compiler.
+*/
+
+#include "HostTest.h"
+
+#include <DisplayMenu.h>
+
+#define LAYOUT_VALUE_COUNT 64
+
+//every linked value is 0, like in the compiler preview
+static double values[LAYOUT_VALUE_COUNT];
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        printf("usage: test_layout menu.bin\n");
+        return 2;
+    }
+
+    FILE *pFile = fopen(argv[1], "rb");
+    if (!pFile)
+    {
+        printf("can not open %s\n", argv[1]);
+        return 2;
+    }
+    std::vector<uint8_t> data;
+    int c;
+    while ((c = fgetc(pFile)) != EOF)
+        data.push_back((uint8_t)c);
+    fclose(pFile);
+
+    TFT_eSPI tft;
+    DisplayMenu menu(&tft);
+    DisplayMenuFile file(data.data(), data.size());
+    for (uint16_t i = 0; i < LAYOUT_VALUE_COUNT; i++)
+        file.registerValue(i, &values[i]);
+    if (!menu.loadMenu(&file))
+    {
+        printf("%s is not a menu file\n", argv[1]);
+        return 2;
+    }
+
+    for (int p = 0; p < menu.getPageCount(); p++)
+    {
+        tft.drawnTexts.clear();
+        menu.showPage(p);
+        for (size_t i = 0; i < tft.drawnTexts.size(); i++)
+        {
+            const HOST_DRAWN_TEXT &text = tft.drawnTexts[i];
+            printf("%d\t%d\t%d\t%s\n", p, (int)text.x, (int)text.baseline, text.text.c_str());
+        }
+    }
+    return 0;
+}
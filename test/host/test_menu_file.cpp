@@ -0,0 +1,206 @@
+/*
+    Saves a menu with DisplayMenuFile, loads it into a second display and compares the items and the pixels drawn.
+*/
+
+#include "HostTest.h"
+
+#include <DisplayMenu.h>
+
+static double temperature = 21.5;
+static double humidity = 40;
+
+static void onStart(DisplayButton *) {}
+static void onStop(DisplayButton *) {}
+
+static void registerIds(DisplayMenuFile &file)
+{
+    file.registerAction(1, onStart);
+    file.registerAction(2, onStop);
+    file.registerValue(1, &temperature);
+    file.registerValue(2, &humidity);
+}
+
+static void buildMenu(DisplayMenu &menu)
+{
+    DisplayPage *pMain = menu.addPage(TFT_NAVY);
+    DisplayPage *pSettings = menu.addPage(TFT_DARKGREY);
+    DisplayPage *pAbout = menu.addPage();
+
+    DisplayLabel *pLabel = pMain->addPageLabel(10, 10, 140, 30, TFT_WHITE, TFT_NAVY, TFT_GOLD, 1, "Temperature");
+    pLabel = pMain->addPageLabel(160, 10, 100, 30, TFT_WHITE, TFT_BLACK, TFT_WHITE, 1, "", ALIGN_RIGHT);
+    pLabel->setLinkToValue(&temperature, "temperature");
+    pLabel->setLinkedValueFormat(1);
+    pLabel->setRadius(6);
+    pLabel = pMain->addPageLabel(10, 200, 100, 30, TFT_WHITE, TFT_BLACK, TFT_WHITE, 1, "Hidden");
+    pLabel->hide();
+
+    DisplayButton *pButton = pMain->addFunctionButton(10, 50, 100, 40, TFT_WHITE, TFT_RED, TFT_WHITE, 1, "Start", onStart);
+    pButton->setRadius(10);
+    pButton = pMain->addFunctionButton(120, 50, 100, 40, TFT_WHITE, TFT_RED, TFT_WHITE, 2, "Stop", onStop);
+    pButton->setTextAlign(ALIGN_RIGHT, -4, 2);
+    pMain->addPageButton(10, 100, 120, 40, TFT_WHITE, TFT_PURPLE, TFT_WHITE, 1, "Settings", pSettings, ALIGN_LEFT);
+    pMain->addPageButton(140, 100, 120, 40, TFT_WHITE, TFT_PURPLE, TFT_WHITE, 1, "About", pAbout);
+
+    pSettings->addIncrementButton(10, 10, 60, 40, TFT_WHITE, TFT_BLUE, TFT_WHITE, 1, "+", &temperature, 0.5);
+    pSettings->addIncrementButton(80, 10, 60, 40, TFT_WHITE, TFT_BLUE, TFT_WHITE, 1, "-", &temperature, -0.5);
+    pLabel = pSettings->addPageLabel(150, 10, 100, 40, TFT_WHITE, TFT_BLACK, TFT_WHITE, 1, "", ALIGN_CENTER);
+    pLabel->setLinkToValue(&humidity, "humidity");
+    pLabel->setLinkedValueFormat(0);
+    pButton = pSettings->addFunctionButton(10, 60, 100, 40, TFT_WHITE, TFT_BLUE, TFT_WHITE, 1, "Reset", NULL);
+    pButton->setLinkToValue(&humidity, "humidity");
+    pButton->setLinkedValueFormat(2, false);
+    pSettings->addPageButton(10, 180, 100, 40, TFT_WHITE, TFT_PURPLE, TFT_WHITE, 1, "Back", pMain);
+
+    pAbout->addPageLabel(10, 10, 300, 30, TFT_GOLD, TFT_BLACK, TFT_GOLD, 1, "DisplayMenu", ALIGN_CENTER);
+    pAbout->addPageButton(10, 180, 100, 40, TFT_WHITE, TFT_PURPLE, TFT_WHITE, 1, "Back", NULL);
+}
+
+template <typename VALUES>
+static void checkSameValues(VALUES &expected, VALUES &actual)
+{
+    CHECK_EQUAL(expected.x, actual.x);
+    CHECK_EQUAL(expected.y, actual.y);
+    CHECK_EQUAL(expected.width, actual.width);
+    CHECK_EQUAL(expected.height, actual.height);
+    CHECK_EQUAL(expected.xDatumOffset, actual.xDatumOffset);
+    CHECK_EQUAL(expected.yDatumOffset, actual.yDatumOffset);
+    CHECK_EQUAL(expected.textAlign, actual.textAlign);
+    CHECK_EQUAL(expected.state, actual.state);
+    CHECK_TEXT(expected.text, actual.text);
+    CHECK(expected.pLinkedValue == actual.pLinkedValue);
+    CHECK_EQUAL(expected.linkedValuePrecision, actual.linkedValuePrecision);
+    CHECK_EQUAL(expected.linkedValueTrimZeros, actual.linkedValueTrimZeros);
+    CHECK_EQUAL(expected.pStyle->getOutlineColor(), actual.pStyle->getOutlineColor());
+    CHECK_EQUAL(expected.pStyle->getFillColor(), actual.pStyle->getFillColor());
+    CHECK_EQUAL(expected.pStyle->getTextColor(), actual.pStyle->getTextColor());
+    CHECK_EQUAL(expected.pStyle->getTextSize(), actual.pStyle->getTextSize());
+    CHECK_EQUAL(expected.pStyle->getRadius(expected.width, expected.height), actual.pStyle->getRadius(actual.width, actual.height));
+}
+
+static void checkSameMenu(DisplayMenu &expected, DisplayMenu &actual)
+{
+    CHECK_EQUAL(expected.getPageCount(), actual.getPageCount());
+    for (int p = 0; p < expected.getPageCount() && p < actual.getPageCount(); p++)
+    {
+        DisplayPage *pExpected = expected.getPage(p);
+        DisplayPage *pActual = actual.getPage(p);
+        pExpected->build();
+        pActual->build();
+        CHECK_EQUAL(pExpected->getFillColor(), pActual->getFillColor());
+        CHECK_EQUAL(pExpected->labelCount(), pActual->labelCount());
+        CHECK_EQUAL(pExpected->buttonCount(), pActual->buttonCount());
+
+        for (int i = 0; i < pExpected->labelCount() && i < pActual->labelCount(); i++)
+            checkSameValues(pExpected->getLabel(i)->_values, pActual->getLabel(i)->_values);
+
+        for (int i = 0; i < pExpected->buttonCount() && i < pActual->buttonCount(); i++)
+        {
+            DISPLAY_BUTTON_VALUES &expectedValues = pExpected->getButton(i)->_values;
+            DISPLAY_BUTTON_VALUES &actualValues = pActual->getButton(i)->_values;
+            checkSameValues(expectedValues, actualValues);
+            CHECK_EQUAL(expectedValues.type, actualValues.type);
+            CHECK_EQUAL(expectedValues.incrementValue, actualValues.incrementValue);
+            CHECK(expectedValues.buttonPressedFunction.getFunction() == actualValues.buttonPressedFunction.getFunction());
+            CHECK_EQUAL(expected.getPageIndex(expectedValues.pPageToOpen), actual.getPageIndex(actualValues.pPageToOpen));
+        }
+    }
+}
+
+static void checkSamePixels(DisplayMenu &expected, TFT_eSPI &expectedTft, DisplayMenu &actual, TFT_eSPI &actualTft)
+{
+    for (int p = 0; p < expected.getPageCount(); p++)
+    {
+        expected.showPage(p);
+        actual.showPage(p);
+        CHECK_EQUAL(0, countDifferentPixels(expectedTft, actualTft));
+    }
+}
+
+static void testRoundTrip()
+{
+    TFT_eSPI tft;
+    DisplayMenu menu(&tft);
+    buildMenu(menu);
+
+    DisplayMenuFile writer(NULL, 0);
+    registerIds(writer);
+    HostBuffer saved;
+    size_t size = writer.save(&menu, saved);
+    CHECK_EQUAL(saved.bytes.size(), size);
+
+    //from memory
+    TFT_eSPI loadedTft;
+    DisplayMenu loaded(&loadedTft);
+    DisplayMenuFile file(saved.bytes.data(), saved.bytes.size());
+    registerIds(file);
+    CHECK(loaded.loadMenu(&file));
+    checkSameMenu(menu, loaded);
+    checkSamePixels(menu, tft, loaded, loadedTft);
+
+    //saving the loaded menu writes the same bytes
+    HostBuffer again;
+    file.save(&loaded, again);
+    CHECK(saved.bytes == again.bytes);
+
+    //from a file system
+    fs::FS fileSystem;
+    fileSystem.add("/menu.bin", saved.bytes.data(), saved.bytes.size());
+    TFT_eSPI fileTft;
+    DisplayMenu fromFile(&fileTft);
+    DisplayMenuFile menuFile(fileSystem, "/menu.bin");
+    registerIds(menuFile);
+    CHECK(fromFile.loadMenu(&menuFile));
+    checkSameMenu(menu, fromFile);
+    checkSamePixels(menu, tft, fromFile, fileTft);
+}
+
+static void testPageOffsets()
+{
+    TFT_eSPI tft;
+    DisplayMenu menu(&tft);
+    buildMenu(menu);
+    DisplayMenuFile writer(NULL, 0);
+    HostBuffer saved;
+    writer.save(&menu, saved);
+
+    //the page table points at the first item of every page, the records follow each other without gaps
+    const std::vector<uint8_t> &bytes = saved.bytes;
+    uint16_t pageCount = bytes[6] | (bytes[7] << 8);
+    uint16_t styleCount = bytes[8] | (bytes[9] << 8);
+    size_t table = 10 + styleCount * 7;
+    size_t expectedOffset = table + pageCount * 8;
+    for (uint16_t p = 0; p < pageCount; p++)
+    {
+        const uint8_t *pEntry = &bytes[table + p * 8];
+        uint32_t offset = pEntry[0] | (pEntry[1] << 8) | (pEntry[2] << 16) | ((uint32_t)pEntry[3] << 24);
+        uint16_t itemCount = pEntry[6] | (pEntry[7] << 8);
+        CHECK_EQUAL(expectedOffset, offset);
+
+        //skip the items, the text length is the last byte of the fixed part
+        for (uint16_t i = 0; i < itemCount && expectedOffset < bytes.size(); i++)
+        {
+            uint8_t textLength = bytes[expectedOffset + 31];
+            expectedOffset += 32 + textLength;
+        }
+    }
+    CHECK_EQUAL(bytes.size(), expectedOffset);
+}
+
+static void testRejectsOtherFiles()
+{
+    const uint8_t notAMenu[] = {'D', 'M', 'N', 'X', 1, 0, 0, 0, 0, 0};
+    DisplayMenuFile file(notAMenu, sizeof(notAMenu));
+    CHECK(!file.open(0));
+
+    fs::FS fileSystem;
+    DisplayMenuFile missing(fileSystem, "/missing.bin");
+    CHECK(!missing.open(0));
+}
+
+int main()
+{
+    testRoundTrip();
+    testPageOffsets();
+    testRejectsOtherFiles();
+    return testResult("menu_file");
+}
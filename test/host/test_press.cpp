@@ -0,0 +1,233 @@
+/*
+    Presses buttons through the touch screen and checks update follows the press without waiting in it.
+*/
+
+#include "HostTest.h"
+
+#include <DisplayMenu.h>
+
+static int pressCount = 0;
+static double value = 0;
+static int32_t count = 0;
+static DisplayBinding<int32_t> countBinding(&count, 0, 100, 1);
+
+static void onPress(DisplayButton *) { pressCount++; }
+
+static void buildMenu(DisplayMenu &menu)
+{
+    DisplayPage *pPage = menu.addPage(TFT_NAVY);
+    DisplayPage *pOther = menu.addPage(TFT_BLACK);
+    pPage->addFunctionButton(10, 10, 100, 40, TFT_WHITE, TFT_RED, TFT_WHITE, 1, "Press", onPress);
+    pPage->addIncrementButton(10, 60, 100, 40, TFT_WHITE, TFT_BLUE, TFT_WHITE, 1, "+", &value, 1);
+    pPage->addIncrementButton(120, 10, 100, 40, TFT_WHITE, TFT_BLUE, TFT_WHITE, 1, "++", &countBinding, 1);
+    pOther->addPageButton(10, 10, 100, 40, TFT_WHITE, TFT_PURPLE, TFT_WHITE, 1, "Back", pPage);
+    menu.showPage(0);
+}
+
+/**
+ * @brief Calls update and checks it did not wait
+ *
+ */
+static bool update(DisplayMenu &menu)
+{
+    unsigned long start = micros();
+    bool updated = menu.update();
+    CHECK_EQUAL(start, micros());
+    return updated;
+}
+
+static void testCommandRunsAfterRelease()
+{
+    TFT_eSPI tft;
+    DisplayMenu menu(&tft);
+    buildMenu(menu);
+    pressCount = 0;
+
+    tft.setTouchState(50, 30, true);
+    CHECK(update(menu));
+    CHECK_EQUAL(DISPLAY_MENU_PRESS_MILLIS, menu.getNextUpdateDelay());
+
+    //nothing happens before the press has been shown
+    delay(DISPLAY_MENU_PRESS_MILLIS / 2);
+    CHECK(!update(menu));
+    CHECK_EQUAL(DISPLAY_MENU_PRESS_MILLIS / 2, menu.getNextUpdateDelay());
+    delay(DISPLAY_MENU_PRESS_MILLIS / 2);
+    CHECK(!update(menu));
+    CHECK_EQUAL(DISPLAY_MENU_TOUCH_POLL_MILLIS, menu.getNextUpdateDelay());
+
+    //held for a while
+    for (int i = 0; i < 10; i++)
+    {
+        delay(DISPLAY_MENU_TOUCH_POLL_MILLIS);
+        CHECK(!update(menu));
+    }
+    CHECK_EQUAL(0, pressCount);
+
+    //a short release is a bounce
+    tft.setTouchState(50, 30, false);
+    delay(DISPLAY_MENU_TOUCH_POLL_MILLIS);
+    CHECK(!update(menu));
+    CHECK_EQUAL(DISPLAY_MENU_RELEASE_MILLIS, menu.getNextUpdateDelay());
+    tft.setTouchState(50, 30, true);
+    delay(DISPLAY_MENU_RELEASE_MILLIS);
+    CHECK(!update(menu));
+    CHECK_EQUAL(0, pressCount);
+
+    tft.setTouchState(50, 30, false);
+    delay(DISPLAY_MENU_TOUCH_POLL_MILLIS);
+    CHECK(!update(menu));
+    delay(DISPLAY_MENU_RELEASE_MILLIS);
+    CHECK(update(menu));
+    CHECK_EQUAL(1, pressCount);
+}
+
+static void testHeldButtonRepeats()
+{
+    TFT_eSPI tft;
+    DisplayMenu menu(&tft);
+    buildMenu(menu);
+    value = 0;
+
+    tft.setTouchState(50, 80, true);
+    for (int i = 1; i <= 3; i++)
+    {
+        CHECK(update(menu));
+        delay(DISPLAY_MENU_PRESS_MILLIS);
+        CHECK(update(menu));
+        CHECK_EQUAL(i, value);
+    }
+}
+
+static void testBoundButtonReleased()
+{
+    TFT_eSPI tft;
+    DisplayMenu menu(&tft);
+    buildMenu(menu);
+    count = 0;
+
+    //inverted while it is held
+    tft.setTouchState(170, 30, true);
+    CHECK(update(menu));
+    CHECK_EQUAL(TFT_WHITE, tft.readPixel(130, 20));
+    delay(DISPLAY_MENU_PRESS_MILLIS);
+    CHECK(update(menu));
+    CHECK_EQUAL(1, count);
+
+    tft.setTouchState(170, 30, false);
+    delay(DISPLAY_MENU_TOUCH_POLL_MILLIS);
+    update(menu);
+    CHECK_EQUAL(TFT_BLUE, tft.readPixel(130, 20));
+
+    //also at the end of the range, where the value does not change
+    count = 100;
+    tft.setTouchState(170, 30, true);
+    CHECK(update(menu));
+    delay(DISPLAY_MENU_PRESS_MILLIS);
+    CHECK(update(menu));
+    tft.setTouchState(170, 30, false);
+    delay(DISPLAY_MENU_TOUCH_POLL_MILLIS);
+    update(menu);
+    CHECK_EQUAL(100, count);
+    CHECK_EQUAL(TFT_BLUE, tft.readPixel(130, 20));
+}
+
+static void testShowPageForgetsPress()
+{
+    TFT_eSPI tft;
+    DisplayMenu menu(&tft);
+    buildMenu(menu);
+    value = 0;
+
+    tft.setTouchState(50, 80, true);
+    CHECK(update(menu));
+    menu.showPage(1);
+    tft.setTouchState(50, 80, false);
+    delay(DISPLAY_MENU_PRESS_MILLIS);
+    update(menu);
+    CHECK_EQUAL(0, value);
+}
+
+static void testReplayWaitsForPress()
+{
+    TFT_eSPI tft;
+    DisplayMenu menu(&tft);
+    buildMenu(menu);
+    DisplayTouchRecorder recorder(10);
+    recorder.record();
+    recorder.add(50, 80, true);
+    recorder.add(0, 0, false);
+    recorder.replay();
+    menu.setTouchRecorder(&recorder);
+    value = 0;
+
+    //a replay is not read while the press is shown, so the menu can wait for it
+    CHECK(update(menu));
+    CHECK(recorder.isReplaying());
+    CHECK_EQUAL(DISPLAY_MENU_PRESS_MILLIS, menu.getNextUpdateDelay());
+    delay(DISPLAY_MENU_PRESS_MILLIS);
+    CHECK(update(menu));
+    CHECK_EQUAL(1, value);
+}
+
+static void testWakeDoesNotWait()
+{
+    TFT_eSPI tft;
+    DisplayMenu menu(&tft);
+    buildMenu(menu);
+    menu.setIdleTimeout(1);
+    delay(1000);
+    update(menu);
+    CHECK(menu.isAsleep());
+
+    //the panel is given time to come out of sleep between calls to update
+    tft.setTouchState(50, 80, true);
+    update(menu);
+    CHECK(menu.isAsleep());
+    CHECK_EQUAL(DISPLAY_MENU_SLEEP_OUT_MILLIS, menu.getNextUpdateDelay());
+    menu.showPage(1);
+    delay(DISPLAY_MENU_SLEEP_OUT_MILLIS - 1);
+    update(menu);
+    CHECK(menu.isAsleep());
+    delay(1);
+    update(menu);
+    CHECK(!menu.isAsleep());
+    CHECK_EQUAL(1, menu.getPageIndex(menu.getVisablePage()));
+}
+
+static void testRemovedPageNotShownOnWake()
+{
+    TFT_eSPI tft;
+    DisplayMenu menu(&tft);
+    buildMenu(menu);
+    DisplayPage *pLast = menu.addPage(TFT_DARKGREEN);
+    menu.sleep();
+
+    //the page to show moves down when a page before it is removed, and is forgotten when it is removed
+    menu.showPage(2);
+    CHECK(menu.removePage(1));
+    menu.wake();
+    delay(DISPLAY_MENU_SLEEP_OUT_MILLIS);
+    update(menu);
+    CHECK(menu.getVisablePage() == pLast);
+
+    menu.sleep();
+    menu.showPage(0);
+    CHECK(menu.removePage(0));
+    menu.wake();
+    delay(DISPLAY_MENU_SLEEP_OUT_MILLIS);
+    update(menu);
+    CHECK(!menu.isAsleep());
+    CHECK(menu.getVisablePage() == pLast);
+}
+
+int main()
+{
+    testCommandRunsAfterRelease();
+    testHeldButtonRepeats();
+    testBoundButtonReleased();
+    testShowPageForgetsPress();
+    testReplayWaitsForPress();
+    testWakeDoesNotWait();
+    testRemovedPageNotShownOnWake();
+    return testResult("press");
+}
@@ -0,0 +1,90 @@
+/*
+    Changes values and styles while a page is drawn in strips and compares the result with the page drawn in one go.
+*/
+
+#include "HostTest.h"
+
+#include <DisplayMenu.h>
+
+static double top = 1;
+static double bottom = 2;
+
+/**
+ * @brief Labels showing values at the top and the bottom of the page, each strip takes 100us to send
+ *
+ */
+static void buildMenu(DisplayMenu &menu, TFT_eSPI &tft, DisplayStyle *pStyle, DisplayLabel **ppTop, DisplayLabel **ppBottom)
+{
+    tft.pushMicros = 100;
+    menu.enableSlicedDraw(16);
+    DisplayPage *pFirst = menu.addPage(TFT_DARKGREEN);
+    pFirst->addPageLabel(10, 10, 200, 200, TFT_WHITE, TFT_RED, TFT_WHITE, 1, "First");
+
+    DisplayPage *pPage = menu.addPage(TFT_NAVY);
+    *ppTop = pPage->addPageLabel(10, 10, 100, 30, TFT_WHITE, TFT_BLACK, TFT_WHITE, 1, "", ALIGN_RIGHT);
+    (*ppTop)->setLinkToValue(&top, "top");
+    (*ppTop)->setLinkedValueFormat(1);
+    (*ppTop)->setStyle(pStyle);
+    *ppBottom = pPage->addPageLabel(10, 180, 100, 30, TFT_WHITE, TFT_BLACK, TFT_WHITE, 1, "", ALIGN_RIGHT);
+    (*ppBottom)->setLinkToValue(&bottom, "bottom");
+    (*ppBottom)->setLinkedValueFormat(1);
+    menu.showPage(0);
+    menu.update();
+}
+
+static void testChangesWhileDrawing()
+{
+    DisplayStyle *pStyle = DisplayStyle::create(TFT_WHITE, TFT_BLACK, TFT_WHITE, 1, 0);
+    TFT_eSPI tft;
+    DisplayMenu menu(&tft);
+    DisplayLabel *pTop, *pBottom;
+    buildMenu(menu, tft, pStyle, &pTop, &pBottom);
+    top = 1;
+    bottom = 2;
+
+    menu.showPage(1);
+    CHECK(menu.isDrawingPage());
+    menu.update(250);
+    CHECK(menu.isDrawingPage());
+
+    //the bottom label is not on the display yet, what is there must not be drawn over
+    bottom = 20;
+    top = 10;
+    int32_t pixelsBefore = 0;
+    for (int32_t y = 180; y < 210; y++)
+        for (int32_t x = 10; x < 110; x++)
+            pixelsBefore += tft.readPixel(x, y) == TFT_RED;
+    pBottom->drawValue();
+    pTop->drawValue();
+    pStyle->setColors(TFT_YELLOW, TFT_DARKCYAN, TFT_BLACK);
+    menu.update(250);
+    int32_t pixelsAfter = 0;
+    for (int32_t y = 180; y < 210; y++)
+        for (int32_t x = 10; x < 110; x++)
+            pixelsAfter += tft.readPixel(x, y) == TFT_RED;
+    CHECK(pixelsBefore > 0);
+    CHECK_EQUAL(pixelsBefore, pixelsAfter);
+
+    while (menu.isDrawingPage())
+        menu.update(250);
+    menu.update(250);
+
+    //the top label was sent before it changed, it is drawn again when the page is done
+    DisplayStyle *pDrawnStyle = DisplayStyle::create(TFT_YELLOW, TFT_DARKCYAN, TFT_BLACK, 1, 0);
+    TFT_eSPI drawnTft;
+    DisplayMenu drawnMenu(&drawnTft);
+    DisplayLabel *pDrawnTop, *pDrawnBottom;
+    buildMenu(drawnMenu, drawnTft, pDrawnStyle, &pDrawnTop, &pDrawnBottom);
+    drawnMenu.enableSlicedDraw(0);
+    drawnMenu.showPage(1);
+    CHECK_EQUAL(0, countDifferentPixels(drawnTft, tft));
+
+    pDrawnStyle->release();
+    pStyle->release();
+}
+
+int main()
+{
+    testChangesWhileDrawing();
+    return testResult("sliced_draw");
+}
@@ -0,0 +1,169 @@
+/*
+    Changes styles of items on a shown page and compares the screen with the page drawn with the new styles.
+*/
+
+#include "HostTest.h"
+
+#include <DisplayMenu.h>
+
+#include <new>
+
+//arrays allocated by the library while the test runs
+static int arrayAllocations = 0;
+
+void *operator new[](size_t size)
+{
+    arrayAllocations++;
+    void *ptr = malloc(size);
+    if (!ptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void operator delete[](void *ptr) noexcept { free(ptr); }
+
+/**
+ * @brief A label with a button on top of it and a label on top of the button, all overlapping
+ *
+ */
+static void buildPage(DisplayMenu &menu, DisplayStyle *pBottom, DisplayStyle *pMiddle)
+{
+    DisplayPage *pPage = menu.addPage(TFT_NAVY);
+    pPage->addPageLabel(10, 10, 120, 60, TFT_WHITE, TFT_BLACK, TFT_WHITE, 1, "Below")->setStyle(pBottom);
+    pPage->addFunctionButton(60, 40, 120, 60, TFT_WHITE, TFT_RED, TFT_WHITE, 1, "Button", NULL)->setStyle(pMiddle);
+    pPage->addFunctionButton(150, 80, 80, 40, TFT_WHITE, TFT_PURPLE, TFT_WHITE, 1, "Top", NULL);
+}
+
+static void checkSameAsDrawn(TFT_eSPI &tft, DisplayStyle *pBottom, DisplayStyle *pMiddle)
+{
+    TFT_eSPI drawnTft;
+    DisplayMenu drawnMenu(&drawnTft);
+    buildPage(drawnMenu, pBottom, pMiddle);
+    drawnMenu.showPage(0);
+    CHECK_EQUAL(0, countDifferentPixels(drawnTft, tft));
+}
+
+static void testOverlappingItemsKeepTheirOrder()
+{
+    DisplayStyle *pBottom = DisplayStyle::create(TFT_WHITE, TFT_BLACK, TFT_WHITE, 1, 0);
+    DisplayStyle *pMiddle = DisplayStyle::create(TFT_WHITE, TFT_RED, TFT_WHITE, 1, 0);
+
+    TFT_eSPI tft;
+    DisplayMenu menu(&tft);
+    buildPage(menu, pBottom, pMiddle);
+    menu.showPage(0);
+
+    //the label below is drawn again without covering the button on top of it
+    pBottom->setColors(TFT_YELLOW, TFT_DARKGREEN, TFT_BLACK);
+    menu.update();
+    checkSameAsDrawn(tft, pBottom, pMiddle);
+    DisplayLabel *pLabel = menu.getPage(0)->getLastLabel();
+    CHECK_EQUAL(TFT_YELLOW, pLabel->getOutlineColor());
+    CHECK_EQUAL(TFT_DARKGREEN, pLabel->getFillColor());
+    CHECK_EQUAL(TFT_BLACK, pLabel->getTextColor());
+    CHECK_EQUAL(1, pLabel->getTextSize());
+
+    //rounder corners show the label and the page below them, the label on top stays on top
+    pMiddle->setRadius(20);
+    menu.update();
+    checkSameAsDrawn(tft, pBottom, pMiddle);
+
+    pMiddle->setRadius(0);
+    pMiddle->setColors(TFT_BLACK, TFT_CYAN, TFT_BLACK);
+    menu.update();
+    checkSameAsDrawn(tft, pBottom, pMiddle);
+
+    pBottom->release();
+    pMiddle->release();
+}
+
+static void testSharedStylesDoNotChange()
+{
+    DisplayStyle *pShared = DisplayStyle::get(TFT_WHITE, TFT_BLACK, TFT_WHITE, 1);
+    uint32_t lastChange = DisplayStyle::getLastChange();
+    CHECK(pShared->isShared());
+    CHECK(!pShared->setColors(TFT_RED, TFT_RED, TFT_RED));
+    CHECK(!pShared->setTextSize(2));
+    CHECK(!pShared->setRadius(3));
+    CHECK(!pShared->setFont(NULL));
+    CHECK_EQUAL(TFT_BLACK, pShared->getFillColor());
+    CHECK_EQUAL(1, pShared->getTextSize());
+    CHECK_EQUAL(DISPLAY_STYLE_AUTO_RADIUS, pShared->getRadius());
+    CHECK_EQUAL(lastChange, DisplayStyle::getLastChange());
+
+    //a created style with the same values is not returned by get and can be changed
+    DisplayStyle *pCreated = DisplayStyle::create(TFT_WHITE, TFT_BLACK, TFT_WHITE, 1);
+    CHECK(pCreated != pShared);
+    CHECK(pCreated->setColors(TFT_RED, TFT_RED, TFT_RED));
+    CHECK_EQUAL(TFT_RED, pCreated->getFillColor());
+    CHECK(pCreated->isChangedSince(lastChange));
+    DisplayStyle *pAgain = DisplayStyle::get(TFT_WHITE, TFT_BLACK, TFT_WHITE, 1);
+    CHECK(pAgain == pShared);
+
+    pAgain->release();
+    pCreated->release();
+    pShared->release();
+}
+
+static int drawCount = 0;
+
+static void onDraw(DisplayPage *pPage)
+{
+    drawCount++;
+    pPage->getDisplay()->fillRect(0, 200, 20, 20, TFT_ORANGE);
+}
+
+static void testDrawEventOncePerChange()
+{
+    DisplayStyle *pBottom = DisplayStyle::create(TFT_WHITE, TFT_BLACK, TFT_WHITE, 1, 0);
+    DisplayStyle *pMiddle = DisplayStyle::create(TFT_WHITE, TFT_RED, TFT_WHITE, 1, 0);
+    TFT_eSPI tft;
+    DisplayMenu menu(&tft);
+    buildPage(menu, pBottom, pMiddle);
+    menu.getPage(0)->registerOnDrawEvent(onDraw);
+    menu.showPage(0);
+
+    //two items changing is one call to the page draw function
+    drawCount = 0;
+    pBottom->setColors(TFT_YELLOW, TFT_DARKGREEN, TFT_BLACK);
+    pMiddle->setColors(TFT_BLACK, TFT_CYAN, TFT_BLACK);
+    menu.update();
+    CHECK_EQUAL(1, drawCount);
+    CHECK_EQUAL(TFT_ORANGE, tft.readPixel(5, 205));
+
+    pBottom->release();
+    pMiddle->release();
+}
+
+static void testDrawingDoesNotAllocate()
+{
+    DisplayStyle *pBottom = DisplayStyle::create(TFT_WHITE, TFT_BLACK, TFT_WHITE, 1, 0);
+    DisplayStyle *pMiddle = DisplayStyle::create(TFT_WHITE, TFT_RED, TFT_WHITE, 1, 0);
+    TFT_eSPI tft;
+    DisplayMenu menu(&tft);
+    buildPage(menu, pBottom, pMiddle);
+    menu.showPage(0);
+
+    //the occlusion buffers are kept with the page, only a new layout works them out again
+    int before = arrayAllocations;
+    menu.getPage(0)->draw(true);
+    pBottom->setColors(TFT_YELLOW, TFT_DARKGREEN, TFT_BLACK);
+    menu.update();
+    pMiddle->setRadius(20);
+    menu.update();
+    menu.getPage(0)->draw(true);
+    CHECK_EQUAL(before, arrayAllocations);
+    checkSameAsDrawn(tft, pBottom, pMiddle);
+
+    pBottom->release();
+    pMiddle->release();
+}
+
+int main()
+{
+    testOverlappingItemsKeepTheirOrder();
+    testDrawEventOncePerChange();
+    testDrawingDoesNotAllocate();
+    testSharedStylesDoNotChange();
+    return testResult("style");
+}
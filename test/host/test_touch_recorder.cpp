@@ -0,0 +1,173 @@
+/*
+    Records presses on a menu, saves and loads the recording and replays it on a second menu.
+*/
+
+#include "HostTest.h"
+
+#include <DisplayMenu.h>
+
+static int pressCount = 0;
+static double value = 0;
+
+static void onPress(DisplayButton *) { pressCount++; }
+
+static void buildMenu(DisplayMenu &menu)
+{
+    DisplayPage *pPage = menu.addPage(TFT_NAVY);
+    DisplayPage *pOther = menu.addPage(TFT_BLACK);
+    pPage->addFunctionButton(10, 10, 100, 40, TFT_WHITE, TFT_RED, TFT_WHITE, 1, "Press", onPress);
+    pPage->addIncrementButton(10, 60, 100, 40, TFT_WHITE, TFT_BLUE, TFT_WHITE, 1, "+", &value, 1);
+    pPage->addPageButton(10, 110, 100, 40, TFT_WHITE, TFT_PURPLE, TFT_WHITE, 1, "Other", pOther);
+    pOther->addPageButton(10, 10, 100, 40, TFT_WHITE, TFT_PURPLE, TFT_WHITE, 1, "Back", pPage);
+    menu.showPage(0);
+}
+
+/**
+ * @brief Holds the screen at a point for a time, then releases it for a time, calling update every millisecond
+ *
+ */
+static void press(DisplayMenu &menu, TFT_eSPI &tft, uint16_t x, uint16_t y, unsigned long heldMillis)
+{
+    tft.setTouchState(x, y, true);
+    for (unsigned long i = 0; i < heldMillis; i++)
+    {
+        menu.update();
+        delay(1);
+    }
+    tft.setTouchState(x, y, false);
+    for (unsigned long i = 0; i < 200; i++)
+    {
+        menu.update();
+        delay(1);
+    }
+}
+
+static void testSaveAndLoad()
+{
+    DisplayTouchRecorder recorder(10);
+    recorder.record();
+    recorder.add(5, 6, false);
+    recorder.add(7, 8, false);
+    recorder.add(100, 200, true);
+    recorder.add(100, 200, true);
+    recorder.add(101, 200, true);
+    recorder.add(0, 0, false);
+    CHECK_EQUAL(4, recorder.getSampleCount());
+
+    //a released screen is stored without a position
+    HostBuffer saved;
+    recorder.save(saved);
+    CHECK_TEXT("2 0 0 0\n2 1 100 200\n1 1 101 200\n1 0 0 0\n", saved.text());
+
+    DisplayTouchRecorder loaded(10);
+    CHECK(loaded.load(saved));
+    CHECK_EQUAL(recorder.getSampleCount(), loaded.getSampleCount());
+    for (uint16_t i = 0; i < recorder.getSampleCount(); i++)
+    {
+        CHECK_EQUAL(recorder.getSample(i)->reads, loaded.getSample(i)->reads);
+        CHECK_EQUAL(recorder.getSample(i)->pressed, loaded.getSample(i)->pressed);
+        CHECK_EQUAL(recorder.getSample(i)->x, loaded.getSample(i)->x);
+        CHECK_EQUAL(recorder.getSample(i)->y, loaded.getSample(i)->y);
+    }
+
+    //one read for each reading recorded
+    const uint16_t expected[][3] = {{0, 0, 0}, {0, 0, 0}, {100, 200, 1}, {100, 200, 1}, {101, 200, 1}, {0, 0, 0}};
+    uint16_t x, y;
+    bool pressed;
+    loaded.replay();
+    for (int i = 0; i < 6; i++)
+    {
+        CHECK(loaded.next(&x, &y, &pressed));
+        CHECK_EQUAL(expected[i][0], x);
+        CHECK_EQUAL(expected[i][1], y);
+        CHECK_EQUAL(expected[i][2], pressed);
+    }
+    CHECK(!loaded.next(&x, &y, &pressed));
+    CHECK(!pressed);
+    CHECK(!loaded.isReplaying());
+
+    //a recording which does not fit
+    DisplayTouchRecorder small(2);
+    HostBuffer again;
+    recorder.save(again);
+    CHECK(!small.load(again));
+}
+
+static void testReplay()
+{
+    TFT_eSPI tft;
+    DisplayMenu menu(&tft);
+    DisplayTouchRecorder recorder(100);
+    menu.setTouchRecorder(&recorder);
+    buildMenu(menu);
+    pressCount = 0;
+    value = 0;
+
+    recorder.record();
+    press(menu, tft, 50, 30, 300);
+    press(menu, tft, 50, 80, 250);
+    //to the other page and back
+    press(menu, tft, 50, 130, 50);
+    press(menu, tft, 50, 30, 50);
+    recorder.stop();
+    int recordedPresses = pressCount;
+    double recordedValue = value;
+    CHECK_EQUAL(1, recordedPresses);
+    CHECK(recordedValue >= 2);
+    CHECK_EQUAL(0, menu.getPageIndex(menu.getVisablePage()));
+
+    HostBuffer saved;
+    recorder.save(saved);
+
+    //the replay does not depend on time, the second menu is updated as fast as it asks for
+    TFT_eSPI replayTft;
+    DisplayMenu replayMenu(&replayTft);
+    DisplayTouchRecorder replayer(100);
+    CHECK(replayer.load(saved));
+    replayMenu.setTouchRecorder(&replayer);
+    buildMenu(replayMenu);
+    pressCount = 0;
+    value = 0;
+    replayer.replay();
+    while (replayer.isReplaying())
+    {
+        replayMenu.update();
+        delay(replayMenu.getNextUpdateDelay() == DISPLAY_MENU_NO_DEADLINE ? 1 : replayMenu.getNextUpdateDelay());
+    }
+    CHECK_EQUAL(recordedPresses, pressCount);
+    CHECK_EQUAL(recordedValue, value);
+    CHECK_EQUAL(0, replayMenu.getPageIndex(replayMenu.getVisablePage()));
+    CHECK_EQUAL(0, countDifferentPixels(tft, replayTft));
+}
+
+static void testLatency()
+{
+    TFT_eSPI tft;
+    DisplayMenu menu(&tft);
+    DisplayTouchRecorder recorder(100);
+    menu.setTouchRecorder(&recorder);
+    buildMenu(menu);
+
+    //the time the button is held is not part of the time to the command
+    press(menu, tft, 50, 30, 500);
+    const DISPLAY_TOUCH_TIMES &times = menu.getTouchTimes();
+    CHECK(times.stage[TOUCH_HIT_TEST] >= times.stage[TOUCH_SAMPLE]);
+    CHECK(times.stage[TOUCH_FLUSHED] >= times.stage[TOUCH_HIT_TEST]);
+    CHECK(times.stage[TOUCH_CALLBACK] >= times.stage[TOUCH_FLUSHED]);
+    CHECK(times.stage[TOUCH_CALLBACK] - times.stage[TOUCH_SAMPLE] < 1000);
+
+    CHECK_EQUAL(1, recorder.getLatency(TOUCH_CALLBACK).count);
+    CHECK_EQUAL(0, recorder.getLatency(TOUCH_SAMPLE).max);
+    HostBuffer report;
+    recorder.printReport(report);
+    CHECK(report.text().indexOf("callback") >= 0);
+    CHECK(report.text().indexOf("draw start") < 0);
+}
+
+int main()
+{
+    testSaveAndLoad();
+    testReplay();
+    testLatency();
+    return testResult("touch_recorder");
+}
@@ -0,0 +1,499 @@
+#!/usr/bin/env python3
+"""
+Compiles a declarative menu description (JSON) into the binary menu format read by DisplayMenuFile.
+
+The layout is done on the host, so the device only reads finished coordinates.
+Items which are off screen or overlap other items are reported as errors and texts which do not fit
+in their item are reported as warnings, before anything is flashed.
+
+Outputs
+    --binary menu.bin       the menu file, for example to upload to SPIFFS or LittleFS
+    --header menu.h         the menu file as a const array in flash, with ids for actions, values and pages
+    --png previewdir        a PNG preview of every page
+
+Only the python standard library is used.
+"""
+
+import argparse
+import json
+import os
+import re
+import struct
+import sys
+import zlib
+
+FILE_VERSION = 1
+NONE = 0xFFFF
+
+ITEM_LABEL = 0
+ITEM_RUN_FUNCTION = 1
+ITEM_OPEN_PAGE = 2
+ITEM_INCREMENT_VALUE = 3
+
+ALIGN = {"left": 0, "center": 1, "right": 2}
+
+# DISPLAY_NUMBER_MAX_PRECISION, more decimals are not drawn
+MAX_PRECISION = 9
+
+BUTTON_TARGETS = ("action", "page", "increment")
+
+# Named colors from TFT_eSPI.h
+COLORS = {
+    "TFT_BLACK": 0x0000, "TFT_NAVY": 0x000F, "TFT_DARKGREEN": 0x03E0, "TFT_DARKCYAN": 0x03EF,
+    "TFT_MAROON": 0x7800, "TFT_PURPLE": 0x780F, "TFT_OLIVE": 0x7BE0, "TFT_LIGHTGREY": 0xD69A,
+    "TFT_DARKGREY": 0x7BEF, "TFT_BLUE": 0x001F, "TFT_GREEN": 0x07E0, "TFT_CYAN": 0x07FF,
+    "TFT_RED": 0xF800, "TFT_MAGENTA": 0xF81F, "TFT_YELLOW": 0xFFE0, "TFT_WHITE": 0xFFFF,
+    "TFT_ORANGE": 0xFDA0, "TFT_GREENYELLOW": 0xB7E0, "TFT_PINK": 0xFE19, "TFT_BROWN": 0x9A60,
+    "TFT_GOLD": 0xFEA0, "TFT_SILVER": 0xC618, "TFT_SKYBLUE": 0x867D, "TFT_VIOLET": 0x915C,
+}
+
+DEFAULT_STYLE = {"outline": 0xFFFF, "fill": 0x0000, "text": 0xFFFF, "textsize": 1}
+
+
+class MenuError(Exception):
+    pass
+
+
+def color565(value):
+    """Converts "#rrggbb", "TFT_NAME", "0x1234" or a number to a 16 bit color."""
+    if isinstance(value, int):
+        return value & 0xFFFF
+    if value in COLORS:
+        return COLORS[value]
+    if value.startswith("#") and len(value) == 7:
+        r, g, b = int(value[1:3], 16), int(value[3:5], 16), int(value[5:7], 16)
+        return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3)
+    try:
+        return int(value, 0) & 0xFFFF
+    except ValueError:
+        raise MenuError("unknown color '%s'" % value)
+
+
+def rgb888(color):
+    r = (color >> 11) & 0x1F
+    g = (color >> 5) & 0x3F
+    b = color & 0x1F
+    return ((r * 527 + 23) >> 6, (g * 259 + 33) >> 6, (b * 527 + 23) >> 6)
+
+
+def cdiv(a, b):
+    """Integer division like C++, rounding toward zero."""
+    q = abs(a) // abs(b)
+    return q if (a < 0) == (b < 0) else -q
+
+
+def format_value(value, precision, trim_zeros):
+    """The text DisplayNumberFormat::format writes for a linked value."""
+    text = "%.*f" % (min(max(precision, 0), MAX_PRECISION), value)
+    if trim_zeros and "." in text:
+        text = text.rstrip("0").rstrip(".")
+    return text
+
+
+class Font:
+    """Glyph metrics of an Adafruit GFX font, the kind of font DisplayMenu::setFont takes."""
+
+    def __init__(self, path=None):
+        self.glyphs = {}
+        self.bitmap = b""
+        if path:
+            self.load(path)
+        else:
+            # FreeMonoBold9pt7b, the default menu font, every glyph advances 11 pixels
+            for code in range(0x20, 0x7F):
+                self.glyphs[chr(code)] = (0, 0, 0, 11, 0, 0)
+            self.ab, self.bb = 12, 4
+
+    def load(self, path):
+        with open(path) as f:
+            source = f.read()
+        bitmaps = re.search(r"Bitmaps\[\]\s*PROGMEM\s*=\s*\{(.*?)\}", source, re.S)
+        glyphs = re.search(r"Glyphs\[\]\s*PROGMEM\s*=\s*\{(.*?)\};", source, re.S)
+        font = re.search(r"GFXfont\s+\w+\s*PROGMEM\s*=\s*\{(.*?)\};", source, re.S)
+        if not bitmaps or not glyphs or not font:
+            raise MenuError("%s is not a GFX font header" % path)
+        self.bitmap = bytes(int(v, 0) for v in re.findall(r"0x[0-9A-Fa-f]+|\d+", bitmaps.group(1)))
+        fields = [v.strip() for v in font.group(1).split(",")]
+        first = int(fields[2], 0)
+        entries = re.findall(r"\{\s*(-?\d+)\s*,\s*(-?\d+)\s*,\s*(-?\d+)\s*,\s*(-?\d+)\s*,\s*(-?\d+)\s*,\s*(-?\d+)\s*\}",
+                             glyphs.group(1))
+        for i, entry in enumerate(entries):
+            self.glyphs[chr(first + i)] = tuple(int(v) for v in entry)
+        # the same extents TFT_eSPI::setFreeFont uses to place ML_DATUM text
+        self.ab = max(-g[5] for g in self.glyphs.values())
+        self.bb = max(g[2] + g[5] for g in self.glyphs.values())
+
+    def text_width(self, text, textsize):
+        """The width TFT_eSPI::textWidth gives, the last character ends where it's glyph ends and not at it's advance.
+        Without a font file the glyph sizes are not known and the advance is used."""
+        width = 0
+        for i, c in enumerate(text):
+            if c not in self.glyphs:
+                continue
+            offset, gw, gh, advance, xo, yo = self.glyphs[c]
+            width += xo + gw if self.bitmap and i == len(text) - 1 else advance
+        return width * textsize
+
+
+class FrameBuffer:
+    """A software display with the subset of the TFT_eSPI drawing calls the buttons and labels use."""
+
+    def __init__(self, width, height, color):
+        self.width = width
+        self.height = height
+        self.pixels = [bytearray(rgb888(color) * width) for _ in range(height)]
+
+    def pixel(self, x, y, color):
+        if 0 <= x < self.width and 0 <= y < self.height:
+            self.pixels[y][x * 3:x * 3 + 3] = bytes(rgb888(color))
+
+    def fill_rect(self, x, y, w, h, color):
+        for yy in range(max(y, 0), min(y + h, self.height)):
+            for xx in range(max(x, 0), min(x + w, self.width)):
+                self.pixel(xx, yy, color)
+
+    def in_round_rect(self, x, y, w, h, r, px, py):
+        cx = min(max(px, x + r), x + w - 1 - r)
+        cy = min(max(py, y + r), y + h - 1 - r)
+        return (px - cx) ** 2 + (py - cy) ** 2 <= r * r
+
+    def fill_round_rect(self, x, y, w, h, r, color):
+        for yy in range(y, y + h):
+            for xx in range(x, x + w):
+                if self.in_round_rect(x, y, w, h, r, xx, yy):
+                    self.pixel(xx, yy, color)
+
+    def draw_round_rect(self, x, y, w, h, r, color):
+        for yy in range(y, y + h):
+            for xx in range(x, x + w):
+                if self.in_round_rect(x, y, w, h, r, xx, yy) and not (
+                        w > 2 and h > 2 and self.in_round_rect(x + 1, y + 1, w - 2, h - 2, max(r - 1, 0), xx, yy)):
+                    self.pixel(xx, yy, color)
+
+    def draw_string(self, font, text, x, baseline, textsize, color):
+        for c in text:
+            offset, gw, gh, advance, xo, yo = font.glyphs.get(c, (0, 0, 0, 0, 0, 0))
+            if font.bitmap:
+                bit = 0
+                for yy in range(gh):
+                    for xx in range(gw):
+                        if font.bitmap[offset + (bit >> 3)] & (0x80 >> (bit & 7)):
+                            self.fill_rect(x + (xo + xx) * textsize, baseline + (yo + yy) * textsize,
+                                           textsize, textsize, color)
+                        bit += 1
+            elif c != " ":
+                # no glyph shapes without a font file, show where the character goes
+                self.fill_rect(x + textsize, baseline - (font.ab - 2) * textsize,
+                               (advance - 2) * textsize, (font.ab - 2) * textsize, color)
+            x += advance * textsize
+
+    def save_png(self, path):
+        raw = b"".join(b"\x00" + bytes(row) for row in self.pixels)
+
+        def chunk(kind, data):
+            return struct.pack(">I", len(data)) + kind + data + struct.pack(">I", zlib.crc32(kind + data) & 0xFFFFFFFF)
+
+        with open(path, "wb") as f:
+            f.write(b"\x89PNG\r\n\x1a\n")
+            f.write(chunk(b"IHDR", struct.pack(">IIBBBBB", self.width, self.height, 8, 2, 0, 0, 0)))
+            f.write(chunk(b"IDAT", zlib.compress(raw, 9)))
+            f.write(chunk(b"IEND", b""))
+
+
+class Item:
+    def __init__(self, page, values, where):
+        self.page = page
+        self.where = where
+        self.type = values.get("type", "button")
+        self.text = str(values.get("text", ""))
+        self.x = int(values["x"])
+        self.y = int(values["y"])
+        self.width = int(values["width"])
+        self.height = int(values["height"])
+        self.style = {
+            "outline": color565(values.get("outline", DEFAULT_STYLE["outline"])),
+            "fill": color565(values.get("fill", DEFAULT_STYLE["fill"])),
+            "text": color565(values.get("textColor", DEFAULT_STYLE["text"])),
+            "textsize": int(values.get("textsize", DEFAULT_STYLE["textsize"])),
+        }
+        default_radius = 0 if self.type == "label" else min(self.width, self.height) // 6
+        self.radius = int(values.get("radius", default_radius))
+        self.align = ALIGN[values.get("align", "center")]
+        self.x_datum, self.y_datum = (int(v) for v in values.get("datumOffset", [0, 0]))
+        self.hidden = bool(values.get("hidden", False))
+        self.overlap = bool(values.get("overlap", False))
+        self.action = values.get("action")
+        self.open_page = values.get("page")
+        self.value = values.get("value")
+        self.increment = float(values.get("increment", 0))
+        self.precision = int(values.get("precision", -1))
+        self.trim_zeros = bool(values.get("trimZeros", True))
+
+        if self.type not in ("label", "button"):
+            raise MenuError("%s: unknown item type '%s'" % (where, self.type))
+        if self.type == "button" and sum(v is not None for v in (self.action, self.open_page, values.get("increment"))) != 1:
+            raise MenuError("%s: a button needs exactly one of action, page or increment" % where)
+        if values.get("increment") is not None and self.value is None:
+            raise MenuError("%s: an increment button needs a value" % where)
+        if len(self.text.encode()) > 255:
+            raise MenuError("%s: the text is longer than 255 bytes" % where)
+
+    @property
+    def kind(self):
+        if self.type == "label":
+            return ITEM_LABEL
+        if self.action is not None:
+            return ITEM_RUN_FUNCTION
+        if self.open_page is not None:
+            return ITEM_OPEN_PAGE
+        return ITEM_INCREMENT_VALUE
+
+    def overlaps(self, other):
+        return (self.x < other.x + other.width and other.x < self.x + self.width and
+                self.y < other.y + other.height and other.y < self.y + self.height)
+
+
+def merged(*sources):
+    values = {}
+    for source in sources:
+        values.update({k: v for k, v in source.items() if k not in ("items", "type")} if source.get("type") == "grid" else source)
+    return values
+
+
+class Menu:
+    def __init__(self, description):
+        display = description.get("display", {})
+        self.width = int(display.get("width", 320))
+        self.height = int(display.get("height", 240))
+        self.styles = description.get("styles", {})
+        self.actions = dict(description.get("actions", {}))
+        self.values = dict(description.get("values", {}))
+        self.pages = []
+        self.page_index = {}
+        for index, page in enumerate(description.get("pages", [])):
+            name = page.get("name", str(index))
+            if name in self.page_index:
+                raise MenuError("page '%s' is defined twice" % name)
+            self.page_index[name] = index
+            self.pages.append({"name": name, "fill": color565(page.get("fill", 0)), "items": []})
+            defaults = page.get("defaults", {})
+            for number, values in enumerate(page.get("items", [])):
+                self.layout(self.pages[-1], defaults, values, "page '%s' item %d" % (name, number))
+
+    def style(self, values):
+        """Expands a named style into the item values, values set on the item win."""
+        name = values.get("style")
+        if name is None:
+            return values
+        if name not in self.styles:
+            raise MenuError("unknown style '%s'" % name)
+        return merged(self.styles[name], {k: v for k, v in values.items() if k != "style"})
+
+    def layout(self, page, defaults, values, where):
+        if values.get("type") != "grid":
+            inherited = self.style(defaults)
+            # what a button does is not mixed, an item setting one of them replaces the default
+            if any(key in values for key in BUTTON_TARGETS):
+                inherited = {k: v for k, v in inherited.items() if k not in BUTTON_TARGETS}
+            page["items"].append(Item(page, merged(inherited, self.style(values)), where))
+            return
+
+        # a grid places its items in rows, left to right, with the same cell size and spacing
+        columns = int(values["columns"])
+        cell_width, cell_height = (int(v) for v in values["cell"])
+        gap_x, gap_y = (int(v) for v in values.get("gap", [0, 0]))
+        for number, cell in enumerate(values.get("items", [])):
+            if cell is None:
+                continue
+            if not isinstance(cell, dict):
+                cell = {"text": cell}
+            column, row = number % columns, number // columns
+            span = int(cell.get("span", 1))
+            placed = {
+                "x": int(values["x"]) + column * (cell_width + gap_x),
+                "y": int(values["y"]) + row * (cell_height + gap_y),
+                "width": cell_width * span + gap_x * (span - 1),
+                "height": cell_height,
+            }
+            self.layout(page, merged(defaults, values), merged(placed, cell), "%s cell %d" % (where, number))
+
+    def check(self, font):
+        errors, warnings = [], []
+        for page in self.pages:
+            visible = [item for item in page["items"] if not item.hidden]
+            for item in page["items"]:
+                if item.x < 0 or item.y < 0 or item.x + item.width > self.width or item.y + item.height > self.height:
+                    errors.append("%s '%s' is outside the %dx%d display" % (item.where, item.text, self.width, self.height))
+                if item.open_page is not None and item.open_page not in self.page_index:
+                    errors.append("%s opens the unknown page '%s'" % (item.where, item.open_page))
+                if item.precision < 0:
+                    room = item.width - 2 * max(1, item.radius)
+                    if font.text_width(item.text, item.style["textsize"]) > room:
+                        warnings.append("%s text '%s' is wider than the item" % (item.where, item.text))
+                    if (font.ab + font.bb) * item.style["textsize"] > item.height - 2:
+                        warnings.append("%s text '%s' is higher than the item" % (item.where, item.text))
+            for i, item in enumerate(visible):
+                for other in visible[i + 1:]:
+                    if item.overlaps(other) and not (item.overlap or other.overlap):
+                        errors.append("%s '%s' overlaps %s '%s'" % (item.where, item.text, other.where, other.text))
+        return errors, warnings
+
+    def bind_ids(self):
+        """Gives every action and value used an id, ids set in the description are kept."""
+        for table, key in ((self.actions, "action"), (self.values, "value")):
+            for page in self.pages:
+                for item in page["items"]:
+                    name = getattr(item, key)
+                    if name is not None and name not in table:
+                        used = set(table.values())
+                        table[name] = next(i for i in range(NONE) if i not in used)
+
+    def pack(self):
+        self.bind_ids()
+        styles = []
+        for page in self.pages:
+            for item in page["items"]:
+                key = (item.style["outline"], item.style["fill"], item.style["text"], item.style["textsize"])
+                if key not in styles:
+                    styles.append(key)
+
+        records = []
+        for page in self.pages:
+            record = b""
+            for item in page["items"]:
+                key = (item.style["outline"], item.style["fill"], item.style["text"], item.style["textsize"])
+                if item.kind == ITEM_RUN_FUNCTION:
+                    target = self.actions[item.action]
+                elif item.kind == ITEM_OPEN_PAGE:
+                    target = self.page_index[item.open_page]
+                else:
+                    target = NONE
+                text = item.text.encode()
+                flags = (1 if item.hidden else 0) | (0 if item.trim_zeros else 2)
+                record += struct.pack("<BBhhHHHBBhhHHbdB", item.kind, flags,
+                                      item.x, item.y, item.width, item.height, styles.index(key),
+                                      item.radius, item.align, item.x_datum, item.y_datum, target,
+                                      self.values[item.value] if item.value is not None else NONE,
+                                      item.precision, item.increment, len(text)) + text
+            records.append(record)
+
+        data = b"DMNU" + struct.pack("<BBHH", FILE_VERSION, 0, len(self.pages), len(styles))
+        for style in styles:
+            data += struct.pack("<HHHB", *style)
+        offset = len(data) + 8 * len(self.pages)
+        for page, record in zip(self.pages, records):
+            data += struct.pack("<IHH", offset, page["fill"], len(page["items"]))
+            offset += len(record)
+        return data + b"".join(records)
+
+    def drawn_items(self, page):
+        """The visible items of a page in the order DisplayPage::draw draws them, labels first and then the buttons."""
+        for kind in (ITEM_LABEL, None):
+            for item in page["items"]:
+                if not item.hidden and (item.kind == ITEM_LABEL) == (kind == ITEM_LABEL):
+                    yield item
+
+    def text_placement(self, font, item):
+        """Where DisplayButton::draw and DisplayLabel::draw put the text, as (text, x, baseline).
+        A linked value is shown as 0, the value it has on the device is not known here."""
+        text = item.text if item.precision < 0 or item.value is None else format_value(0, item.precision, item.trim_zeros)
+        textsize = item.style["textsize"]
+        width = font.text_width(text, textsize)
+        x = item.x
+        if item.align == ALIGN["center"]:
+            x = item.x + cdiv(item.width - width, 2) + item.x_datum
+        elif item.align == ALIGN["right"]:
+            x = item.x + (item.width - width) - item.x_datum
+        # ML_DATUM, TFT_eSPI moves free font text down by the ascent and up by half of it
+        y = item.y + cdiv(item.height, 2) + item.y_datum
+        baseline = y + font.ab * textsize - cdiv(font.ab * textsize, 2)
+        return text, x, baseline
+
+    def preview(self, font, page, path, scale):
+        fb = FrameBuffer(self.width, self.height, page["fill"])
+        for item in self.drawn_items(page):
+            fb.fill_round_rect(item.x, item.y, item.width, item.height, item.radius, item.style["fill"])
+            fb.draw_round_rect(item.x, item.y, item.width, item.height, item.radius, item.style["outline"])
+            text, x, baseline = self.text_placement(font, item)
+            fb.draw_string(font, text, x, baseline, item.style["textsize"], item.style["text"])
+        if scale > 1:
+            fb.pixels = [bytearray(b"".join(bytes(row[x * 3:x * 3 + 3]) * scale for x in range(fb.width)))
+                         for row in fb.pixels for _ in range(scale)]
+            fb.width *= scale
+            fb.height *= scale
+        fb.save_png(path)
+
+
+def identifier(name):
+    return re.sub(r"[^A-Za-z0-9]", "_", name).upper()
+
+
+def write_header(menu, data, path, symbol):
+    guard = identifier(os.path.basename(path))
+    prefix = identifier(symbol)
+    lines = [
+        "// Generated by tools/menucompiler/menucompiler.py, do not edit.",
+        "#ifndef %s" % guard,
+        "#define %s" % guard,
+        "",
+        "#include <Arduino.h>",
+        "",
+    ]
+    for title, table in (("ACTION", menu.actions), ("VALUE", menu.values), ("PAGE", menu.page_index)):
+        for name, value in table.items():
+            lines.append("#define %s_%s_%s %d" % (prefix, title, identifier(name), value))
+        lines.append("")
+    lines.append("const size_t %sSize = %d;" % (symbol, len(data)))
+    lines.append("const uint8_t %s[] PROGMEM = {" % symbol)
+    for start in range(0, len(data), 16):
+        lines.append("    " + ", ".join("0x%02X" % b for b in data[start:start + 16]) + ",")
+    lines += ["};", "", "#endif", ""]
+    with open(path, "w") as f:
+        f.write("\n".join(lines))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("description", help="the menu description, a JSON file")
+    parser.add_argument("--binary", help="write the menu file")
+    parser.add_argument("--header", help="write the menu file as a C++ array in flash")
+    parser.add_argument("--name", default="menuData", help="name of the array in the header")
+    parser.add_argument("--png", help="write a preview of every page to this folder")
+    parser.add_argument("--scale", type=int, default=1, help="preview pixel size")
+    parser.add_argument("--font", help="GFX font header used for text sizes and previews, default FreeMonoBold9pt7b metrics")
+    parser.add_argument("--werror", action="store_true", help="treat warnings as errors")
+    args = parser.parse_args()
+
+    try:
+        with open(args.description) as f:
+            menu = Menu(json.load(f))
+        font = Font(args.font)
+        errors, warnings = menu.check(font)
+    except (MenuError, KeyError, ValueError) as e:
+        print("error: %s" % e, file=sys.stderr)
+        return 1
+
+    for warning in warnings:
+        print("warning: %s" % warning, file=sys.stderr)
+    for error in errors:
+        print("error: %s" % error, file=sys.stderr)
+    if errors or (args.werror and warnings):
+        return 1
+
+    data = menu.pack()
+    if args.binary:
+        with open(args.binary, "wb") as f:
+            f.write(data)
+    if args.header:
+        write_header(menu, data, args.header, args.name)
+    if args.png:
+        os.makedirs(args.png, exist_ok=True)
+        for index, page in enumerate(menu.pages):
+            menu.preview(font, page, os.path.join(args.png, "%02d_%s.png" % (index, page["name"])), args.scale)
+
+    print("%d pages, %d bytes" % (len(menu.pages), len(data)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())